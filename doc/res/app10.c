@@ -0,0 +1,165 @@
+/*----------------------------------------------------------------------/
+/ Mapped read checker
+/-----------------------------------------------------------------------/
+/ This program checks f_map_read() on a file being extended. A file is
+/ written in pieces interleaved with another file, so that it becomes
+/ fragmented, and the data behind the write position is mapped before
+/ the file is closed. On the exFAT volume, the last fragment of such a
+/ file is not recorded on the FAT until the file is closed or seeked, so
+/ the mapping must not break the cluster chain. After the files are
+/ closed, the volume is remounted and the file data and the number of
+/ free clusters after removing the files are checked.
+/
+/ Build:  cc -O2 -I../../src app10.c ../../src/ff.c ../../src/ffunicode.c ../../src/diskio_posix.c
+/ Config: FF_FS_READONLY = 0, FF_USE_MKFS = 1, FF_USE_MAPREAD = 1
+/ Usage:  app10
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "ff.h"
+#include "diskio.h"
+#include "diskio_posix.h"
+
+#if FF_FS_READONLY || !FF_USE_MKFS || !FF_USE_MAPREAD
+#error This program needs FF_FS_READONLY = 0, FF_USE_MKFS = 1 and FF_USE_MAPREAD = 1
+#endif
+
+
+#define PDRV    0       /* Physical drive of the volume "" */
+#define N_LOOP  200     /* Number of pieces written to the file */
+
+static FATFS FatFs;
+static BYTE Buff[8192];     /* Data buffer and working buffer for f_mkfs */
+
+
+static
+BYTE pat (      /* Test data at the offset */
+    int id,         /* File ID */
+    DWORD ofs       /* File offset */
+)
+{
+    return (BYTE)(ofs * 7 + id * 13 + (ofs >> 9));
+}
+
+
+static
+int put_data (  /* 0:succeeded, 1:failed */
+    FIL* fp,
+    int id,
+    UINT len
+)
+{
+    DWORD ofs = (DWORD)f_tell(fp);
+    UINT i, bw;
+
+
+    for (i = 0; i < len; i++) Buff[i] = pat(id, ofs + i);
+    return (f_write(fp, Buff, len, &bw) != FR_OK || bw != len) ? 1 : 0;
+}
+
+
+static
+int check_file (    /* 0:succeeded, 1:failed */
+    const char* path,
+    int id,
+    DWORD size
+)
+{
+    FIL fil;
+    DWORD ofs;
+    UINT i, br;
+
+
+    if (f_open(&fil, path, FA_READ) != FR_OK) return 1;
+    if (f_size(&fil) != size) return 1;
+    for (ofs = 0; ofs < size; ofs += br) {
+        if (f_read(&fil, Buff, sizeof Buff, &br) != FR_OK || br == 0) return 1;
+        for (i = 0; i < br; i++) {
+            if (Buff[i] != pat(id, ofs + i)) return 1;
+        }
+    }
+    return f_close(&fil) != FR_OK;
+}
+
+
+static
+const char* test (  /* 0:succeeded, else:error message */
+    BYTE fmt,
+    DWORD au
+)
+{
+    FIL fa, fb;
+    DWORD ofs, nfree0, nfree;
+    FATFS *fs;
+    const void *ptr;
+    UINT len, i, n;
+    DWORD rnd = 1;
+
+
+    if (f_mkfs("", fmt | FM_SFD, au, Buff, sizeof Buff) != FR_OK) return "f_mkfs failed";
+    if (f_mount(&FatFs, "", 1) != FR_OK) return "f_mount failed";
+    if (f_getfree("", &nfree0, &fs) != FR_OK) return "f_getfree failed";
+
+    if (f_open(&fa, "a.bin", FA_READ | FA_WRITE | FA_CREATE_ALWAYS) != FR_OK) return "f_open failed";
+    if (f_open(&fb, "b.bin", FA_WRITE | FA_CREATE_ALWAYS) != FR_OK) return "f_open failed";
+    for (i = 0; i < N_LOOP; i++) {
+        rnd = rnd * 1103515245 + 12345;
+        if (put_data(&fa, 0, (UINT)(rnd >> 8) % sizeof Buff + 1)) return "f_write failed";
+        if (i % 3 == 0) {   /* Allocate a cluster between the fragments */
+            if (put_data(&fb, 1, 512) || f_sync(&fb) != FR_OK) return "f_write failed";
+        }
+        ofs = (DWORD)f_tell(&fa);
+        rnd = rnd * 1103515245 + 12345;
+        ofs = (rnd >> 8) % ofs;             /* Map the data behind the write position */
+        if (f_map_read(&fa, ofs, &ptr, &len) != FR_OK || len == 0) return "f_map_read failed";
+        for (n = 0; n < len; n++) {
+            if (((const BYTE*)ptr)[n] != pat(0, ofs + n)) return "wrong mapped data";
+        }
+        if (f_map_release(&fa) != FR_OK) return "f_map_release failed";
+        if (f_lseek(&fa, f_size(&fa)) != FR_OK) return "f_lseek failed";
+    }
+    ofs = (DWORD)f_size(&fa);
+    n = (UINT)f_size(&fb);
+    if (f_close(&fa) != FR_OK || f_close(&fb) != FR_OK) return "f_close failed";
+
+    f_mount(0, "", 0);
+    if (f_mount(&FatFs, "", 1) != FR_OK) return "f_mount failed";
+    if (check_file("a.bin", 0, ofs) || check_file("b.bin", 1, n)) return "wrong file data";
+    if (f_unlink("a.bin") != FR_OK || f_unlink("b.bin") != FR_OK) return "f_unlink failed";
+    if (f_getfree("", &nfree, &fs) != FR_OK) return "f_getfree failed";
+    if (nfree != nfree0) return "lost clusters";
+    f_mount(0, "", 0);
+    return 0;
+}
+
+
+int main (void)
+{
+    static const struct {
+        const char *name;
+        BYTE fmt;
+        DWORD au;
+    } vol[] = {
+        {"FAT",   FM_FAT,   0},
+        {"FAT32", FM_FAT32, 512},
+#if FF_FS_EXFAT
+        {"exFAT", FM_EXFAT, 512},
+#endif
+    };
+    const char *err;
+    UINT i, n_err = 0;
+
+
+    if (pdisk_attach(PDRV, PDISK_RAM, 0, 140000, 512) != 0) {
+        perror("pdisk_attach");
+        return 2;
+    }
+    for (i = 0; i < sizeof vol / sizeof vol[0]; i++) {
+        err = test(vol[i].fmt, vol[i].au);
+        printf("%s: %s\n", vol[i].name, err ? err : "ok");
+        if (err) n_err++;
+    }
+    pdisk_detach(PDRV);
+    return n_err ? 1 : 0;
+}
@@ -0,0 +1,97 @@
+/*------------------------------------------------------------/
+/ Defragment all files in the volume
+/-------------------------------------------------------------/
+/ The defrag_node() function is for R0.13c+ with FF_USE_DEFRAG.
+/ It relocates each fragmented file in the directory tree into
+/ a contiguous block with f_defrag() function. Files that
+/ cannot be relocated due to lack of contiguous free space are
+/ left as they are and counted.
+*/
+
+
+FRESULT defrag_node (
+    TCHAR* path,    /* Path name buffer with the directory to defragment */
+    UINT sz_buff,   /* Size of path name buffer (items) */
+    FILINFO* fno,   /* Name read buffer */
+    void* work,     /* Working buffer for f_defrag() */
+    UINT sz_work,   /* Size of working buffer [byte] */
+    UINT* nskip     /* Number of files not defragmented */
+)
+{
+    UINT i, j;
+    FRESULT fr;
+    DIR dir;
+    FIL fil;
+
+
+    fr = f_opendir(&dir, path); /* Open the directory */
+    if (fr != FR_OK) return fr;
+
+    for (i = 0; path[i]; i++) ; /* Get current path length */
+    path[i++] = _T('/');
+
+    for (;;) {
+        fr = f_readdir(&dir, fno);  /* Get a directory item */
+        if (fr != FR_OK || !fno->fname[0]) break;   /* End of directory? */
+        j = 0;
+        do {    /* Make a path name */
+            if (i + j >= sz_buff) { /* Buffer over flow? */
+                fr = 100; break;    /* Fails with 100 when buffer overflow */
+            }
+            path[i + j] = fno->fname[j];
+        } while (fno->fname[j++]);
+        if (fr != FR_OK) break;
+        if (fno->fattrib & AM_DIR) {    /* Item is a sub-directory */
+            fr = defrag_node(path, sz_buff, fno, work, sz_work, nskip);
+        } else {                        /* Item is a file */
+            fr = f_open(&fil, path, FA_READ | FA_WRITE);
+            if (fr == FR_OK) {
+                fr = f_defrag(&fil, work, sz_work);
+                if (fr == FR_DENIED) {  /* No contiguous free space for the file */
+                    (*nskip)++; fr = FR_OK;
+                }
+                f_close(&fil);
+            } else {
+                if (fr == FR_DENIED) {  /* Read-only file */
+                    (*nskip)++; fr = FR_OK;
+                }
+            }
+        }
+        if (fr != FR_OK) break;
+    }
+
+    path[--i] = 0;  /* Restore the path name */
+    f_closedir(&dir);
+    return fr;
+}
+
+
+
+
+int main (void) /* How to use */
+{
+    FRESULT fr;
+    FATFS fs;
+    TCHAR buff[256];
+    FILINFO fno;
+    static BYTE work[FF_MAX_SS * 64];
+    UINT nskip = 0;
+
+
+    f_mount(&fs, _T("5:"), 0);
+
+    /* Directory to be defragmented (root directory of the volume) */
+    _tcscpy(buff, _T("5:"));
+
+    /* Defragment the files */
+    fr = defrag_node(buff, sizeof buff / sizeof buff[0], &fno, work, sizeof work, &nskip);
+
+    /* Check the result */
+    if (fr) {
+        _tprintf(_T("Failed to defragment the volume. (%u)\n"), fr);
+        return fr;
+    } else {
+        _tprintf(_T("The volume has been defragmented. (%u files skipped)\n"), nskip);
+        return 0;
+    }
+}
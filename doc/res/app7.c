@@ -0,0 +1,412 @@
+/*----------------------------------------------------------------------/
+/ Benchmark of file operations
+/-----------------------------------------------------------------------/
+/ The run_bench() function runs a fixed set of workloads on a freshly
+/ created volume and prints the result of each workload in a line of
+/ JSON, so that the results can be compared between versions.
+/
+/   {"bench":"seq_read","arg":4096,"ops":4096,"sec":0.004512,
+/    "ops_s":907801.4,"mb_s":3546.10,"rd_cmd":0.250,"wr_cmd":0.000,
+/    "sync_cmd":0.000,"sect_op":8.000,"dev_ms":0.000}
+/
+/ arg:      Workload parameter (chunk size, record size or number of items)
+/ ops:      Number of operations (API calls) measured
+/ rd_cmd, wr_cmd, sync_cmd: Disk commands issued per operation
+/ sect_op:  Sectors transferred per operation
+/ dev_ms:   Device time estimated by the latency model (0 without model)
+/
+/ It runs on the POSIX disk I/O module (src/diskio_posix.c) that counts
+/ the disk commands. All workloads are deterministic.
+/
+/ Build:  cc -O2 -I../../src app7.c ../../src/ff.c ../../src/ffunicode.c ../../src/diskio_posix.c
+/ Config: FF_FS_READONLY = 0, FF_FS_MINIMIZE = 0, FF_USE_MKFS = 1, FF_USE_LFN >= 1
+/ Usage:  app7 [-t fat|fat32|exfat] [-m sdc|emmc] [-i <image file> [-d]]
+/              [-s <volume size [MiB]>] [-n <number of directory items>]
+/ WARNING: The data on the target drive will be lost!
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ff.h"
+#include "diskio.h"
+#include "diskio_posix.h"
+
+
+#define PDRV    0       /* Physical drive of the volume "" */
+#define SZ_FILE (16UL * 1024 * 1024)    /* Size of test file [byte] */
+
+static FATFS FatFs;
+static FIL Fil;
+static BYTE Buff[1024 * 1024];  /* Data buffer and working buffer for f_mkfs */
+static BYTE Fmt = FM_FAT32;     /* Format of the test volume */
+
+static double T0;               /* Start time of the workload */
+static PDISK_STAT S0;           /* Disk counters at start of the workload */
+
+
+static
+DWORD pn (      /* Pseudo random number generator */
+    DWORD pns   /* 0:Initialize, !0:Read */
+)
+{
+    static DWORD lfsr;
+    UINT n;
+
+
+    if (pns) {
+        lfsr = pns;
+        for (n = 0; n < 32; n++) pn(0);
+    }
+    if (lfsr & 1) {
+        lfsr >>= 1;
+        lfsr ^= 0x80200003;
+    } else {
+        lfsr >>= 1;
+    }
+    return lfsr;
+}
+
+
+static
+double now (void)   /* Monotonic time [sec] */
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+static
+void check (        /* Abort the benchmark on error */
+    FRESULT fr,
+    const char* what
+)
+{
+    if (fr != FR_OK) {
+        fprintf(stderr, "%s failed (%u)\n", what, fr);
+        exit(1);
+    }
+}
+
+
+static
+void begin (void)   /* Start to measure a workload */
+{
+    pdisk_stat(PDRV, &S0, 0);
+    T0 = now();
+}
+
+
+static
+void report (       /* Finish to measure a workload and print the result */
+    const char* name,   /* Workload name */
+    DWORD arg,          /* Workload parameter */
+    DWORD ops,          /* Number of operations */
+    double bytes        /* Number of bytes transferred (0:not a data transfer) */
+)
+{
+    double sec = now() - T0;
+    PDISK_STAT s;
+
+
+    pdisk_stat(PDRV, &s, 0);
+    if (sec <= 0) sec = 1e-9;
+    printf("{\"bench\":\"%s\",\"arg\":%lu,\"ops\":%lu,\"sec\":%.6f,\"ops_s\":%.1f,\"mb_s\":%.2f,"
+           "\"rd_cmd\":%.3f,\"wr_cmd\":%.3f,\"sync_cmd\":%.3f,\"sect_op\":%.3f,\"dev_ms\":%.3f}\n",
+        name, (unsigned long)arg, (unsigned long)ops, sec, ops / sec, bytes / sec / 1048576,
+        (double)(s.n_read - S0.n_read) / ops,
+        (double)(s.n_write - S0.n_write) / ops,
+        (double)(s.n_sync - S0.n_sync) / ops,
+        (double)(s.n_rdsect - S0.n_rdsect + s.n_wrsect - S0.n_wrsect) / ops,
+        (s.time_ns - S0.time_ns) / 1e6);
+    fflush(stdout);
+}
+
+
+static
+void fresh_volume (void)    /* Create a new volume and mount it */
+{
+    f_mount(0, "", 0);
+    check(f_mkfs("", Fmt, 0, Buff, sizeof Buff), "f_mkfs");
+    check(f_mount(&FatFs, "", 1), "f_mount");
+}
+
+
+
+
+/*----------------------------------------------------------------------*/
+/* Workloads                                                            */
+/*----------------------------------------------------------------------*/
+
+static
+void bench_mkfs (void)
+{
+    int i;
+
+    f_mount(0, "", 0);
+    begin();
+    for (i = 0; i < 4; i++) check(f_mkfs("", Fmt, 0, Buff, sizeof Buff), "f_mkfs");
+    report("mkfs", 0, 4, 0);
+}
+
+
+static
+void bench_seq (        /* Sequential write and read */
+    UINT chunk          /* Size of a read/write call [byte] */
+)
+{
+    DWORD ofs, n = SZ_FILE / chunk;
+    UINT bw;
+
+
+    memset(Buff, 0x5A, chunk);
+    check(f_open(&Fil, "seq.dat", FA_CREATE_ALWAYS | FA_WRITE), "f_open");
+    begin();
+    for (ofs = 0; ofs < SZ_FILE; ofs += chunk) {
+        check(f_write(&Fil, Buff, chunk, &bw), "f_write");
+        if (bw != chunk) check(FR_DENIED, "f_write (disk full)");
+    }
+    check(f_close(&Fil), "f_close");
+    report("seq_write", chunk, n, SZ_FILE);
+
+    check(f_open(&Fil, "seq.dat", FA_READ), "f_open");
+    begin();
+    for (ofs = 0; ofs < SZ_FILE; ofs += chunk) {
+        check(f_read(&Fil, Buff, chunk, &bw), "f_read");
+    }
+    report("seq_read", chunk, n, SZ_FILE);
+    check(f_close(&Fil), "f_close");
+}
+
+
+static
+void bench_rand_read (  /* Random 4 KiB read in the file created by bench_seq() */
+    UINT nops           /* Number of reads */
+)
+{
+    UINT i, br;
+
+
+    check(f_open(&Fil, "seq.dat", FA_READ), "f_open");
+    pn(1);
+    begin();
+    for (i = 0; i < nops; i++) {
+        check(f_lseek(&Fil, (FSIZE_t)(pn(0) % (SZ_FILE / 4096)) * 4096), "f_lseek");
+        check(f_read(&Fil, Buff, 4096, &br), "f_read");
+    }
+    report("rand_read_4k", 4096, nops, (double)nops * 4096);
+    check(f_close(&Fil), "f_close");
+}
+
+
+static
+void bench_append_sync (    /* Append small records with f_sync() each */
+    UINT rec,           /* Size of a record [byte] */
+    UINT nops           /* Number of records */
+)
+{
+    UINT i, bw;
+
+
+    memset(Buff, 0xA5, rec);
+    check(f_open(&Fil, "log.dat", FA_CREATE_ALWAYS | FA_WRITE), "f_open");
+    begin();
+    for (i = 0; i < nops; i++) {
+        check(f_write(&Fil, Buff, rec, &bw), "f_write");
+        check(f_sync(&Fil), "f_sync");
+    }
+    report("append_sync", rec, nops, (double)nops * rec);
+    check(f_close(&Fil), "f_close");
+}
+
+
+static
+void bench_create_delete (  /* Create and delete many files in a directory */
+    UINT nf             /* Number of files */
+)
+{
+    UINT i;
+    char path[32];
+
+
+    check(f_mkdir("storm"), "f_mkdir");
+    begin();
+    for (i = 0; i < nf; i++) {
+        sprintf(path, "storm/file%05u.dat", i);
+        check(f_open(&Fil, path, FA_CREATE_NEW | FA_WRITE), "f_open");
+        check(f_close(&Fil), "f_close");
+    }
+    report("create", nf, nf, 0);
+    begin();
+    for (i = 0; i < nf; i++) {
+        sprintf(path, "storm/file%05u.dat", i);
+        check(f_unlink(path), "f_unlink");
+    }
+    report("delete", nf, nf, 0);
+    check(f_unlink("storm"), "f_unlink");
+}
+
+
+static
+void bench_deep_open (  /* Open a file at the bottom of deep path */
+    UINT depth,         /* Depth of the directory tree */
+    UINT nops           /* Number of f_open() */
+)
+{
+    UINT i, n;
+    char path[256];
+
+
+    for (i = n = 0; i < depth; i++) {
+        n += sprintf(path + n, "%sdirectory%02u", i ? "/" : "", i);
+        check(f_mkdir(path), "f_mkdir");
+    }
+    sprintf(path + n, "/file.txt");
+    check(f_open(&Fil, path, FA_CREATE_NEW | FA_WRITE), "f_open");
+    check(f_close(&Fil), "f_close");
+    begin();
+    for (i = 0; i < nops; i++) {
+        check(f_open(&Fil, path, FA_READ), "f_open");
+        check(f_close(&Fil), "f_close");
+    }
+    report("deep_open", depth, nops, 0);
+}
+
+
+static
+void bench_readdir (    /* Read a large directory */
+    UINT nf             /* Number of items in the directory */
+)
+{
+    UINT i, n;
+    char path[32];
+    DIR dir;
+    FILINFO fno;
+
+
+    check(f_mkdir("BIGDIR"), "f_mkdir");
+    for (i = 0; i < nf; i++) {  /* Upper-case 8.3 names take one entry each */
+        sprintf(path, "BIGDIR/F%07u.TXT", i);
+        check(f_open(&Fil, path, FA_CREATE_NEW | FA_WRITE), "f_open");
+        check(f_close(&Fil), "f_close");
+    }
+    begin();
+    check(f_opendir(&dir, "BIGDIR"), "f_opendir");
+    for (n = 0; ; n++) {
+        check(f_readdir(&dir, &fno), "f_readdir");
+        if (!fno.fname[0]) break;
+    }
+    check(f_closedir(&dir), "f_closedir");
+    report("readdir", nf, n, 0);
+}
+
+
+static
+void bench_getfree (void)   /* Get free space of the filled volume just mounted (FAT scan) */
+{
+    FATFS *fs;
+    DWORD nclst;
+    UINT bw;
+    int i;
+
+
+    memset(Buff, 0x3C, sizeof Buff);
+    check(f_open(&Fil, "fill.dat", FA_CREATE_ALWAYS | FA_WRITE), "f_open");
+    do {    /* Fill up the volume */
+        check(f_write(&Fil, Buff, sizeof Buff, &bw), "f_write");
+    } while (bw == sizeof Buff);
+    check(f_close(&Fil), "f_close");
+    check(f_getfree("", &nclst, &fs), "f_getfree");
+    if (fs->fs_type == FS_FAT32) {  /* Invalidate the free cluster count in the FSINFO, or f_getfree only reads it */
+        if (disk_read(PDRV, Buff, fs->volbase + 1, 1) != RES_OK) check(FR_DISK_ERR, "disk_read");
+        memset(Buff + 488, 0xFF, 4);    /* FSI_Free_Count = 0xFFFFFFFF (unknown) */
+        if (disk_write(PDRV, Buff, fs->volbase + 1, 1) != RES_OK) check(FR_DISK_ERR, "disk_write");
+    }
+    begin();
+    for (i = 0; i < 4; i++) {
+        check(f_mount(&FatFs, "", 1), "f_mount");
+        check(f_getfree("", &nclst, &fs), "f_getfree");
+    }
+    report("getfree_full", nclst, 4, 0);
+}
+
+
+
+
+/*----------------------------------------------------------------------*/
+/* Run all workloads                                                    */
+/*----------------------------------------------------------------------*/
+
+void run_bench (
+    UINT ndir   /* Number of items in the directory for readdir workload */
+)
+{
+    static const UINT chunks[] = {512, 4096, 32768, 262144};
+    UINT i;
+
+
+    bench_mkfs();
+
+    fresh_volume();
+    for (i = 0; i < sizeof chunks / sizeof chunks[0]; i++) bench_seq(chunks[i]);
+    bench_rand_read(4096);
+    bench_append_sync(64, 2000);
+
+    fresh_volume();
+    bench_create_delete(1000);
+    bench_deep_open(16, 10000);
+
+    fresh_volume();
+    bench_readdir(ndir);
+
+    fresh_volume();
+    bench_getfree();
+
+    f_mount(0, "", 0);
+}
+
+
+
+int main (int argc, char* argv[])
+{
+    const char *img = 0;
+    const PDISK_MODEL *model = 0;
+    UINT type = PDISK_RAM, ndir = 50000;
+    DWORD mib = 256;
+    int i;
+
+
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+            i++;
+            Fmt = !strcmp(argv[i], "fat") ? FM_FAT : !strcmp(argv[i], "exfat") ? FM_EXFAT : FM_FAT32;
+        } else if (!strcmp(argv[i], "-m") && i + 1 < argc) {
+            i++;
+            model = !strcmp(argv[i], "emmc") ? &PdiskEMMC : &PdiskSDC;
+        } else if (!strcmp(argv[i], "-i") && i + 1 < argc) {
+            img = argv[++i];
+            type = PDISK_FILE;
+        } else if (!strcmp(argv[i], "-d")) {
+            type |= PDISK_DIRECT;
+        } else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+            mib = strtoul(argv[++i], 0, 10);
+        } else if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            ndir = strtoul(argv[++i], 0, 10);
+        } else {
+            fprintf(stderr, "usage: %s [-t fat|fat32|exfat] [-m sdc|emmc] [-i <image file> [-d]] [-s <MiB>] [-n <items>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (pdisk_attach(PDRV, type, img, mib * 2048, 512) != 0) {
+        perror("pdisk_attach");
+        return 1;
+    }
+    if (model) pdisk_model(PDRV, model);
+    run_bench(ndir);
+    pdisk_detach(PDRV);
+    return 0;
+}
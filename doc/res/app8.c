@@ -0,0 +1,523 @@
+/*----------------------------------------------------------------------/
+/ Workload replayer and disk access trace comparator
+/-----------------------------------------------------------------------/
+/ This program replays a sequence of API calls written in a script on a
+/ simulated drive and records the disk commands issued by the FatFs into
+/ a trace file. Two trace files, e.g. taken with the old and new build of
+/ ff.c or taken in the field and replayed on the host, can be compared to
+/ check the effect of a change on the real workload.
+/
+/ The trace file consists of 16-byte records in the same format as the
+/ trace buffer of FatFs (FF_USE_TRACE, see doc/trace.html), so that the
+/ data moved out with f_trace_dump() on the target can be compared as is.
+/ Only the disk read/write/ioctl records are compared and the others,
+/ such as API function records in the field trace, are ignored.
+/
+/ Script: One API call in a line. Blank lines and lines start with '#'
+/ are ignored. The <fh> is the file handle number (0..7). The "$i" in a
+/ path is replaced with the loop counter of the innermost repeat block.
+/
+/   open <fh> <path> <mode>     mode: combination of r, w, c(FA_CREATE_ALWAYS),
+/                                     n(FA_CREATE_NEW), o(FA_OPEN_ALWAYS) and
+/                                     a(FA_OPEN_APPEND)
+/   close <fh>
+/   read <fh> <bytes>
+/   write <fh> <bytes>
+/   seek <fh> <offset>
+/   truncate <fh>
+/   sync <fh>
+/   mkdir <path>
+/   unlink <path>
+/   rename <old path> <new path>
+/   stat <path>
+/   list <path>                 Read all items in the directory
+/   getfree
+/   repeat <count> ... end      Repeat the enclosed lines
+/
+/ Build:  cc -O2 -I../../src app8.c ../../src/ff.c ../../src/ffunicode.c ../../src/diskio_posix.c
+/ Config: FF_FS_READONLY = 0, FF_FS_MINIMIZE = 0, FF_USE_MKFS = 1
+/ Usage:  app8 run [-t fat|fat32|exfat] [-m sdc|emmc] [-s <MiB>] <script> <trace file>
+/         app8 diff <trace file 1> <trace file 2>
+/         app8 dump <trace file>
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ff.h"
+#include "diskio.h"
+#include "diskio_posix.h"
+
+
+#define PDRV    0       /* Physical drive of the volume "" */
+#define N_FH    8       /* Number of file handles */
+#define MAX_LN  1000    /* Maximum number of lines in the script */
+#define SZ_LN   256     /* Maximum length of a line */
+
+static FATFS FatFs;
+static FIL Fil[N_FH];
+static BYTE Buff[256 * 1024];   /* Data buffer and working buffer for f_mkfs */
+
+static char Line[MAX_LN][SZ_LN];    /* Script */
+static UINT Lines;                  /* Number of lines in the script */
+static UINT Calls, Errors;          /* Number of API calls and failed calls */
+
+
+/* Summary of a trace */
+typedef struct {
+    DWORD   n_rec;      /* Number of disk records */
+    DWORD   n_rd, n_wr, n_sync, n_trim, n_ioctl;    /* Number of commands */
+    DWORD   s_rd, s_wr;     /* Number of sectors read/written */
+    double  t_rd, t_wr, t_ioctl;    /* Command time [ms] */
+} SUMMARY;
+
+
+
+
+/*----------------------------------------------------------------------*/
+/* Script Interpreter                                                   */
+/*----------------------------------------------------------------------*/
+
+static
+void expand (       /* Replace "$i" in the argument with the loop counter */
+    char* dst,      /* Buffer to store the result (SZ_LN bytes) */
+    const char* src,
+    DWORD ctr
+)
+{
+    UINT i = 0;
+
+
+    while (*src && i < SZ_LN - 11) {
+        if (src[0] == '$' && src[1] == 'i') {
+            i += sprintf(dst + i, "%lu", (unsigned long)ctr);
+            src += 2;
+        } else {
+            dst[i++] = *src++;
+        }
+    }
+    dst[i] = 0;
+}
+
+
+static
+BYTE str2mode (     /* Convert mode string into the f_open mode flags */
+    const char* s
+)
+{
+    BYTE mode = 0;
+
+    for ( ; *s; s++) {
+        switch (*s) {
+        case 'r': mode |= FA_READ; break;
+        case 'w': mode |= FA_WRITE; break;
+        case 'c': mode |= FA_CREATE_ALWAYS; break;
+        case 'n': mode |= FA_CREATE_NEW; break;
+        case 'o': mode |= FA_OPEN_ALWAYS; break;
+        case 'a': mode |= FA_OPEN_APPEND; break;
+        }
+    }
+    return mode;
+}
+
+
+static
+FRESULT call (      /* Execute an API call */
+    char* ln,       /* Line to be executed (broken into tokens) */
+    DWORD ctr       /* Loop counter */
+)
+{
+    char *cmd, *a1, *a2, *a3;
+    char p1[SZ_LN], p2[SZ_LN];
+    FRESULT res = FR_OK;
+    UINT fh, n, bw;
+    DWORD nb, nc;
+    FATFS *fs;
+    FILINFO fno;
+    DIR dir;
+
+
+    cmd = strtok(ln, " \t\r\n");
+    a1 = strtok(0, " \t\r\n");
+    a2 = strtok(0, " \t\r\n");
+    a3 = strtok(0, " \t\r\n");
+    fh = a1 ? (UINT)atoi(a1) % N_FH : 0;
+
+    if (!strcmp(cmd, "open") && a3) {
+        expand(p1, a2, ctr);
+        res = f_open(&Fil[fh], p1, str2mode(a3));
+    } else if (!strcmp(cmd, "close") && a1) {
+        res = f_close(&Fil[fh]);
+    } else if ((!strcmp(cmd, "read") || !strcmp(cmd, "write")) && a2) {
+        for (nb = strtoul(a2, 0, 0); res == FR_OK && nb > 0; nb -= n) {
+            n = nb < sizeof Buff ? (UINT)nb : sizeof Buff;
+            if (cmd[0] == 'r') {
+                res = f_read(&Fil[fh], Buff, n, &bw);
+            } else {
+                memset(Buff, (int)(Calls & 0xFF), n);
+                res = f_write(&Fil[fh], Buff, n, &bw);
+            }
+            if (bw < n) break;
+        }
+    } else if (!strcmp(cmd, "seek") && a2) {
+        res = f_lseek(&Fil[fh], (FSIZE_t)strtoull(a2, 0, 0));
+    } else if (!strcmp(cmd, "truncate") && a1) {
+        res = f_truncate(&Fil[fh]);
+    } else if (!strcmp(cmd, "sync") && a1) {
+        res = f_sync(&Fil[fh]);
+    } else if (!strcmp(cmd, "mkdir") && a1) {
+        expand(p1, a1, ctr);
+        res = f_mkdir(p1);
+    } else if (!strcmp(cmd, "unlink") && a1) {
+        expand(p1, a1, ctr);
+        res = f_unlink(p1);
+    } else if (!strcmp(cmd, "rename") && a2) {
+        expand(p1, a1, ctr);
+        expand(p2, a2, ctr);
+        res = f_rename(p1, p2);
+    } else if (!strcmp(cmd, "stat") && a1) {
+        expand(p1, a1, ctr);
+        res = f_stat(p1, &fno);
+    } else if (!strcmp(cmd, "list") && a1) {
+        expand(p1, a1, ctr);
+        res = f_opendir(&dir, p1);
+        while (res == FR_OK) {
+            res = f_readdir(&dir, &fno);
+            if (res != FR_OK || !fno.fname[0]) break;
+        }
+        f_closedir(&dir);
+    } else if (!strcmp(cmd, "getfree")) {
+        res = f_getfree("", &nc, &fs);
+    } else {
+        return FR_INVALID_PARAMETER;
+    }
+    return res;
+}
+
+
+static
+UINT run_block (    /* Execute lines in the block and returns the line next to the block */
+    UINT ln,        /* Line to start */
+    DWORD ctr,      /* Loop counter */
+    int skip        /* Skip the block without execution */
+)
+{
+    char buf[SZ_LN];
+    char *p;
+    DWORD i, n;
+    UINT end;
+    FRESULT res;
+
+
+    while (ln < Lines) {
+        strcpy(buf, Line[ln]);
+        p = strtok(buf, " \t\r\n");
+        if (!p || p[0] == '#') {    /* Blank or comment line */
+            ln++;
+            continue;
+        }
+        if (!strcmp(p, "end")) return ln + 1;   /* End of the block */
+        if (!strcmp(p, "repeat")) {
+            p = strtok(0, " \t\r\n");
+            n = (p && !skip) ? strtoul(p, 0, 0) : 0;
+            end = run_block(ln + 1, 0, 1);      /* Find end of the block */
+            for (i = 0; i < n; i++) run_block(ln + 1, i, 0);
+            ln = end;
+            continue;
+        }
+        if (skip) {
+            ln++;
+            continue;
+        }
+        strcpy(buf, Line[ln]);
+        Calls++;
+        res = call(buf, ctr);
+        if (res != FR_OK) {
+            Errors++;
+            fprintf(stderr, "line %u: %s", ln + 1, Line[ln]);
+            fprintf(stderr, "  -> failed (%u)\n", res);
+        }
+        ln++;
+    }
+    return ln;
+}
+
+
+
+
+/*----------------------------------------------------------------------*/
+/* Trace File Analysis                                                  */
+/*----------------------------------------------------------------------*/
+
+static
+DWORD ld_le (       /* Load a little-endian value */
+    const BYTE* p,
+    UINT n
+)
+{
+    DWORD v = 0;
+
+    while (n--) v = v << 8 | p[n];
+    return v;
+}
+
+
+static
+int is_disk (       /* Check if the record is a disk command to be compared */
+    const BYTE* rec
+)
+{
+    return rec[14] >= FTO_DISK_READ && rec[14] <= FTO_DISK_WRITEV;  /* read, write, ioctl, readv and writev */
+}
+
+
+static
+BYTE* load_trace (  /* Load a trace file and returns the records (0:error) */
+    const char* path,
+    DWORD* nrec
+)
+{
+    FILE *fp;
+    BYTE *buf = 0;
+    long sz;
+
+
+    fp = fopen(path, "rb");
+    if (!fp) {
+        perror(path);
+        return 0;
+    }
+    if (fseek(fp, 0, SEEK_END) == 0 && (sz = ftell(fp)) >= 0 && fseek(fp, 0, SEEK_SET) == 0) {
+        buf = malloc(sz + 1);
+        if (buf && fread(buf, 1, sz, fp) != (size_t)sz) {
+            free(buf);
+            buf = 0;
+        }
+        *nrec = (DWORD)(sz / FTO_RECSIZE);
+    }
+    fclose(fp);
+    if (!buf) fprintf(stderr, "%s: cannot be read\n", path);
+    return buf;
+}
+
+
+static
+void summarize (
+    const BYTE* rec,
+    DWORD nrec,
+    SUMMARY* sm
+)
+{
+    DWORD i, cnt;
+    double ms;
+
+
+    memset(sm, 0, sizeof *sm);
+    for (i = 0; i < nrec; i++, rec += FTO_RECSIZE) {
+        if (!is_disk(rec)) continue;
+        sm->n_rec++;
+        cnt = ld_le(rec + 12, 2);
+        ms = ld_le(rec + 4, 4) / 1000.0;
+        switch (rec[14]) {
+        case FTO_DISK_READ:
+        case FTO_DISK_READV:
+            sm->n_rd++; sm->s_rd += cnt; sm->t_rd += ms;
+            break;
+        case FTO_DISK_WRITE:
+        case FTO_DISK_WRITEV:
+            sm->n_wr++; sm->s_wr += cnt; sm->t_wr += ms;
+            break;
+        default:
+            sm->n_ioctl++; sm->t_ioctl += ms;
+            if (ld_le(rec + 8, 4) == CTRL_SYNC) sm->n_sync++;
+            if (ld_le(rec + 8, 4) == CTRL_TRIM) sm->n_trim++;
+        }
+    }
+}
+
+
+static
+void print_summary (
+    const SUMMARY* sm
+)
+{
+    printf("read:  %lu commands, %lu sectors, %.3f ms\n", (unsigned long)sm->n_rd, (unsigned long)sm->s_rd, sm->t_rd);
+    printf("write: %lu commands, %lu sectors, %.3f ms\n", (unsigned long)sm->n_wr, (unsigned long)sm->s_wr, sm->t_wr);
+    printf("ioctl: %lu commands (sync %lu, trim %lu), %.3f ms\n", (unsigned long)sm->n_ioctl, (unsigned long)sm->n_sync, (unsigned long)sm->n_trim, sm->t_ioctl);
+}
+
+
+static
+int do_dump (       /* Print the records in text */
+    const char* path
+)
+{
+    static const char* const name[] = {"init", "status", "read", "write", "ioctl", "readv", "writev"};
+    BYTE *buf, *rec;
+    DWORD i, nrec;
+
+
+    buf = load_trace(path, &nrec);
+    if (!buf) return 2;
+    for (i = 0, rec = buf; i < nrec; i++, rec += FTO_RECSIZE) {
+        printf("%10lu %8lu ", (unsigned long)ld_le(rec, 4), (unsigned long)ld_le(rec + 4, 4));
+        if (rec[14] >= FTO_DISK_INIT && rec[14] <= FTO_DISK_WRITEV) {
+            printf("disk_%-7s", name[rec[14] - FTO_DISK_INIT]);
+        } else {
+            printf("api(0x%02X)  ", rec[14]);
+        }
+        printf(" res=%-3u arg=%-10lu cnt=%u\n", rec[15], (unsigned long)ld_le(rec + 8, 4), (UINT)ld_le(rec + 12, 2));
+    }
+    free(buf);
+    return 0;
+}
+
+
+static
+int do_diff (       /* Compare disk commands in two traces */
+    const char* path1,
+    const char* path2
+)
+{
+    BYTE *b1, *b2, *r1, *r2;
+    DWORD n1, n2, i1, i2, nsame = 0;
+    SUMMARY s1, s2;
+    int rc = 0;
+
+
+    b1 = load_trace(path1, &n1);
+    b2 = load_trace(path2, &n2);
+    if (!b1 || !b2) return 2;
+
+    summarize(b1, n1, &s1);
+    summarize(b2, n2, &s2);
+    printf("%-24s %12s %12s %12s\n", "", "trace 1", "trace 2", "diff");
+    printf("%-24s %12lu %12lu %+12ld\n", "read commands", (unsigned long)s1.n_rd, (unsigned long)s2.n_rd, (long)s2.n_rd - (long)s1.n_rd);
+    printf("%-24s %12lu %12lu %+12ld\n", "sectors read", (unsigned long)s1.s_rd, (unsigned long)s2.s_rd, (long)s2.s_rd - (long)s1.s_rd);
+    printf("%-24s %12lu %12lu %+12ld\n", "write commands", (unsigned long)s1.n_wr, (unsigned long)s2.n_wr, (long)s2.n_wr - (long)s1.n_wr);
+    printf("%-24s %12lu %12lu %+12ld\n", "sectors written", (unsigned long)s1.s_wr, (unsigned long)s2.s_wr, (long)s2.s_wr - (long)s1.s_wr);
+    printf("%-24s %12lu %12lu %+12ld\n", "sync commands", (unsigned long)s1.n_sync, (unsigned long)s2.n_sync, (long)s2.n_sync - (long)s1.n_sync);
+    printf("%-24s %12lu %12lu %+12ld\n", "trim commands", (unsigned long)s1.n_trim, (unsigned long)s2.n_trim, (long)s2.n_trim - (long)s1.n_trim);
+    printf("%-24s %12lu %12lu %+12ld\n", "other ioctl commands", (unsigned long)(s1.n_ioctl - s1.n_sync - s1.n_trim), (unsigned long)(s2.n_ioctl - s2.n_sync - s2.n_trim), (long)(s2.n_ioctl - s2.n_sync - s2.n_trim) - (long)(s1.n_ioctl - s1.n_sync - s1.n_trim));
+    printf("%-24s %12.3f %12.3f %+12.3f\n", "command time [ms]", s1.t_rd + s1.t_wr + s1.t_ioctl, s2.t_rd + s2.t_wr + s2.t_ioctl, (s2.t_rd + s2.t_wr + s2.t_ioctl) - (s1.t_rd + s1.t_wr + s1.t_ioctl));
+
+    /* Find the first command that differs in the sequence */
+    i1 = i2 = 0; r1 = b1; r2 = b2;
+    for (;;) {
+        while (i1 < n1 && !is_disk(r1)) { i1++; r1 += FTO_RECSIZE; }
+        while (i2 < n2 && !is_disk(r2)) { i2++; r2 += FTO_RECSIZE; }
+        if (i1 == n1 || i2 == n2) break;
+        if (memcmp(r1 + 8, r2 + 8, 8) != 0) break;  /* Compare sector/command, count, op and result */
+        nsame++;
+        i1++; r1 += FTO_RECSIZE;
+        i2++; r2 += FTO_RECSIZE;
+    }
+    if (i1 == n1 && i2 == n2) {
+        printf("The command sequences are identical (%lu commands).\n", (unsigned long)nsame);
+    } else {
+        printf("The command sequences differ at command %lu:\n", (unsigned long)nsame + 1);
+        if (i1 < n1) printf("  trace 1: op=0x%02X arg=%lu cnt=%u res=%u\n", r1[14], (unsigned long)ld_le(r1 + 8, 4), (UINT)ld_le(r1 + 12, 2), r1[15]);
+        else printf("  trace 1: (end)\n");
+        if (i2 < n2) printf("  trace 2: op=0x%02X arg=%lu cnt=%u res=%u\n", r2[14], (unsigned long)ld_le(r2 + 8, 4), (UINT)ld_le(r2 + 12, 2), r2[15]);
+        else printf("  trace 2: (end)\n");
+        rc = 1;
+    }
+    free(b1);
+    free(b2);
+    return rc;
+}
+
+
+
+
+/*----------------------------------------------------------------------*/
+/* Replay                                                               */
+/*----------------------------------------------------------------------*/
+
+static
+int do_run (
+    const char* script,
+    const char* trace,
+    BYTE fmt,
+    const PDISK_MODEL* model,
+    DWORD mib
+)
+{
+    FILE *fp;
+    BYTE *buf;
+    DWORD nrec;
+    SUMMARY sm;
+    FRESULT res;
+
+
+    fp = fopen(script, "r");
+    if (!fp) {
+        perror(script);
+        return 2;
+    }
+    for (Lines = 0; Lines < MAX_LN && fgets(Line[Lines], SZ_LN, fp); Lines++) ;
+    fclose(fp);
+
+    if (pdisk_attach(PDRV, PDISK_RAM, 0, mib * 2048, 512) != 0) {
+        perror("pdisk_attach");
+        return 2;
+    }
+    if (model) pdisk_model(PDRV, model);
+    res = f_mkfs("", fmt, 0, Buff, sizeof Buff);
+    if (res == FR_OK) res = f_mount(&FatFs, "", 1);
+    if (res != FR_OK) {
+        fprintf(stderr, "failed to create the volume (%u)\n", res);
+        return 2;
+    }
+
+    if (pdisk_record(PDRV, trace) != 0) {   /* Record the commands issued by the script */
+        perror(trace);
+        return 2;
+    }
+    run_block(0, 0, 0);
+    f_mount(0, "", 0);
+    pdisk_record(PDRV, 0);
+    pdisk_detach(PDRV);
+
+    printf("%u API calls, %u failed\n", Calls, Errors);
+    buf = load_trace(trace, &nrec);
+    if (!buf) return 2;
+    summarize(buf, nrec, &sm);
+    print_summary(&sm);
+    free(buf);
+    return Errors ? 1 : 0;
+}
+
+
+
+int main (int argc, char* argv[])
+{
+    const PDISK_MODEL *model = 0;
+    BYTE fmt = FM_FAT32;
+    DWORD mib = 256;
+    int i;
+
+
+    if (argc == 4 && !strcmp(argv[1], "diff")) return do_diff(argv[2], argv[3]);
+    if (argc == 3 && !strcmp(argv[1], "dump")) return do_dump(argv[2]);
+    if (argc >= 4 && !strcmp(argv[1], "run")) {
+        for (i = 2; i < argc - 2; i++) {
+            if (!strcmp(argv[i], "-t") && i + 1 < argc - 2) {
+                i++;
+                fmt = !strcmp(argv[i], "fat") ? FM_FAT : !strcmp(argv[i], "exfat") ? FM_EXFAT : FM_FAT32;
+            } else if (!strcmp(argv[i], "-m") && i + 1 < argc - 2) {
+                i++;
+                model = !strcmp(argv[i], "emmc") ? &PdiskEMMC : &PdiskSDC;
+            } else if (!strcmp(argv[i], "-s") && i + 1 < argc - 2) {
+                mib = strtoul(argv[++i], 0, 10);
+            } else {
+                break;
+            }
+        }
+        if (i == argc - 2) return do_run(argv[argc - 2], argv[argc - 1], fmt, model, mib);
+    }
+    fprintf(stderr, "usage: %s run [-t fat|fat32|exfat] [-m sdc|emmc] [-s <MiB>] <script> <trace file>\n", argv[0]);
+    fprintf(stderr, "       %s diff <trace file 1> <trace file 2>\n", argv[0]);
+    fprintf(stderr, "       %s dump <trace file>\n", argv[0]);
+    return 2;
+}
@@ -0,0 +1,104 @@
+/*----------------------------------------------------------------------/
+/ Code conversion index checker
+/-----------------------------------------------------------------------/
+/ This program checks that the code conversion with the index tables
+/ (FF_LFN_CVTIDX = 1) gives the same result as the conversion without
+/ them, for every code of every code page. The result is written into the
+/ SFN entries on the volume, so a mismatch would change the name of the
+/ files created, and the SFN-only entries matched, on the volume.
+/ The reference conversion is the linear search (SBCS) and the binary
+/ search over the whole table (DBCS) of the tables in ffunicode.c,
+/ the same as the conversion functions without the index tables.
+/
+/ Build:  cc -O2 -I../../src app9.c
+/ Config: FF_USE_LFN >= 1, FF_CODE_PAGE = 0, FF_LFN_CVTIDX = 1
+/ Usage:  app9
+*/
+
+#include <stdio.h>
+#include "ff.h"
+#include "ffunicode.c"  /* Includes the module to refer its conversion tables */
+
+#if FF_USE_LFN == 0 || FF_CODE_PAGE != 0 || !FF_LFN_CVTIDX
+#error This program needs FF_USE_LFN >= 1, FF_CODE_PAGE = 0 and FF_LFN_CVTIDX = 1
+#endif
+
+
+static
+WCHAR ref_find (    /* Binary search over the whole code pair table */
+    WCHAR key,
+    const WCHAR* p,
+    UINT hi         /* Index of the last pair (terminator) */
+)
+{
+    UINT i = 0, n, li = 0;
+
+
+    for (n = 16; n; n--) {
+        i = li + (hi - li) / 2;
+        if (key == p[i * 2]) break;
+        if (key > p[i * 2]) {
+            li = i;
+        } else {
+            hi = i;
+        }
+    }
+    return n ? p[i * 2 + 1] : 0;
+}
+
+
+int main (void)
+{
+    static const struct {
+        WORD cp;
+        const WCHAR *u2o, *o2u;
+        UINT n_u2o, n_o2u;
+    } dbc[] = {
+        {932, uni2oem932, oem2uni932, sizeof uni2oem932 / 4 - 1, sizeof oem2uni932 / 4 - 1},
+        {936, uni2oem936, oem2uni936, sizeof uni2oem936 / 4 - 1, sizeof oem2uni936 / 4 - 1},
+        {949, uni2oem949, oem2uni949, sizeof uni2oem949 / 4 - 1, sizeof oem2uni949 / 4 - 1},
+        {950, uni2oem950, oem2uni950, sizeof uni2oem950 / 4 - 1, sizeof oem2uni950 / 4 - 1}
+    };
+    const WCHAR *p;
+    DWORD uc, n_err = 0;
+    WCHAR c, r;
+    UINT i;
+
+
+    for (i = 0; cp_code[i]; i++) {  /* SBCS code pages */
+        p = cp_table[i];
+        for (uc = 0; uc < 0x10000; uc++) {
+            c = ff_uni2oem(uc, cp_code[i]);
+            if (uc < 0x80) {
+                r = (WCHAR)uc;
+            } else {
+                for (r = 0; r < 0x80 && uc != p[r]; r++) ;
+                r = (r + 0x80) & 0xFF;
+            }
+            if (c != r) {
+                printf("CP%u: U+%04lX -> %04X (expected %04X)\n", cp_code[i], (unsigned long)uc, c, r);
+                n_err++;
+            }
+        }
+    }
+
+    for (i = 0; i < sizeof dbc / sizeof dbc[0]; i++) {  /* DBCS code pages */
+        for (uc = 0; uc < 0x10000; uc++) {
+            c = ff_uni2oem(uc, dbc[i].cp);
+            r = uc < 0x80 ? (WCHAR)uc : ref_find((WCHAR)uc, dbc[i].u2o, dbc[i].n_u2o);
+            if (c != r) {
+                printf("CP%u: U+%04lX -> %04X (expected %04X)\n", dbc[i].cp, (unsigned long)uc, c, r);
+                n_err++;
+            }
+            c = ff_oem2uni((WCHAR)uc, dbc[i].cp);
+            r = uc < 0x80 ? (WCHAR)uc : ref_find((WCHAR)uc, dbc[i].o2u, dbc[i].n_o2u);
+            if (c != r) {
+                printf("CP%u: %04lX -> U+%04X (expected U+%04X)\n", dbc[i].cp, (unsigned long)uc, c, r);
+                n_err++;
+            }
+        }
+    }
+
+    printf("%lu mismatch(es)\n", (unsigned long)n_err);
+    return n_err ? 1 : 0;
+}
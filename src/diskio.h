@@ -21,6 +21,13 @@ typedef enum {
     RES_PARERR      /* 4: Invalid Parameter */
 } DRESULT;
 
+/* Sector block in the scatter list of disk_readv/disk_writev */
+typedef struct {
+    BYTE*   buff;       /* Data buffer (read-only at disk_writev) */
+    DWORD   sector;     /* Start sector in LBA */
+    UINT    count;      /* Number of sectors */
+} DSEG;
+
 
 /*---------------------------------------*/
 /* Prototypes for disk control functions */
@@ -31,6 +38,8 @@ DSTATUS disk_status (BYTE pdrv);
 DRESULT disk_read (BYTE pdrv, BYTE* buff, DWORD sector, UINT count);
 DRESULT disk_write (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count);
 DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff);
+DRESULT disk_readv (BYTE pdrv, const DSEG* seg, UINT nseg);     /* (needed at FF_DISK_NSEG >= 2) */
+DRESULT disk_writev (BYTE pdrv, const DSEG* seg, UINT nseg);    /* (needed at FF_DISK_NSEG >= 2) */
 
 
 /* Disk Status Bits (DSTATUS) */
@@ -48,6 +57,8 @@ DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff);
 #define GET_SECTOR_SIZE     2   /* Get sector size (needed at FF_MAX_SS != FF_MIN_SS) */
 #define GET_BLOCK_SIZE      3   /* Get erase block size (needed at FF_USE_MKFS == 1) */
 #define CTRL_TRIM           4   /* Inform device that the data on the block of sectors is no longer used (needed at FF_USE_TRIM == 1) */
+#define CTRL_ZERO           9   /* Fill the block of sectors with zero (needed at FF_USE_ZEROFILL == 1) */
+#define CTRL_COPY           15  /* Copy a block of sectors inside the device (needed at FF_USE_COPY == 2) */
 
 /* Generic command (Not used by FatFs) */
 #define CTRL_POWER          5   /* Get/Set power status */
@@ -0,0 +1,807 @@
+/*-----------------------------------------------------------------------*/
+/* Reference disk I/O module for POSIX hosts                             */
+/*-----------------------------------------------------------------------*/
+/* This module attaches RAM disks and disk image files on the POSIX host */
+/* (Linux, BSD and macOS) to the FatFs as physical drives, so that the   */
+/* filesystem can be run and measured without the target hardware. Use  */
+/* this file in place of diskio.c and attach a backend to each physical  */
+/* drive with pdisk_attach() prior to mount the volume.                  */
+/* A latency model can be applied to the drive with pdisk_model(). Then  */
+/* the time the modeled device would take to process the commands is    */
+/* accumulated in virtual time and it can be read with pdisk_stat().     */
+/* The commands issued to the drive can be recorded into a file with     */
+/* pdisk_record() in the trace record format of FatFs (FF_USE_TRACE).    */
+/*-----------------------------------------------------------------------*/
+
+#define _GNU_SOURCE     /* O_DIRECT and fallocate() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ff.h"             /* Obtains integer types */
+#include "diskio.h"         /* Declarations of disk functions */
+#include "diskio_posix.h"   /* Declarations of backend control functions */
+
+#define N_PDRV      FF_VOLUMES  /* Number of physical drives */
+#define DIO_ALIGN   4096        /* Memory alignment required by O_DIRECT */
+#define DIO_BOUNCE  64          /* Size of bounce buffer for O_DIRECT [sectors] */
+
+
+/* Physical drive control block */
+typedef struct {
+    BYTE    type;       /* Backend type and options (0:not attached) */
+    BYTE    stat;       /* Drive status */
+    WORD    ssize;      /* Sector size [byte] */
+    DWORD   nsect;      /* Number of sectors */
+    int     fd;         /* Image file descriptor (-1:none) */
+    BYTE*   mem;        /* RAM disk or mapped image (0:none) */
+    BYTE*   bounce;     /* Aligned transfer buffer for O_DIRECT (0:none) */
+    int     sim;        /* Latency model is applied */
+    PDISK_MODEL model;  /* Latency model */
+    PDISK_STAT st;      /* Accumulated device time and counters */
+    DWORD   oblk[PDISK_NOPEN_MAX];  /* Open erase blocks (0xFFFFFFFF:none) */
+    DWORD   owp[PDISK_NOPEN_MAX];   /* Write pointer in each open erase block [sectors] */
+    DWORD   oage[PDISK_NOPEN_MAX];  /* Last access stamp of each open erase block */
+    DWORD   oclk;       /* Access counter of the open erase blocks */
+    FILE*   rec;        /* Command record file (0:not recording) */
+    unsigned long long  rbase;  /* Time base of the record (wall clock without model) [ns] */
+} PDISK;
+
+static PDISK Drv[N_PDRV];
+
+
+/* Device profiles */
+const PDISK_MODEL PdiskSDC = {      /* SD card in 4-bit SD mode */
+    100000,         /* cmd_ns */
+    20, 10,         /* rd_mbps, wr_mbps */
+    256,            /* eblk (128 KiB at 512-byte sector) */
+    10000,          /* prog_ns */
+    2000000,        /* erase_ns */
+    1000000,        /* sync_ns */
+    500000,         /* trim_ns */
+    2               /* nopen */
+};
+
+const PDISK_MODEL PdiskEMMC = {     /* eMMC in 8-bit HS200 mode */
+    20000,          /* cmd_ns */
+    150, 80,        /* rd_mbps, wr_mbps */
+    1024,           /* eblk (512 KiB at 512-byte sector) */
+    2000,           /* prog_ns */
+    1000000,        /* erase_ns */
+    200000,         /* sync_ns */
+    100000,         /* trim_ns */
+    8               /* nopen */
+};
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Attach a backend to the physical drive                                */
+/*-----------------------------------------------------------------------*/
+
+int pdisk_attach (  /* 0:succeeded, -1:failed (errno is set) */
+    BYTE pdrv,          /* Physical drive number to be attached */
+    UINT type,          /* Backend type and options (PDISK_*) */
+    const char* path,   /* Image file path (not used at PDISK_RAM) */
+    DWORD nsect,        /* Number of sectors (0:Size of the existing image file) */
+    WORD ssize          /* Sector size [byte] (0:FF_MIN_SS) */
+)
+{
+    PDISK *dk;
+    struct stat st;
+    void *p;
+    int flags, err;
+
+
+    if (pdrv >= N_PDRV || Drv[pdrv].type) {
+        errno = pdrv >= N_PDRV ? EINVAL : EBUSY;
+        return -1;
+    }
+    if (ssize == 0) ssize = FF_MIN_SS;
+    if (ssize < FF_MIN_SS || ssize > FF_MAX_SS || (ssize & (ssize - 1))) {
+        errno = EINVAL;
+        return -1;
+    }
+    dk = &Drv[pdrv];
+    dk->fd = -1; dk->mem = 0; dk->bounce = 0;
+
+    switch (type & 0x0F) {
+    case PDISK_RAM :
+        if (nsect == 0) {
+            errno = EINVAL;
+            return -1;
+        }
+        dk->mem = calloc(nsect, ssize);
+        if (!dk->mem) return -1;
+        break;
+
+    case PDISK_FILE :
+    case PDISK_MMAP :
+        flags = O_RDWR | O_CREAT;
+#ifdef O_DIRECT
+        if ((type & 0x0F) == PDISK_FILE && (type & PDISK_DIRECT)) flags |= O_DIRECT;
+#endif
+        dk->fd = open(path, flags, 0666);
+        if (dk->fd < 0) return -1;
+        if (fstat(dk->fd, &st) != 0) goto fail;
+        if (nsect == 0) {   /* Use size of the existing image */
+            nsect = (DWORD)(st.st_size / ssize);
+            if (nsect == 0) {
+                errno = EINVAL;
+                goto fail;
+            }
+        } else {            /* Stretch the image to the given size if needed */
+            if ((off_t)nsect * ssize > st.st_size && ftruncate(dk->fd, (off_t)nsect * ssize) != 0) goto fail;
+        }
+        if ((type & 0x0F) == PDISK_MMAP) {
+            p = mmap(0, (size_t)nsect * ssize, PROT_READ | PROT_WRITE, MAP_SHARED, dk->fd, 0);
+            if (p == MAP_FAILED) goto fail;
+            dk->mem = p;
+        }
+#ifdef O_DIRECT
+        if (flags & O_DIRECT) {     /* Allocate bounce buffer for unaligned transfer */
+            err = posix_memalign(&p, DIO_ALIGN, (size_t)DIO_BOUNCE * ssize);
+            if (err) {
+                errno = err;
+                goto fail;
+            }
+            dk->bounce = p;
+        }
+#endif
+        break;
+
+    default :
+        errno = EINVAL;
+        return -1;
+    }
+
+    dk->type = (BYTE)type;
+    dk->stat = STA_NOINIT;
+    dk->sim = 0;
+    dk->rec = 0;
+    memset(&dk->st, 0, sizeof dk->st);
+    dk->ssize = ssize;
+    dk->nsect = nsect;
+    return 0;
+
+fail:
+    err = errno;
+    close(dk->fd);
+    dk->fd = -1;
+    errno = err;
+    return -1;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Detach the backend from the physical drive                            */
+/*-----------------------------------------------------------------------*/
+
+void pdisk_detach (
+    BYTE pdrv       /* Physical drive number to be detached */
+)
+{
+    PDISK *dk;
+
+
+    if (pdrv >= N_PDRV || !Drv[pdrv].type) return;
+    dk = &Drv[pdrv];
+    if (dk->rec) fclose(dk->rec);
+    if ((dk->type & 0x0F) == PDISK_RAM) {
+        free(dk->mem);
+    } else {
+        if (dk->mem) munmap(dk->mem, (size_t)dk->nsect * dk->ssize);
+        close(dk->fd);
+    }
+    free(dk->bounce);
+    dk->type = 0;
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Apply a latency model to the physical drive                           */
+/*-----------------------------------------------------------------------*/
+
+int pdisk_model (   /* 0:succeeded, -1:failed */
+    BYTE pdrv,                  /* Physical drive number */
+    const PDISK_MODEL* model    /* Latency model (0:Remove the model) */
+)
+{
+    PDISK *dk;
+    UINT i;
+
+
+    if (pdrv >= N_PDRV || !Drv[pdrv].type) return -1;
+    dk = &Drv[pdrv];
+    if (!model) {
+        dk->sim = 0;
+        return 0;
+    }
+    if (model->eblk == 0 || model->nopen < 1 || model->nopen > PDISK_NOPEN_MAX || !model->rd_mbps || !model->wr_mbps) return -1;
+    dk->model = *model;
+    for (i = 0; i < PDISK_NOPEN_MAX; i++) dk->oblk[i] = 0xFFFFFFFF;
+    memset(&dk->st, 0, sizeof dk->st);
+    dk->sim = 1;
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Get accumulated device time and command counters                      */
+/*-----------------------------------------------------------------------*/
+
+void pdisk_stat (
+    BYTE pdrv,          /* Physical drive number */
+    PDISK_STAT* stat,   /* Pointer to the structure to store the result (0:Clear only) */
+    int clear           /* Clear the counters after read */
+)
+{
+    if (pdrv >= N_PDRV || !Drv[pdrv].type) return;
+    if (stat) *stat = Drv[pdrv].st;
+    if (clear) memset(&Drv[pdrv].st, 0, sizeof Drv[pdrv].st);
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Start/Stop to record the commands                                     */
+/*-----------------------------------------------------------------------*/
+
+static unsigned long long wall_ns (void)
+{
+    struct timespec ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+
+int pdisk_record (  /* 0:succeeded, -1:failed (errno is set) */
+    BYTE pdrv,          /* Physical drive number */
+    const char* path    /* Record file to be created (0:Stop recording) */
+)
+{
+    PDISK *dk;
+
+
+    if (pdrv >= N_PDRV || !Drv[pdrv].type) {
+        errno = EINVAL;
+        return -1;
+    }
+    dk = &Drv[pdrv];
+    if (dk->rec) {
+        if (fclose(dk->rec) != 0) {
+            dk->rec = 0;
+            return -1;
+        }
+        dk->rec = 0;
+    }
+    if (path) {
+        dk->rec = fopen(path, "wb");
+        if (!dk->rec) return -1;
+        dk->rbase = wall_ns();
+    }
+    return 0;
+}
+
+
+static unsigned long long rec_time (    /* Current time on the record [ns] */
+    PDISK* dk
+)
+{
+    return dk->sim ? dk->st.time_ns : wall_ns() - dk->rbase;
+}
+
+
+static void st_le (    /* Store a value in little-endian */
+    BYTE* ptr,
+    DWORD val,
+    UINT n          /* Number of bytes */
+)
+{
+    while (n--) {
+        *ptr++ = (BYTE)val;
+        val >>= 8;
+    }
+}
+
+
+static void rec_cmd (
+    PDISK* dk,      /* Physical drive */
+    unsigned long long t0,  /* Start time of the command (rec_time) */
+    BYTE op,        /* Operation ID (FTO_DISK_*) */
+    BYTE res,       /* Result of the command */
+    DWORD arg,      /* Start sector or command code */
+    UINT cnt        /* Number of sectors */
+)
+{
+    BYTE rec[FTO_RECSIZE];
+    DWORD us = (DWORD)((rec_time(dk) - t0) / 1000);
+
+
+    st_le(rec + 0, (DWORD)(t0 / 1000), 4);
+    st_le(rec + 4, us, 4);
+    st_le(rec + 8, arg, 4);
+    st_le(rec + 12, cnt > 0xFFFF ? 0xFFFF : cnt, 2);
+    rec[14] = op;
+    rec[15] = res;
+    fwrite(rec, 1, FTO_RECSIZE, dk->rec);
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Count a command and account its device time                           */
+/*-----------------------------------------------------------------------*/
+
+static void sim_read (
+    PDISK* dk,      /* Physical drive */
+    UINT count,     /* Number of sectors read */
+    int cmd         /* 1:New command, 0:Following block of the command */
+)
+{
+    if (cmd) dk->st.n_read++;
+    dk->st.n_rdsect += count;
+    if (!dk->sim) return;
+    if (cmd) dk->st.time_ns += dk->model.cmd_ns;
+    dk->st.time_ns += (unsigned long long)count * dk->ssize * 1000 / dk->model.rd_mbps;
+}
+
+
+#if FF_FS_READONLY == 0
+static void sim_write (
+    PDISK* dk,      /* Physical drive */
+    DWORD sector,   /* Start sector */
+    UINT count,     /* Number of sectors written */
+    int cmd         /* 1:New command, 0:Following block of the command */
+)
+{
+    PDISK_MODEL *m = &dk->model;
+    DWORD blk, ofs, n;
+    unsigned long long ncp = 0;
+    UINT i, j;
+
+
+    if (cmd) dk->st.n_write++;
+    dk->st.n_wrsect += count;
+    if (!dk->sim) return;
+    if (cmd) dk->st.time_ns += m->cmd_ns;
+    dk->st.time_ns += (unsigned long long)count * dk->ssize * 1000 / m->wr_mbps;
+
+    do {    /* Program each part of the data in the erase block */
+        blk = sector / m->eblk; ofs = sector % m->eblk;
+        n = m->eblk - ofs;
+        if (n > count) n = count;
+        for (i = j = 0; i < m->nopen && dk->oblk[i] != blk; i++) { /* Is the erase block open? */
+            if (dk->oblk[j] != 0xFFFFFFFF && (dk->oblk[i] == 0xFFFFFFFF || dk->oclk - dk->oage[i] > dk->oclk - dk->oage[j])) j = i;   /* Find a free or the least recently used slot */
+        }
+        if (i == m->nopen || dk->owp[i] != ofs) {   /* Not open, or not sequential in the open block */
+            if (i < m->nopen) j = i;    /* Re-open the block written at random */
+            if (dk->oblk[j] != 0xFFFFFFFF) {    /* Close the block in the slot: Copy rest of the old data into the new block */
+                ncp += m->eblk - dk->owp[j];
+            }
+            dk->oblk[j] = blk;          /* Open the block: Erase a new block and copy preceding data into it */
+            dk->st.n_erase++;
+            dk->st.time_ns += m->erase_ns;
+            ncp += ofs;
+            i = j;
+        }
+        dk->owp[i] = ofs + n;
+        dk->oage[i] = ++dk->oclk;
+        if (dk->owp[i] == m->eblk) dk->oblk[i] = 0xFFFFFFFF;    /* Block is filled up */
+        dk->st.time_ns += (unsigned long long)n * m->prog_ns;
+        sector += n; count -= n;
+    } while (count);
+
+    dk->st.n_cpsect += ncp;     /* Copied sectors are read and programmed inside the device */
+    dk->st.time_ns += ncp * (m->prog_ns + (unsigned long long)dk->ssize * 1000 / m->rd_mbps);
+}
+#endif
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Transfer sectors from/to the image file                               */
+/*-----------------------------------------------------------------------*/
+
+static int file_rw (    /* 0:succeeded, -1:failed */
+    int fd,         /* Image file descriptor */
+    BYTE* buff,     /* Data buffer */
+    size_t len,     /* Number of bytes to transfer */
+    off_t ofs,      /* File offset to start */
+    int wr          /* 0:Read, 1:Write */
+)
+{
+    ssize_t n;
+
+
+    while (len > 0) {   /* Repeat until all data is transferred (short transfer can occur) */
+        n = wr ? pwrite(fd, buff, len, ofs) : pread(fd, buff, len, ofs);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        buff += n; len -= (size_t)n; ofs += n;
+    }
+    return 0;
+}
+
+
+static DRESULT xfer (
+    PDISK* dk,      /* Physical drive */
+    BYTE* buff,     /* Data buffer */
+    DWORD sector,   /* Start sector */
+    UINT count,     /* Number of sectors */
+    int wr          /* 0:Read, 1:Write */
+)
+{
+    size_t ss = dk->ssize;
+    UINT n;
+
+
+    if (count == 0 || sector >= dk->nsect || count > dk->nsect - sector) return RES_PARERR;
+
+    if (dk->mem) {  /* RAM disk or mapped image */
+        if (wr) {
+            memcpy(dk->mem + sector * ss, buff, count * ss);
+        } else {
+            memcpy(buff, dk->mem + sector * ss, count * ss);
+        }
+        return RES_OK;
+    }
+
+    if (!dk->bounce || ((size_t)buff & (DIO_ALIGN - 1)) == 0) { /* Buffered I/O or aligned buffer */
+        return file_rw(dk->fd, buff, count * ss, (off_t)sector * ss, wr) ? RES_ERROR : RES_OK;
+    }
+    do {    /* Unaligned buffer at O_DIRECT: Transfer via bounce buffer */
+        n = count < DIO_BOUNCE ? count : DIO_BOUNCE;
+        if (wr) memcpy(dk->bounce, buff, n * ss);
+        if (file_rw(dk->fd, dk->bounce, n * ss, (off_t)sector * ss, wr)) return RES_ERROR;
+        if (!wr) memcpy(buff, dk->bounce, n * ss);
+        buff += n * ss; sector += n; count -= n;
+    } while (count);
+    return RES_OK;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Discard or zero-fill a block of sectors                               */
+/*-----------------------------------------------------------------------*/
+
+static DRESULT discard (
+    PDISK* dk,          /* Physical drive */
+    const DWORD* rt,    /* Start and end sector of the block */
+    int zero            /* 0:Discard (CTRL_TRIM), 1:Fill with zero (CTRL_ZERO) */
+)
+{
+    size_t ss = dk->ssize;
+
+
+    if (rt[0] > rt[1] || rt[1] >= dk->nsect) return RES_PARERR;
+    if ((dk->type & 0x0F) == PDISK_RAM || ((dk->type & 0x0F) == PDISK_MMAP && zero)) {
+        if (zero) memset(dk->mem + rt[0] * ss, 0, (rt[1] - rt[0] + 1) * ss);
+        return RES_OK;
+    }
+#ifdef FALLOC_FL_PUNCH_HOLE
+    if (fallocate(dk->fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, (off_t)rt[0] * ss, (off_t)(rt[1] - rt[0] + 1) * ss) == 0) {
+        return RES_OK;  /* The hole reads as zero */
+    }
+#endif
+    return zero ? RES_ERROR : RES_OK;   /* Discard is only a hint, zero-fill falls back to writing */
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Copy a block of sectors inside the drive                              */
+/*-----------------------------------------------------------------------*/
+
+static DRESULT copy_sect (
+    PDISK* dk,          /* Physical drive */
+    const DWORD* cp     /* Source sector, destination sector and number of sectors */
+)
+{
+    size_t ss = dk->ssize;
+    DWORD src = cp[0], dst = cp[1], count = cp[2], n;
+    void *p;
+    int rc = 0;
+
+
+    if (count == 0 || src >= dk->nsect || count > dk->nsect - src || dst >= dk->nsect || count > dk->nsect - dst) return RES_PARERR;
+    if (src < dst + count && dst < src + count) return RES_PARERR;  /* The blocks must not overlap */
+
+    if (dk->mem) {  /* RAM disk or mapped image */
+        memcpy(dk->mem + dst * ss, dk->mem + src * ss, count * ss);
+    } else {        /* Image file: Copy via an aligned buffer on the host */
+        if (posix_memalign(&p, DIO_ALIGN, (size_t)DIO_BOUNCE * ss) != 0) return RES_ERROR;
+        do {
+            n = count < DIO_BOUNCE ? count : DIO_BOUNCE;
+            rc = file_rw(dk->fd, p, n * ss, (off_t)src * ss, 0);
+            if (rc == 0) rc = file_rw(dk->fd, p, n * ss, (off_t)dst * ss, 1);
+            src += n; dst += n; count -= n;
+        } while (rc == 0 && count);
+        free(p);
+        if (rc) return RES_ERROR;
+    }
+
+    dk->st.n_copy++;
+    dk->st.n_cpsect += cp[2];   /* Copied sectors are read and programmed inside the device */
+    if (dk->sim) dk->st.time_ns += dk->model.cmd_ns + cp[2] * (dk->model.prog_ns + (unsigned long long)ss * 1000 / dk->model.rd_mbps);
+    return RES_OK;
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Get Drive Status                                                      */
+/*-----------------------------------------------------------------------*/
+
+DSTATUS disk_status (
+    BYTE pdrv       /* Physical drive nmuber to identify the drive */
+)
+{
+    if (pdrv >= N_PDRV || !Drv[pdrv].type) return STA_NOINIT | STA_NODISK;
+    return Drv[pdrv].stat;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Inidialize a Drive                                                    */
+/*-----------------------------------------------------------------------*/
+
+DSTATUS disk_initialize (
+    BYTE pdrv       /* Physical drive nmuber to identify the drive */
+)
+{
+    if (pdrv >= N_PDRV || !Drv[pdrv].type) return STA_NOINIT | STA_NODISK;
+    Drv[pdrv].stat &= (BYTE)~STA_NOINIT;
+    return Drv[pdrv].stat;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Read Sector(s)                                                        */
+/*-----------------------------------------------------------------------*/
+
+DRESULT disk_read (
+    BYTE pdrv,      /* Physical drive nmuber to identify the drive */
+    BYTE *buff,     /* Data buffer to store read data */
+    DWORD sector,   /* Start sector in LBA */
+    UINT count      /* Number of sectors to read */
+)
+{
+    PDISK *dk;
+    DRESULT res;
+    unsigned long long t0;
+
+
+    if (pdrv >= N_PDRV) return RES_PARERR;
+    if (disk_status(pdrv) & STA_NOINIT) return RES_NOTRDY;
+    dk = &Drv[pdrv];
+
+    t0 = dk->rec ? rec_time(dk) : 0;
+    res = xfer(dk, buff, sector, count, 0);
+    if (res == RES_OK) sim_read(dk, count, 1);
+    if (dk->rec) rec_cmd(dk, t0, FTO_DISK_READ, (BYTE)res, sector, count);
+    return res;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Read Sector Blocks in a Command                                       */
+/*-----------------------------------------------------------------------*/
+
+DRESULT disk_readv (
+    BYTE pdrv,          /* Physical drive nmuber to identify the drive */
+    const DSEG* seg,    /* Scatter list of the sector blocks to read */
+    UINT nseg           /* Number of sector blocks */
+)
+{
+    PDISK *dk;
+    DRESULT res = RES_PARERR;
+    unsigned long long t0;
+    UINT i, cnt = 0;
+
+
+    if (pdrv >= N_PDRV) return RES_PARERR;
+    if (disk_status(pdrv) & STA_NOINIT) return RES_NOTRDY;
+    dk = &Drv[pdrv];
+
+    t0 = dk->rec ? rec_time(dk) : 0;
+    for (i = 0; i < nseg; i++) {    /* Each block is transferred in the data phase of a command */
+        res = xfer(dk, seg[i].buff, seg[i].sector, seg[i].count, 0);
+        if (res != RES_OK) break;
+        sim_read(dk, seg[i].count, i == 0);
+        cnt += seg[i].count;
+    }
+    if (dk->rec) rec_cmd(dk, t0, FTO_DISK_READV, (BYTE)res, nseg ? seg[0].sector : 0, cnt);
+    return res;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Write Sector(s)                                                       */
+/*-----------------------------------------------------------------------*/
+
+#if FF_FS_READONLY == 0
+
+DRESULT disk_write (
+    BYTE pdrv,          /* Physical drive nmuber to identify the drive */
+    const BYTE *buff,   /* Data to be written */
+    DWORD sector,       /* Start sector in LBA */
+    UINT count          /* Number of sectors to write */
+)
+{
+    PDISK *dk;
+    DRESULT res;
+    unsigned long long t0;
+
+
+    if (pdrv >= N_PDRV) return RES_PARERR;
+    if (disk_status(pdrv) & STA_NOINIT) return RES_NOTRDY;
+    dk = &Drv[pdrv];
+
+    t0 = dk->rec ? rec_time(dk) : 0;
+    res = xfer(dk, (BYTE*)buff, sector, count, 1);
+    if (res == RES_OK) sim_write(dk, sector, count, 1);
+    if (dk->rec) rec_cmd(dk, t0, FTO_DISK_WRITE, (BYTE)res, sector, count);
+    return res;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Write Sector Blocks in a Command                                      */
+/*-----------------------------------------------------------------------*/
+
+DRESULT disk_writev (
+    BYTE pdrv,          /* Physical drive nmuber to identify the drive */
+    const DSEG* seg,    /* Scatter list of the sector blocks to write */
+    UINT nseg           /* Number of sector blocks */
+)
+{
+    PDISK *dk;
+    DRESULT res = RES_PARERR;
+    unsigned long long t0;
+    UINT i, cnt = 0;
+
+
+    if (pdrv >= N_PDRV) return RES_PARERR;
+    if (disk_status(pdrv) & STA_NOINIT) return RES_NOTRDY;
+    dk = &Drv[pdrv];
+
+    t0 = dk->rec ? rec_time(dk) : 0;
+    for (i = 0; i < nseg; i++) {
+        res = xfer(dk, seg[i].buff, seg[i].sector, seg[i].count, 1);
+        if (res != RES_OK) break;
+        sim_write(dk, seg[i].sector, seg[i].count, i == 0);
+        cnt += seg[i].count;
+    }
+    if (dk->rec) rec_cmd(dk, t0, FTO_DISK_WRITEV, (BYTE)res, nseg ? seg[0].sector : 0, cnt);
+    return res;
+}
+
+#endif
+
+
+/*-----------------------------------------------------------------------*/
+/* Miscellaneous Functions                                               */
+/*-----------------------------------------------------------------------*/
+
+static DRESULT ctrl (
+    PDISK* dk,      /* Physical drive */
+    BYTE cmd,       /* Control code */
+    void *buff      /* Buffer to send/receive control data */
+)
+{
+    switch (cmd) {
+    case CTRL_SYNC :        /* Flush the written data to the storage */
+        dk->st.n_sync++;
+        if (dk->sim) dk->st.time_ns += dk->model.cmd_ns + dk->model.sync_ns;
+        if (dk->fd >= 0) {
+            if (dk->mem && msync(dk->mem, (size_t)dk->nsect * dk->ssize, MS_SYNC) != 0) return RES_ERROR;
+            if (fsync(dk->fd) != 0) return RES_ERROR;
+        }
+        return RES_OK;
+
+    case GET_SECTOR_COUNT : /* Get number of sectors on the drive */
+        *(DWORD*)buff = dk->nsect;
+        return RES_OK;
+
+    case GET_SECTOR_SIZE :  /* Get sector size */
+        *(WORD*)buff = dk->ssize;
+        return RES_OK;
+
+    case GET_BLOCK_SIZE :   /* Get erase block size in unit of sector (1:unknown) */
+        *(DWORD*)buff = dk->sim ? dk->model.eblk : 1;
+        return RES_OK;
+
+    case CTRL_TRIM :        /* Discard the block of sectors */
+        dk->st.n_trim++;
+        if (dk->sim) dk->st.time_ns += dk->model.cmd_ns + dk->model.trim_ns;
+        return discard(dk, (const DWORD*)buff, 0);
+
+    case CTRL_ZERO :        /* Fill the block of sectors with zero */
+        return discard(dk, (const DWORD*)buff, 1);
+
+    case CTRL_COPY :        /* Copy the block of sectors inside the drive */
+        return copy_sect(dk, (const DWORD*)buff);
+    }
+
+    return RES_PARERR;
+}
+
+
+DRESULT disk_ioctl (
+    BYTE pdrv,      /* Physical drive nmuber (0..) */
+    BYTE cmd,       /* Control code */
+    void *buff      /* Buffer to send/receive control data */
+)
+{
+    PDISK *dk;
+    DRESULT res;
+    unsigned long long t0;
+
+
+    if (pdrv >= N_PDRV) return RES_PARERR;
+    if (disk_status(pdrv) & STA_NOINIT) return RES_NOTRDY;
+    dk = &Drv[pdrv];
+
+    t0 = dk->rec ? rec_time(dk) : 0;
+    res = ctrl(dk, cmd, buff);
+    if (dk->rec) rec_cmd(dk, t0, FTO_DISK_IOCTL, (BYTE)res, cmd, 0);
+    return res;
+}
+
+
+
+#if !FF_FS_NORTC && !FF_FS_READONLY
+/*-----------------------------------------------------------------------*/
+/* Get current time from the host                                        */
+/*-----------------------------------------------------------------------*/
+
+DWORD get_fattime (void)
+{
+    time_t t = time(0);
+    struct tm *tm = localtime(&t);
+
+
+    return (DWORD)(tm->tm_year - 80) << 25 | (DWORD)(tm->tm_mon + 1) << 21 | (DWORD)tm->tm_mday << 16
+        | (DWORD)tm->tm_hour << 11 | (DWORD)tm->tm_min << 5 | (DWORD)tm->tm_sec >> 1;
+}
+#endif
+
+
+
+#if FF_USE_TRACE
+/*-----------------------------------------------------------------------*/
+/* Get current time for the operation tracing [us]                       */
+/*-----------------------------------------------------------------------*/
+
+DWORD ff_trace_clock (void)
+{
+    struct timespec ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (DWORD)((unsigned long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+#endif
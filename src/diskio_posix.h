@@ -0,0 +1,71 @@
+/*-----------------------------------------------------------------------/
+/  Reference disk I/O module for POSIX hosts include file                /
+/-----------------------------------------------------------------------*/
+
+#ifndef _DISKIO_POSIX_DEFINED
+#define _DISKIO_POSIX_DEFINED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Backend types for pdisk_attach() */
+
+#define PDISK_RAM       1       /* In-memory RAM disk */
+#define PDISK_FILE      2       /* Image file accessed with pread/pwrite */
+#define PDISK_MMAP      3       /* Image file mapped into memory with mmap */
+#define PDISK_DIRECT    0x10    /* Option for PDISK_FILE: Bypass the page cache (O_DIRECT) */
+
+
+/* Latency model of the simulated device */
+
+#define PDISK_NOPEN_MAX 8       /* Maximum number of open erase blocks */
+
+typedef struct {
+    DWORD   cmd_ns;     /* Overhead per command [ns] */
+    DWORD   rd_mbps;    /* Read transfer rate [MB/s] */
+    DWORD   wr_mbps;    /* Write transfer rate [MB/s] */
+    DWORD   eblk;       /* Erase block size [sectors] */
+    DWORD   prog_ns;    /* Time to program a sector [ns] */
+    DWORD   erase_ns;   /* Time to erase an erase block [ns] */
+    DWORD   sync_ns;    /* Time to flush the device cache (CTRL_SYNC) [ns] */
+    DWORD   trim_ns;    /* Time to discard a block of sectors (CTRL_TRIM) [ns] */
+    UINT    nopen;      /* Number of erase blocks that can be written at a time (1..PDISK_NOPEN_MAX) */
+} PDISK_MODEL;
+
+typedef struct {
+    unsigned long long  time_ns;    /* Accumulated device time [ns] (counted only with latency model) */
+    unsigned long long  n_rdsect;   /* Number of sectors read */
+    unsigned long long  n_wrsect;   /* Number of sectors written */
+    unsigned long long  n_cpsect;   /* Number of sectors copied inside the device (read-modify-write and CTRL_COPY) */
+    unsigned long   n_read;     /* Number of read commands */
+    unsigned long   n_write;    /* Number of write commands */
+    unsigned long   n_sync;     /* Number of sync commands */
+    unsigned long   n_trim;     /* Number of trim commands */
+    unsigned long   n_erase;    /* Number of erased blocks */
+    unsigned long   n_copy;     /* Number of copy commands (CTRL_COPY) */
+} PDISK_STAT;
+
+extern const PDISK_MODEL PdiskSDC;      /* SD card like profile */
+extern const PDISK_MODEL PdiskEMMC;     /* eMMC like profile */
+
+
+/* Attach/Detach a backend to the physical drive */
+
+int pdisk_attach (BYTE pdrv, UINT type, const char* path, DWORD nsect, WORD ssize);
+void pdisk_detach (BYTE pdrv);
+
+/* Device time simulation and command counters */
+
+int pdisk_model (BYTE pdrv, const PDISK_MODEL* model);
+void pdisk_stat (BYTE pdrv, PDISK_STAT* stat, int clear);
+
+/* Record the commands into a file (FatFs trace record format, FTO_DISK_*) */
+
+int pdisk_record (BYTE pdrv, const char* path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
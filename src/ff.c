@@ -21,6 +21,9 @@
 
 #include "ff.h"         /* Declarations of FatFs API */
 #include "diskio.h"     /* Declarations of device I/O functions */
+#if FF_USE_STDMEM || FF_WORD_ACCESS
+#include <string.h>     /* memcpy(), memset() and memcmp() */
+#endif
 
 
 /*--------------------------------------------------------------------------
@@ -33,6 +36,12 @@
 #error Wrong include file (ff.h).
 #endif
 
+#if FF_WORD_ACCESS && defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error FF_WORD_ACCESS cannot be used on big-endian processor
+#endif
+#endif
+
 
 /* Limits and boundaries */
 #define MAX_DIR     0x200000        /* Max size of FAT directory */
@@ -209,14 +218,29 @@
 #define ABORT(fs, res)      { fp->err = (BYTE)(res); LEAVE_FF(fs, res); }
 
 
+/* Operation tracing */
+#if FF_USE_TRACE < 0 || FF_USE_TRACE > 2
+#error Wrong FF_USE_TRACE setting
+#endif
+#if FF_USE_TRACE
+#define DEF_TRACE(op)   const BYTE tr_op = op; const DWORD tr_t0 = trace_begin(op);    /* Start to trace the API function */
+#define TRACE_END(res)  trace_end(tr_op, tr_t0, (UINT)(res), 0, 0)
+#define EXIT_FF(res)    { TRACE_END(res); return res; }
+#else
+#define DEF_TRACE(op)
+#define TRACE_END(res)
+#define EXIT_FF(res)    return res
+#endif
+
+
 /* Re-entrancy related */
 #if FF_FS_REENTRANT
 #if FF_USE_LFN == 1
 #error Static LFN work area cannot be used at thread-safe configuration
 #endif
-#define LEAVE_FF(fs, res)   { unlock_fs(fs, res); return res; }
+#define LEAVE_FF(fs, res)   { TRACE_END(res); unlock_fs(fs, res); return res; }
 #else
-#define LEAVE_FF(fs, res)   return res
+#define LEAVE_FF(fs, res)   EXIT_FF(res)
 #endif
 
 
@@ -236,8 +260,44 @@
 #endif
 #if FF_MAX_SS == FF_MIN_SS
 #define SS(fs)  ((UINT)FF_MAX_SS)   /* Fixed sector size */
+#define SSHIFT(fs)  (FF_MAX_SS == 512 ? 9 : FF_MAX_SS == 1024 ? 10 : FF_MAX_SS == 2048 ? 11 : 12)
 #else
 #define SS(fs)  ((fs)->ssize)   /* Variable sector size */
+#define SSHIFT(fs)  ((fs)->ssshift)
+#endif
+#define SNUM(fs, ofs)   ((ofs) >> SSHIFT(fs))           /* Number of sectors in the byte offset (ofs / SS(fs)) */
+#define SOFS(fs, ofs)   ((UINT)(ofs) & (SS(fs) - 1))    /* Byte offset in the sector (ofs % SS(fs)) */
+
+
+/* Volume statistics */
+#if FF_USE_STATS
+#define STAT_INC(fs, m)     ((fs)->stats.m++)
+#define STAT_ADD(fs, m, n)  ((fs)->stats.m += (DWORD)(n))
+#else
+#define STAT_INC(fs, m)     ((void)0)
+#define STAT_ADD(fs, m, n)  ((void)0)
+#endif
+#define DISK_READ(fs, buf, sect, cnt)   (STAT_INC(fs, n_rdcmd), STAT_ADD(fs, n_rdsect, cnt), disk_read((fs)->pdrv, buf, sect, cnt))
+#define DISK_WRITE(fs, buf, sect, cnt)  (STAT_INC(fs, n_wrcmd), STAT_ADD(fs, n_wrsect, cnt), disk_write((fs)->pdrv, buf, sect, cnt))
+#define DISK_SYNC(fs)       (STAT_INC(fs, n_sync), disk_ioctl((fs)->pdrv, CTRL_SYNC, 0))
+#define DISK_READV(fs, seg, n, cnt)     (STAT_INC(fs, n_rdcmd), STAT_ADD(fs, n_rdsect, cnt), disk_readv((fs)->pdrv, seg, n))
+#define DISK_WRITEV(fs, seg, n, cnt)    (STAT_INC(fs, n_wrcmd), STAT_ADD(fs, n_wrsect, cnt), disk_writev((fs)->pdrv, seg, n))
+
+
+/* Definitions of FAT sub-type */
+#if (FF_FS_FATTYPE & ~7) || (FF_FS_FATTYPE == 0 && !FF_FS_EXFAT)
+#error Wrong FF_FS_FATTYPE setting
+#endif
+#if FF_FS_FATTYPE == 1 && !FF_FS_EXFAT
+#define FS_TYPE(fs) FS_FAT12    /* Fixed FAT sub-type */
+#elif FF_FS_FATTYPE == 2 && !FF_FS_EXFAT
+#define FS_TYPE(fs) FS_FAT16
+#elif FF_FS_FATTYPE == 4 && !FF_FS_EXFAT
+#define FS_TYPE(fs) FS_FAT32
+#elif FF_FS_FATTYPE == 0
+#define FS_TYPE(fs) FS_EXFAT
+#else
+#define FS_TYPE(fs) ((fs)->fs_type) /* Variable FAT sub-type */
 #endif
 
 
@@ -252,6 +312,29 @@
 #endif
 
 
+/* Progress report of f_mkfs() */
+#if FF_USE_MKFS && FF_MKFS_PHASE
+#define MKFS_PHASE(ph)  ff_mkfs_phase(ph)
+#else
+#define MKFS_PHASE(ph)
+#endif
+
+
+/* Sector buffer pool */
+#if FF_FS_BUFPOOL < 0 || FF_FS_BUFPOOL > 255
+#error Wrong FF_FS_BUFPOOL setting
+#endif
+#if FF_USE_MAPREAD && !FF_FS_TINY && FF_FS_BUFPOOL == 1
+#error FF_USE_MAPREAD needs FF_FS_BUFPOOL >= 2 to leave a buffer for the other files
+#endif
+
+
+/* Scatter list disk functions */
+#if FF_DISK_NSEG < 0 || FF_DISK_NSEG == 1 || FF_DISK_NSEG > 255
+#error Wrong FF_DISK_NSEG setting
+#endif
+
+
 /* File lock controls */
 #if FF_FS_LOCK != 0
 #if FF_FS_READONLY
@@ -452,6 +535,14 @@ static const char* const VolumeStr[FF_VOLUMES] = {FF_VOLUME_STRS};  /* Pre-defin
 #endif
 #endif
 
+#if FF_USE_TRACE
+static DWORD TrHist[FTO_NUM][FTO_NBIN]; /* Latency histogram of each operation */
+#if FF_TRACE_BUF
+static BYTE TrBuf[FF_TRACE_BUF][FTO_RECSIZE];   /* Trace buffer (ring buffer of trace records) */
+static UINT TrHead, TrCnt;          /* Write index and number of records in the trace buffer */
+#endif
+#endif
+
 
 /*--------------------------------*/
 /* LFN/Directory working buffer   */
@@ -463,8 +554,9 @@ static const char* const VolumeStr[FF_VOLUMES] = {FF_VOLUME_STRS};  /* Pre-defin
 #endif
 #define DEF_NAMBUF
 #define INIT_NAMBUF(fs)
+#define ALLOC_NAMBUF(fs)    1
 #define FREE_NAMBUF()
-#define LEAVE_MKFS(res) return res
+#define LEAVE_MKFS(res) EXIT_FF(res)
 
 #else                   /* LFN configurations */
 #if FF_MAX_LFN < 12 || FF_MAX_LFN > 255
@@ -477,6 +569,8 @@ static const char* const VolumeStr[FF_VOLUMES] = {FF_VOLUME_STRS};  /* Pre-defin
 #error Wrong setting of FF_LFN_UNICODE
 #endif
 static const BYTE LfnOfs[] = {1,3,5,7,9,14,16,18,20,22,24,28,30};   /* FAT: Offset of LFN characters in the directory entry */
+static const BYTE LfnChr[] = {0x00,0x00,0x00,0x00,0xFB,0x7B,0xFF,0x2B,0xFF,0xFF,0xFF,0xEF,0xFF,0xFF,0xFF,0x6F};   /* Bit map of ASCII characters that can be stored into LFN as is */
+#define IsLfnChr(c) ((c) < 0x80 && (LfnChr[(c) >> 3] & (1 << ((c) & 7))))
 #define MAXDIRB(nc) ((nc + 44U) / 15 * SZDIRE)  /* exFAT: Size of directory entry block scratchpad buffer needed for the name length */
 
 #if FF_USE_LFN == 1     /* LFN enabled with static working buffer */
@@ -486,32 +580,37 @@ static BYTE DirBuf[MAXDIRB(FF_MAX_LFN)];    /* Directory entry block scratchpad
 static WCHAR LfnBuf[FF_MAX_LFN + 1];        /* LFN working buffer */
 #define DEF_NAMBUF
 #define INIT_NAMBUF(fs)
+#define ALLOC_NAMBUF(fs)    1
 #define FREE_NAMBUF()
-#define LEAVE_MKFS(res) return res
+#define LEAVE_MKFS(res) EXIT_FF(res)
 
 #elif FF_USE_LFN == 2   /* LFN enabled with dynamic working buffer on the stack */
 #if FF_FS_EXFAT
 #define DEF_NAMBUF      WCHAR lbuf[FF_MAX_LFN+1]; BYTE dbuf[MAXDIRB(FF_MAX_LFN)];   /* LFN working buffer and directory entry block scratchpad buffer */
 #define INIT_NAMBUF(fs) { (fs)->lfnbuf = lbuf; (fs)->dirbuf = dbuf; }
+#define ALLOC_NAMBUF(fs)    ((fs)->lfnbuf = lbuf, (fs)->dirbuf = dbuf, 1)
 #define FREE_NAMBUF()
 #else
 #define DEF_NAMBUF      WCHAR lbuf[FF_MAX_LFN+1];   /* LFN working buffer */
 #define INIT_NAMBUF(fs) { (fs)->lfnbuf = lbuf; }
+#define ALLOC_NAMBUF(fs)    ((fs)->lfnbuf = lbuf, 1)
 #define FREE_NAMBUF()
 #endif
-#define LEAVE_MKFS(res) return res
+#define LEAVE_MKFS(res) EXIT_FF(res)
 
 #elif FF_USE_LFN == 3   /* LFN enabled with dynamic working buffer on the heap */
 #if FF_FS_EXFAT
 #define DEF_NAMBUF      WCHAR *lfn; /* Pointer to LFN working buffer and directory entry block scratchpad buffer */
 #define INIT_NAMBUF(fs) { lfn = ff_memalloc((FF_MAX_LFN+1)*2 + MAXDIRB(FF_MAX_LFN)); if (!lfn) LEAVE_FF(fs, FR_NOT_ENOUGH_CORE); (fs)->lfnbuf = lfn; (fs)->dirbuf = (BYTE*)(lfn+FF_MAX_LFN+1); }
+#define ALLOC_NAMBUF(fs)    ((lfn = ff_memalloc((FF_MAX_LFN+1)*2 + MAXDIRB(FF_MAX_LFN))) != 0 && ((fs)->lfnbuf = lfn, (fs)->dirbuf = (BYTE*)(lfn+FF_MAX_LFN+1), 1))
 #define FREE_NAMBUF()   ff_memfree(lfn)
 #else
 #define DEF_NAMBUF      WCHAR *lfn; /* Pointer to LFN working buffer */
 #define INIT_NAMBUF(fs) { lfn = ff_memalloc((FF_MAX_LFN+1)*2); if (!lfn) LEAVE_FF(fs, FR_NOT_ENOUGH_CORE); (fs)->lfnbuf = lfn; }
+#define ALLOC_NAMBUF(fs)    ((lfn = ff_memalloc((FF_MAX_LFN+1)*2)) != 0 && ((fs)->lfnbuf = lfn, 1))
 #define FREE_NAMBUF()   ff_memfree(lfn)
 #endif
-#define LEAVE_MKFS(res) { if (!work) ff_memfree(buf); return res; }
+#define LEAVE_MKFS(res) { if (!work) ff_memfree(buf); EXIT_FF(res); }
 #define MAX_MALLOC  0x8000  /* Must be >=FF_MAX_SS */
 
 #else
@@ -577,6 +676,55 @@ static const BYTE DbcTbl[] = MKCVTBL(TBL_DC, FF_CODE_PAGE);
 /* Load/Store multi-byte word in the FAT structure                       */
 /*-----------------------------------------------------------------------*/
 
+#if FF_WORD_ACCESS   /* Native word access on the little-endian processor */
+
+static WORD ld_word (const BYTE* ptr)   /*   Load a 2-byte little-endian word */
+{
+    WORD rv;
+
+    memcpy(&rv, ptr, 2);    /* This is compiled into a load instruction */
+    return rv;
+}
+
+static DWORD ld_dword (const BYTE* ptr) /* Load a 4-byte little-endian word */
+{
+    DWORD rv;
+
+    memcpy(&rv, ptr, 4);
+    return rv;
+}
+
+#if FF_FS_EXFAT
+static QWORD ld_qword (const BYTE* ptr) /* Load an 8-byte little-endian word */
+{
+    QWORD rv;
+
+    memcpy(&rv, ptr, 8);
+    return rv;
+}
+#endif
+
+#if !FF_FS_READONLY || (FF_USE_TRACE && FF_TRACE_BUF)  /* (trace records are stored even at read-only cfg) */
+static void st_word (BYTE* ptr, WORD val)   /* Store a 2-byte word in little-endian */
+{
+    memcpy(ptr, &val, 2);   /* This is compiled into a store instruction */
+}
+
+static void st_dword (BYTE* ptr, DWORD val) /* Store a 4-byte word in little-endian */
+{
+    memcpy(ptr, &val, 4);
+}
+#endif
+
+#if !FF_FS_READONLY && FF_FS_EXFAT
+static void st_qword (BYTE* ptr, QWORD val) /* Store an 8-byte word in little-endian */
+{
+    memcpy(ptr, &val, 8);
+}
+#endif
+
+#else   /* Byte-by-byte access compatible with all platforms */
+
 static WORD ld_word (const BYTE* ptr)   /*   Load a 2-byte little-endian word */
 {
     WORD rv;
@@ -614,7 +762,7 @@ static QWORD ld_qword (const BYTE* ptr) /* Load an 8-byte little-endian word */
 }
 #endif
 
-#if !FF_FS_READONLY
+#if !FF_FS_READONLY || (FF_USE_TRACE && FF_TRACE_BUF)  /* (trace records are stored even at read-only cfg) */
 static void st_word (BYTE* ptr, WORD val)   /* Store a 2-byte word in little-endian */
 {
     *ptr++ = (BYTE)val; val >>= 8;
@@ -628,8 +776,9 @@ static void st_dword (BYTE* ptr, DWORD val) /* Store a 4-byte word in little-end
     *ptr++ = (BYTE)val; val >>= 8;
     *ptr++ = (BYTE)val;
 }
+#endif
 
-#if FF_FS_EXFAT
+#if !FF_FS_READONLY && FF_FS_EXFAT
 static void st_qword (BYTE* ptr, QWORD val) /* Store an 8-byte word in little-endian */
 {
     *ptr++ = (BYTE)val; val >>= 8;
@@ -642,7 +791,8 @@ static void st_qword (BYTE* ptr, QWORD val) /* Store an 8-byte word in little-en
     *ptr++ = (BYTE)val;
 }
 #endif
-#endif  /* !FF_FS_READONLY */
+
+#endif  /* FF_WORD_ACCESS */
 
 
 
@@ -650,6 +800,12 @@ static void st_qword (BYTE* ptr, QWORD val) /* Store an 8-byte word in little-en
 /* String functions                                                      */
 /*-----------------------------------------------------------------------*/
 
+#if FF_USE_STDMEM   /* Memory functions in the C standard library */
+#define mem_cpy(dst, src, cnt)  memcpy(dst, src, cnt)
+#define mem_set(dst, val, cnt)  memset(dst, val, cnt)
+#define mem_cmp(dst, src, cnt)  memcmp(dst, src, cnt)
+
+#else
 /* Copy memory to memory */
 static void mem_cpy (void* dst, const void* src, UINT cnt)
 {
@@ -687,6 +843,7 @@ static int mem_cmp (const void* dst, const void* src, UINT cnt) /* ZR:same, NZ:d
 
     return r;
 }
+#endif
 
 
 /* Check if chr is contained in the string */
@@ -1035,6 +1192,151 @@ static void clear_lock (    /* Clear lock entries of the volume */
 
 
 
+#if FF_USE_TRACE
+/*-----------------------------------------------------------------------*/
+/* Operation tracing                                                     */
+/*-----------------------------------------------------------------------*/
+
+static DWORD trace_begin (  /* Returns start time */
+    BYTE op         /* Operation ID */
+)
+{
+#if FF_USE_TRACE == 2
+    ff_trace_begin(op);
+#else
+    (void)op;
+#endif
+    return ff_trace_clock();
+}
+
+
+static void trace_end (
+    BYTE op,        /* Operation ID */
+    DWORD t0,       /* Start time of the operation */
+    UINT res,       /* Result of the operation */
+    DWORD arg,      /* Sector number or command code (disk functions) */
+    UINT cnt        /* Number of sectors (disk functions) */
+)
+{
+    DWORD tick;
+    UINT i;
+#if FF_TRACE_BUF
+    BYTE *rec;
+#endif
+
+
+    tick = ff_trace_clock() - t0;   /* Elapsed time */
+    for (i = 0; i < FTO_NBIN - 1 && (tick >> i) != 0; i++) ;  /* Histogram bin (log2 scale) */
+    TrHist[op][i]++;
+#if FF_TRACE_BUF
+    rec = TrBuf[TrHead];            /* Put a record into the trace buffer */
+    st_dword(rec + 0, t0);
+    st_dword(rec + 4, tick);
+    st_dword(rec + 8, arg);
+    st_word(rec + 12, (WORD)(cnt > 0xFFFF ? 0xFFFF : cnt));
+    rec[14] = op;
+    rec[15] = (BYTE)res;
+    if (++TrHead == FF_TRACE_BUF) TrHead = 0;
+    if (TrCnt < FF_TRACE_BUF) TrCnt++;  /* Overwrite the oldest record if full */
+#else
+    (void)res; (void)arg; (void)cnt;    /* (not recorded without the trace buffer) */
+#endif
+#if FF_USE_TRACE == 2
+    ff_trace_end(op, res, tick);
+#endif
+}
+
+
+/* Disk I/O functions with tracing */
+
+static DSTATUS trace_disk_initialize (BYTE pdrv)
+{
+    DWORD t0 = trace_begin(FTO_DISK_INIT);
+    DSTATUS stat = disk_initialize(pdrv);
+
+    trace_end(FTO_DISK_INIT, t0, stat, 0, 0);
+    return stat;
+}
+
+static DSTATUS trace_disk_status (BYTE pdrv)
+{
+    DWORD t0 = trace_begin(FTO_DISK_STATUS);
+    DSTATUS stat = disk_status(pdrv);
+
+    trace_end(FTO_DISK_STATUS, t0, stat, 0, 0);
+    return stat;
+}
+
+static DRESULT trace_disk_read (BYTE pdrv, BYTE* buff, DWORD sector, UINT count)
+{
+    DWORD t0 = trace_begin(FTO_DISK_READ);
+    DRESULT dr = disk_read(pdrv, buff, sector, count);
+
+    trace_end(FTO_DISK_READ, t0, dr, sector, count);
+    return dr;
+}
+
+#if !FF_FS_READONLY
+static DRESULT trace_disk_write (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count)
+{
+    DWORD t0 = trace_begin(FTO_DISK_WRITE);
+    DRESULT dr = disk_write(pdrv, buff, sector, count);
+
+    trace_end(FTO_DISK_WRITE, t0, dr, sector, count);
+    return dr;
+}
+#endif
+
+#if !FF_FS_READONLY || FF_MAX_SS != FF_MIN_SS
+static DRESULT trace_disk_ioctl (BYTE pdrv, BYTE cmd, void* buff)
+{
+    DWORD t0 = trace_begin(FTO_DISK_IOCTL);
+    DRESULT dr = disk_ioctl(pdrv, cmd, buff);
+
+    trace_end(FTO_DISK_IOCTL, t0, dr, cmd, 0);
+    return dr;
+}
+#endif
+
+#if FF_DISK_NSEG
+static DRESULT trace_disk_readv (BYTE pdrv, const DSEG* seg, UINT nseg)
+{
+    DWORD t0 = trace_begin(FTO_DISK_READV);
+    DRESULT dr = disk_readv(pdrv, seg, nseg);
+    UINT i, cnt;
+
+    for (cnt = i = 0; i < nseg; cnt += seg[i++].count) ;
+    trace_end(FTO_DISK_READV, t0, dr, seg[0].sector, cnt);    /* Top sector and total number of sectors */
+    return dr;
+}
+
+#if !FF_FS_READONLY
+static DRESULT trace_disk_writev (BYTE pdrv, const DSEG* seg, UINT nseg)
+{
+    DWORD t0 = trace_begin(FTO_DISK_WRITEV);
+    DRESULT dr = disk_writev(pdrv, seg, nseg);
+    UINT i, cnt;
+
+    for (cnt = i = 0; i < nseg; cnt += seg[i++].count) ;
+    trace_end(FTO_DISK_WRITEV, t0, dr, seg[0].sector, cnt);
+    return dr;
+}
+#endif
+#endif
+
+/* Route the disk I/O calls in this module through the functions above */
+#define disk_initialize trace_disk_initialize
+#define disk_status     trace_disk_status
+#define disk_read       trace_disk_read
+#define disk_write      trace_disk_write
+#define disk_ioctl      trace_disk_ioctl
+#define disk_readv      trace_disk_readv
+#define disk_writev     trace_disk_writev
+
+#endif  /* FF_USE_TRACE */
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Move/Flush disk access window in the filesystem object                */
 /*-----------------------------------------------------------------------*/
@@ -1047,10 +1349,28 @@ static FRESULT sync_window (    /* Returns FR_OK or FR_DISK_ERR */
 
 
     if (fs->wflag) {    /* Is the disk access window dirty */
-        if (disk_write(fs->pdrv, fs->win, fs->winsect, 1) == RES_OK) {  /* Write back the window */
+#if FF_DISK_NSEG
+        if (fs->winsect - fs->fatbase < fs->fsize && fs->n_fats == 2) { /* Write the FAT sector and its mirror in a command */
+            DSEG seg[2];
+
+            seg[0].buff = seg[1].buff = fs->win;
+            seg[0].sector = fs->winsect; seg[1].sector = fs->winsect + fs->fsize;
+            seg[0].count = seg[1].count = 1;
+            if (DISK_WRITEV(fs, seg, 2, 2) != RES_OK) return FR_DISK_ERR;
+            fs->wflag = 0;
+            STAT_INC(fs, n_winwb);
+            STAT_INC(fs, n_fat2wr);
+            return FR_OK;
+        }
+#endif
+        if (DISK_WRITE(fs, fs->win, fs->winsect, 1) == RES_OK) {  /* Write back the window */
             fs->wflag = 0;  /* Clear window dirty flag */
+            STAT_INC(fs, n_winwb);
             if (fs->winsect - fs->fatbase < fs->fsize) {    /* Is it in the 1st FAT? */
-                if (fs->n_fats == 2) disk_write(fs->pdrv, fs->win, fs->winsect + fs->fsize, 1); /* Reflect it to 2nd FAT if needed */
+                if (fs->n_fats == 2) {  /* Reflect it to 2nd FAT if needed */
+                    STAT_INC(fs, n_fat2wr);
+                    DISK_WRITE(fs, fs->win, fs->winsect + fs->fsize, 1);
+                }
             }
         } else {
             res = FR_DISK_ERR;
@@ -1070,16 +1390,19 @@ static FRESULT move_window (    /* Returns FR_OK or FR_DISK_ERR */
 
 
     if (sector != fs->winsect) {    /* Window offset changed? */
+        STAT_INC(fs, n_winmiss);
 #if !FF_FS_READONLY
         res = sync_window(fs);      /* Write-back changes */
 #endif
         if (res == FR_OK) {         /* Fill sector window with new data */
-            if (disk_read(fs->pdrv, fs->win, sector, 1) != RES_OK) {
+            if (DISK_READ(fs, fs->win, sector, 1) != RES_OK) {
                 sector = 0xFFFFFFFF;    /* Invalidate window if read data is not valid */
                 res = FR_DISK_ERR;
             }
             fs->winsect = sector;
         }
+    } else {
+        STAT_INC(fs, n_winhit);
     }
     return res;
 }
@@ -1087,6 +1410,83 @@ static FRESULT move_window (    /* Returns FR_OK or FR_DISK_ERR */
 
 
 
+#if !FF_FS_TINY && FF_FS_BUFPOOL
+/*-----------------------------------------------------------------------*/
+/* Assign/Release a sector buffer in the pool to the file object         */
+/*-----------------------------------------------------------------------*/
+
+static FRESULT fbuf_take (  /* Returns FR_OK or FR_DISK_ERR */
+    FIL* fp,        /* File object to get the sector buffer */
+    int load        /* 1:Reload fp->sect into a newly assigned buffer, 0:Old contents are not needed */
+)
+{
+    FATFS *fs = fp->obj.fs;
+    FIL *ofp;
+    UINT i, n;
+
+
+    if (fp->buf) {  /* The file already has a buffer (it is never taken away during this operation) */
+        fs->pstamp[(UINT)(fp->buf - fs->pool[0]) / FF_MAX_SS] = ++fs->pclk;    /* Mark it most recently used */
+        return FR_OK;
+    }
+    for (i = 0, n = FF_FS_BUFPOOL; i < FF_FS_BUFPOOL; i++) {   /* Find a free buffer or the least recently used one */
+        if (!fs->pown[i]) {
+            n = i; break;
+        }
+#if FF_USE_MAPREAD
+        if (fs->ppin[i]) continue;  /* Pinned buffer cannot be taken away (at least one is left unpinned) */
+#endif
+        if (n == FF_FS_BUFPOOL || fs->pclk - fs->pstamp[i] > fs->pclk - fs->pstamp[n]) n = i;
+    }
+    ofp = (FIL*)fs->pown[n];
+    if (ofp) {      /* Take the buffer away from the current owner */
+#if !FF_FS_READONLY
+        if (ofp->flag & FA_DIRTY) { /* Write-back its dirty sector */
+            if (DISK_WRITE(fs, ofp->buf, ofp->sect, 1) != RES_OK) return FR_DISK_ERR;
+            ofp->flag &= (BYTE)~FA_DIRTY;
+        }
+#endif
+        ofp->buf = 0;   /* The owner will reload the sector on its next access */
+    }
+    fs->pown[n] = fp;
+    fs->pstamp[n] = ++fs->pclk;
+    fp->buf = fs->pool[n];
+    if (load && fp->sect != 0) {    /* Reload the sector that was appearing in the buffer */
+        if (DISK_READ(fs, fp->buf, fp->sect, 1) != RES_OK) {
+            fs->pown[n] = 0; fp->buf = 0;
+            return FR_DISK_ERR;
+        }
+    } else {
+        mem_set(fp->buf, 0, SS(fs));    /* Do not leak the data of other files */
+    }
+    return FR_OK;
+}
+
+
+static void fbuf_free (
+    FIL* fp         /* File object to release the sector buffer */
+)
+{
+    FATFS *fs = fp->obj.fs;
+    UINT i;
+
+
+    for (i = 0; i < FF_FS_BUFPOOL; i++) {   /* Also releases the buffer left by an abandoned file object at this address */
+        if (fs->pown[i] == fp) {
+            fs->pown[i] = 0;
+#if FF_USE_MAPREAD
+            fs->ppin[i] = 0;
+#endif
+        }
+    }
+    fp->buf = 0;
+}
+
+#endif  /* !FF_FS_TINY && FF_FS_BUFPOOL */
+
+
+
+
 #if !FF_FS_READONLY
 /*-----------------------------------------------------------------------*/
 /* Synchronize filesystem and data on the storage                        */
@@ -1101,7 +1501,7 @@ static FRESULT sync_fs (    /* Returns FR_OK or FR_DISK_ERR */
 
     res = sync_window(fs);
     if (res == FR_OK) {
-        if (fs->fs_type == FS_FAT32 && fs->fsi_flag == 1) { /* FAT32: Update FSInfo sector if needed */
+        if (FS_TYPE(fs) == FS_FAT32 && fs->fsi_flag == 1) { /* FAT32: Update FSInfo sector if needed */
             /* Create FSInfo structure */
             mem_set(fs->win, 0, sizeof fs->win);
             st_word(fs->win + BS_55AA, 0xAA55);
@@ -1111,11 +1511,11 @@ static FRESULT sync_fs (    /* Returns FR_OK or FR_DISK_ERR */
             st_dword(fs->win + FSI_Nxt_Free, fs->last_clst);
             /* Write it into the FSInfo sector */
             fs->winsect = fs->volbase + 1;
-            disk_write(fs->pdrv, fs->win, fs->winsect, 1);
+            DISK_WRITE(fs, fs->win, fs->winsect, 1);
             fs->fsi_flag = 0;
         }
         /* Make sure that no pending write process in the lower layer */
-        if (disk_ioctl(fs->pdrv, CTRL_SYNC, 0) != RES_OK) res = FR_DISK_ERR;
+        if (DISK_SYNC(fs) != RES_OK) res = FR_DISK_ERR;
     }
 
     return res;
@@ -1151,41 +1551,48 @@ static DWORD get_fat (      /* 0xFFFFFFFF:Disk error, 1:Internal error, 2..0x7FF
     DWORD clst      /* Cluster number to get the value */
 )
 {
+#if FF_FS_FATTYPE & 1
     UINT wc, bc;
+#endif
     DWORD val;
     FATFS *fs = obj->fs;
 
 
+    STAT_INC(fs, n_getfat);
     if (clst < 2 || clst >= fs->n_fatent) { /* Check if in valid range */
         val = 1;    /* Internal error */
 
     } else {
         val = 0xFFFFFFFF;   /* Default value falls on disk error */
 
-        switch (fs->fs_type) {
+        switch (FS_TYPE(fs)) {
+#if FF_FS_FATTYPE & 1
         case FS_FAT12 :
             bc = (UINT)clst; bc += bc / 2;
-            if (move_window(fs, fs->fatbase + (bc / SS(fs))) != FR_OK) break;
-            wc = fs->win[bc++ % SS(fs)];        /* Get 1st byte of the entry */
-            if (move_window(fs, fs->fatbase + (bc / SS(fs))) != FR_OK) break;
-            wc |= fs->win[bc % SS(fs)] << 8;    /* Merge 2nd byte of the entry */
+            if (move_window(fs, fs->fatbase + SNUM(fs, bc)) != FR_OK) break;
+            wc = fs->win[SOFS(fs, bc)]; bc++;   /* Get 1st byte of the entry */
+            if (move_window(fs, fs->fatbase + SNUM(fs, bc)) != FR_OK) break;
+            wc |= fs->win[SOFS(fs, bc)] << 8;   /* Merge 2nd byte of the entry */
             val = (clst & 1) ? (wc >> 4) : (wc & 0xFFF);    /* Adjust bit position */
             break;
-
+#endif
+#if FF_FS_FATTYPE & 2
         case FS_FAT16 :
-            if (move_window(fs, fs->fatbase + (clst / (SS(fs) / 2))) != FR_OK) break;
-            val = ld_word(fs->win + clst * 2 % SS(fs));     /* Simple WORD array */
+            if (move_window(fs, fs->fatbase + (clst >> (SSHIFT(fs) - 1))) != FR_OK) break;
+            val = ld_word(fs->win + SOFS(fs, clst * 2));    /* Simple WORD array */
             break;
-
+#endif
+#if FF_FS_FATTYPE & 4
         case FS_FAT32 :
-            if (move_window(fs, fs->fatbase + (clst / (SS(fs) / 4))) != FR_OK) break;
-            val = ld_dword(fs->win + clst * 4 % SS(fs)) & 0x0FFFFFFF;   /* Simple DWORD array but mask out upper 4 bits */
+            if (move_window(fs, fs->fatbase + (clst >> (SSHIFT(fs) - 2))) != FR_OK) break;
+            val = ld_dword(fs->win + SOFS(fs, clst * 4)) & 0x0FFFFFFF;  /* Simple DWORD array but mask out upper 4 bits */
             break;
+#endif
 #if FF_FS_EXFAT
         case FS_EXFAT :
             if ((obj->objsize != 0 && obj->sclust != 0) || obj->stat == 0) {    /* Object except root dir must have valid data length */
                 DWORD cofs = clst - obj->sclust;    /* Offset from start cluster */
-                DWORD clen = (DWORD)((obj->objsize - 1) / SS(fs)) / fs->csize;  /* Number of clusters - 1 */
+                DWORD clen = (DWORD)SNUM(fs, obj->objsize - 1) / fs->csize;     /* Number of clusters - 1 */
 
                 if (obj->stat == 2 && cofs <= clen) {   /* Is it a contiguous chain? */
                     val = (cofs == clen) ? 0x7FFFFFFF : clst + 1;   /* No data on the FAT, generate the value */
@@ -1199,8 +1606,8 @@ static DWORD get_fat (      /* 0xFFFFFFFF:Disk error, 1:Internal error, 2..0x7FF
                     if (obj->n_frag != 0) { /* Is it on the growing edge? */
                         val = 0x7FFFFFFF;   /* Generate EOC */
                     } else {
-                        if (move_window(fs, fs->fatbase + (clst / (SS(fs) / 4))) != FR_OK) break;
-                        val = ld_dword(fs->win + clst * 4 % SS(fs)) & 0x7FFFFFFF;
+                        if (move_window(fs, fs->fatbase + (clst >> (SSHIFT(fs) - 2))) != FR_OK) break;
+                        val = ld_dword(fs->win + SOFS(fs, clst * 4)) & 0x7FFFFFFF;
                     }
                     break;
                 }
@@ -1218,6 +1625,136 @@ static DWORD get_fat (      /* 0xFFFFFFFF:Disk error, 1:Internal error, 2..0x7FF
 
 
 
+#if FF_USE_TRIM && !FF_FS_READONLY
+/*-----------------------------------------------------------------------*/
+/* FAT handling - Discard freed cluster blocks                           */
+/*-----------------------------------------------------------------------*/
+
+static void trim_block (
+    FATFS* fs,  /* Filesystem object */
+    DWORD scl,  /* First cluster of the block */
+    DWORD ecl   /* Last cluster of the block */
+)
+{
+    DWORD rt[2];
+
+
+    rt[0] = clst2sect(fs, scl);                 /* Start of data area freed */
+    rt[1] = clst2sect(fs, ecl) + fs->csize - 1; /* End of data area freed */
+    disk_ioctl(fs->pdrv, CTRL_TRIM, rt);        /* Inform device the data in the block is no longer needed */
+}
+
+
+#if FF_TRIM_QUEUE
+/*-----------------------------------*/
+/* Issue all queued blocks           */
+/*-----------------------------------*/
+
+static FRESULT flush_trim ( /* FR_OK(0):succeeded, !=0:error */
+    FATFS* fs   /* Filesystem object */
+)
+{
+    UINT i, j, n;
+    DWORD scl, ecl;
+
+
+    n = fs->n_trim;
+    if (n == 0) return FR_OK;
+    if (sync_window(fs) != FR_OK) return FR_DISK_ERR;  /* The blocks must be freed on the disk prior to discard */
+
+    for (i = 1; i < n; i++) {   /* Sort the queued blocks in order of cluster number */
+        scl = fs->trimq[i][0]; ecl = fs->trimq[i][1];
+        for (j = i; j > 0 && fs->trimq[j - 1][0] > scl; j--) {
+            fs->trimq[j][0] = fs->trimq[j - 1][0]; fs->trimq[j][1] = fs->trimq[j - 1][1];
+        }
+        fs->trimq[j][0] = scl; fs->trimq[j][1] = ecl;
+    }
+    scl = fs->trimq[0][0]; ecl = fs->trimq[0][1];
+    for (i = 1; i < n; i++) {   /* Issue the blocks with merging adjacent ones */
+        if (fs->trimq[i][0] == ecl + 1) {
+            ecl = fs->trimq[i][1];
+        } else {
+            trim_block(fs, scl, ecl);
+            scl = fs->trimq[i][0]; ecl = fs->trimq[i][1];
+        }
+    }
+    trim_block(fs, scl, ecl);
+    fs->n_trim = 0;
+    return FR_OK;
+}
+
+
+/*-----------------------------------*/
+/* Put a freed block into the queue  */
+/*-----------------------------------*/
+
+static FRESULT queue_trim ( /* FR_OK(0):succeeded, !=0:error */
+    FATFS* fs,  /* Filesystem object */
+    DWORD scl,  /* First cluster of the block */
+    DWORD ecl   /* Last cluster of the block */
+)
+{
+    UINT i;
+    FRESULT res;
+
+
+    for (i = 0; i < fs->n_trim; i++) {  /* Merge it into a queued block if adjacent */
+        if (fs->trimq[i][1] + 1 == scl) {
+            fs->trimq[i][1] = ecl; return FR_OK;
+        }
+        if (ecl + 1 == fs->trimq[i][0]) {
+            fs->trimq[i][0] = scl; return FR_OK;
+        }
+    }
+    if (fs->n_trim == FF_TRIM_QUEUE) {  /* Flush the queue if it is full */
+        res = flush_trim(fs);
+        if (res != FR_OK) return res;
+    }
+    fs->trimq[fs->n_trim][0] = scl; fs->trimq[fs->n_trim][1] = ecl;
+    fs->n_trim++;
+    return FR_OK;
+}
+
+
+/*-----------------------------------*/
+/* Remove re-allocated clusters      */
+/*-----------------------------------*/
+
+static void unqueue_trim (
+    FATFS* fs,  /* Filesystem object */
+    DWORD scl,  /* First cluster allocated */
+    DWORD ncl   /* Number of clusters allocated */
+)
+{
+    UINT i;
+    DWORD ecl = scl + ncl - 1;
+
+
+    for (i = 0; i < fs->n_trim; i++) {
+        if (ecl < fs->trimq[i][0] || scl > fs->trimq[i][1]) continue;   /* Not overlapped? */
+        if (scl <= fs->trimq[i][0] && ecl >= fs->trimq[i][1]) {         /* Whole block re-allocated? */
+            fs->n_trim--;
+            fs->trimq[i][0] = fs->trimq[fs->n_trim][0]; fs->trimq[i][1] = fs->trimq[fs->n_trim][1];
+            i--;
+        } else if (scl <= fs->trimq[i][0]) {    /* Head of the block re-allocated */
+            fs->trimq[i][0] = ecl + 1;
+        } else if (ecl >= fs->trimq[i][1]) {    /* Tail of the block re-allocated */
+            fs->trimq[i][1] = scl - 1;
+        } else {                                /* Middle of the block re-allocated */
+            if (fs->n_trim < FF_TRIM_QUEUE) {   /* Split the block (the tail part is dropped if no room) */
+                fs->trimq[fs->n_trim][0] = ecl + 1; fs->trimq[fs->n_trim][1] = fs->trimq[i][1];
+                fs->n_trim++;
+            }
+            fs->trimq[i][1] = scl - 1;
+        }
+    }
+}
+
+#endif  /* FF_TRIM_QUEUE */
+#endif  /* FF_USE_TRIM && !FF_FS_READONLY */
+
+
+
 #if !FF_FS_READONLY
 /*-----------------------------------------------------------------------*/
 /* FAT access - Change value of a FAT entry                              */
@@ -1229,46 +1766,58 @@ static FRESULT put_fat (    /* FR_OK(0):succeeded, !=0:error */
     DWORD val       /* New value to be set to the entry */
 )
 {
+#if FF_FS_FATTYPE & 1
     UINT bc;
     BYTE *p;
+#endif
     FRESULT res = FR_INT_ERR;
 
 
+    STAT_INC(fs, n_putfat);
     if (clst >= 2 && clst < fs->n_fatent) { /* Check if in valid range */
-        switch (fs->fs_type) {
+#if FF_USE_TRIM && FF_TRIM_QUEUE
+        if (val != 0 && fs->n_trim != 0) unqueue_trim(fs, clst, 1);    /* Cancel discard of the cluster in use */
+#endif
+        switch (FS_TYPE(fs)) {
+#if FF_FS_FATTYPE & 1
         case FS_FAT12 :
             bc = (UINT)clst; bc += bc / 2;  /* bc: byte offset of the entry */
-            res = move_window(fs, fs->fatbase + (bc / SS(fs)));
+            res = move_window(fs, fs->fatbase + SNUM(fs, bc));
             if (res != FR_OK) break;
-            p = fs->win + bc++ % SS(fs);
+            p = fs->win + SOFS(fs, bc); bc++;
             *p = (clst & 1) ? ((*p & 0x0F) | ((BYTE)val << 4)) : (BYTE)val;     /* Put 1st byte */
             fs->wflag = 1;
-            res = move_window(fs, fs->fatbase + (bc / SS(fs)));
+            res = move_window(fs, fs->fatbase + SNUM(fs, bc));
             if (res != FR_OK) break;
-            p = fs->win + bc % SS(fs);
+            p = fs->win + SOFS(fs, bc);
             *p = (clst & 1) ? (BYTE)(val >> 4) : ((*p & 0xF0) | ((BYTE)(val >> 8) & 0x0F)); /* Put 2nd byte */
             fs->wflag = 1;
             break;
-
+#endif
+#if FF_FS_FATTYPE & 2
         case FS_FAT16 :
-            res = move_window(fs, fs->fatbase + (clst / (SS(fs) / 2)));
+            res = move_window(fs, fs->fatbase + (clst >> (SSHIFT(fs) - 1)));
             if (res != FR_OK) break;
-            st_word(fs->win + clst * 2 % SS(fs), (WORD)val);    /* Simple WORD array */
+            st_word(fs->win + SOFS(fs, clst * 2), (WORD)val);   /* Simple WORD array */
             fs->wflag = 1;
             break;
-
+#endif
+#if (FF_FS_FATTYPE & 4) || FF_FS_EXFAT
+#if FF_FS_FATTYPE & 4
         case FS_FAT32 :
+#endif
 #if FF_FS_EXFAT
         case FS_EXFAT :
 #endif
-            res = move_window(fs, fs->fatbase + (clst / (SS(fs) / 4)));
+            res = move_window(fs, fs->fatbase + (clst >> (SSHIFT(fs) - 2)));
             if (res != FR_OK) break;
-            if (!FF_FS_EXFAT || fs->fs_type != FS_EXFAT) {
-                val = (val & 0x0FFFFFFF) | (ld_dword(fs->win + clst * 4 % SS(fs)) & 0xF0000000);
+            if (!FF_FS_EXFAT || FS_TYPE(fs) != FS_EXFAT) {
+                val = (val & 0x0FFFFFFF) | (ld_dword(fs->win + SOFS(fs, clst * 4)) & 0xF0000000);
             }
-            st_dword(fs->win + clst * 4 % SS(fs), val);
+            st_dword(fs->win + SOFS(fs, clst * 4), val);
             fs->wflag = 1;
             break;
+#endif
         }
     }
     return res;
@@ -1291,7 +1840,8 @@ static FRESULT put_fat (    /* FR_OK(0):succeeded, !=0:error */
 static DWORD find_bitmap (  /* 0:Not found, 2..:Cluster block found, 0xFFFFFFFF:Disk error */
     FATFS* fs,  /* Filesystem object */
     DWORD clst, /* Cluster number to scan from */
-    DWORD ncl   /* Number of contiguous clusters to find (1..) */
+    DWORD ncl,  /* Number of contiguous clusters to find (1..) */
+    DWORD ecl   /* Top of the block must be lower than this cluster (0:no limit) */
 )
 {
     BYTE bm, bv;
@@ -1303,11 +1853,12 @@ static DWORD find_bitmap (  /* 0:Not found, 2..:Cluster block found, 0xFFFFFFFF:
     if (clst >= fs->n_fatent - 2) clst = 0;
     scl = val = clst; ctr = 0;
     for (;;) {
-        if (move_window(fs, fs->bitbase + val / 8 / SS(fs)) != FR_OK) return 0xFFFFFFFF;
-        i = val / 8 % SS(fs); bm = 1 << (val % 8);
+        if (move_window(fs, fs->bitbase + SNUM(fs, val / 8)) != FR_OK) return 0xFFFFFFFF;
+        i = SOFS(fs, val / 8); bm = 1 << (val % 8);
         do {
             do {
                 bv = fs->win[i] & bm; bm <<= 1;     /* Get bit value */
+                STAT_INC(fs, n_clprobe);
                 if (++val >= fs->n_fatent - 2) {    /* Next cluster (with wrap-around) */
                     val = 0; bm = 0; i = SS(fs);
                 }
@@ -1315,6 +1866,7 @@ static DWORD find_bitmap (  /* 0:Not found, 2..:Cluster block found, 0xFFFFFFFF:
                     if (++ctr == ncl) return scl + 2;   /* Check if run length is sufficient for required */
                 } else {
                     scl = val; ctr = 0;     /* Encountered a cluster in-use, restart to scan */
+                    if (ecl && scl + 2 >= ecl) return 0;    /* Top of the block reached the limit? */
                 }
                 if (val == clst) return 0;  /* All cluster scanned? */
             } while (bm != 0);
@@ -1340,9 +1892,12 @@ static FRESULT change_bitmap (
     DWORD sect;
 
 
+#if FF_USE_TRIM && FF_TRIM_QUEUE
+    if (bv != 0 && fs->n_trim != 0) unqueue_trim(fs, clst, ncl);  /* Cancel discard of the clusters in use */
+#endif
     clst -= 2;  /* The first bit corresponds to cluster #2 */
-    sect = fs->bitbase + clst / 8 / SS(fs); /* Sector address */
-    i = clst / 8 % SS(fs);                  /* Byte offset in the sector */
+    sect = fs->bitbase + SNUM(fs, clst / 8);    /* Sector address */
+    i = SOFS(fs, clst / 8);                     /* Byte offset in the sector */
     bm = 1 << (clst % 8);                   /* Bit mask in the byte */
     for (;;) {
         if (move_window(fs, sect++) != FR_OK) return FR_DISK_ERR;
@@ -1425,14 +1980,11 @@ static FRESULT remove_chain (   /* FR_OK(0):succeeded, !=0:error */
 #if FF_FS_EXFAT || FF_USE_TRIM
     DWORD scl = clst, ecl = clst;
 #endif
-#if FF_USE_TRIM
-    DWORD rt[2];
-#endif
 
     if (clst < 2 || clst >= fs->n_fatent) return FR_INT_ERR;    /* Check if in valid range */
 
     /* Mark the previous cluster 'EOC' on the FAT if it exists */
-    if (pclst != 0 && (!FF_FS_EXFAT || fs->fs_type != FS_EXFAT || obj->stat != 2)) {
+    if (pclst != 0 && (!FF_FS_EXFAT || FS_TYPE(fs) != FS_EXFAT || obj->stat != 2)) {
         res = put_fat(fs, pclst, 0xFFFFFFFF);
         if (res != FR_OK) return res;
     }
@@ -1443,7 +1995,7 @@ static FRESULT remove_chain (   /* FR_OK(0):succeeded, !=0:error */
         if (nxt == 0) break;                /* Empty cluster? */
         if (nxt == 1) return FR_INT_ERR;    /* Internal error? */
         if (nxt == 0xFFFFFFFF) return FR_DISK_ERR;  /* Disk error? */
-        if (!FF_FS_EXFAT || fs->fs_type != FS_EXFAT) {
+        if (!FF_FS_EXFAT || FS_TYPE(fs) != FS_EXFAT) {
             res = put_fat(fs, clst, 0);     /* Mark the cluster 'free' on the FAT */
             if (res != FR_OK) return res;
         }
@@ -1456,15 +2008,16 @@ static FRESULT remove_chain (   /* FR_OK(0):succeeded, !=0:error */
             ecl = nxt;
         } else {                /* End of contiguous cluster block */
 #if FF_FS_EXFAT
-            if (fs->fs_type == FS_EXFAT) {
+            if (FS_TYPE(fs) == FS_EXFAT) {
                 res = change_bitmap(fs, scl, ecl - scl + 1, 0); /* Mark the cluster block 'free' on the bitmap */
                 if (res != FR_OK) return res;
             }
 #endif
-#if FF_USE_TRIM
-            rt[0] = clst2sect(fs, scl);                 /* Start of data area freed */
-            rt[1] = clst2sect(fs, ecl) + fs->csize - 1; /* End of data area freed */
-            disk_ioctl(fs->pdrv, CTRL_TRIM, rt);        /* Inform device the data in the block is no longer needed */
+#if FF_USE_TRIM && FF_TRIM_QUEUE
+            res = queue_trim(fs, scl, ecl);     /* Queue the block to be discarded later */
+            if (res != FR_OK) return res;
+#elif FF_USE_TRIM
+            trim_block(fs, scl, ecl);           /* Discard the block now */
 #endif
             scl = ecl = nxt;
         }
@@ -1474,7 +2027,7 @@ static FRESULT remove_chain (   /* FR_OK(0):succeeded, !=0:error */
 
 #if FF_FS_EXFAT
     /* Some post processes for chain status */
-    if (fs->fs_type == FS_EXFAT) {
+    if (FS_TYPE(fs) == FS_EXFAT) {
         if (pclst == 0) {   /* Has the entire chain been removed? */
             obj->stat = 0;      /* Change the chain status 'initial' */
         } else {
@@ -1532,8 +2085,8 @@ static DWORD create_chain ( /* 0:No free cluster, 1:Internal error, 0xFFFFFFFF:D
     if (fs->free_clst == 0) return 0;       /* No free cluster */
 
 #if FF_FS_EXFAT
-    if (fs->fs_type == FS_EXFAT) {  /* On the exFAT volume */
-        ncl = find_bitmap(fs, scl, 1);              /* Find a free cluster */
+    if (FS_TYPE(fs) == FS_EXFAT) {  /* On the exFAT volume */
+        ncl = find_bitmap(fs, scl, 1, 0);           /* Find a free cluster */
         if (ncl == 0 || ncl == 0xFFFFFFFF) return ncl;  /* No free cluster or hard error? */
         res = change_bitmap(fs, ncl, 1, 1);         /* Mark the cluster 'in use' */
         if (res == FR_INT_ERR) return 1;
@@ -1562,6 +2115,7 @@ static DWORD create_chain ( /* 0:No free cluster, 1:Internal error, 0xFFFFFFFF:D
         if (scl == clst) {                      /* Stretching an existing chain? */
             ncl = scl + 1;                      /* Test if next cluster is free */
             if (ncl >= fs->n_fatent) ncl = 2;
+            STAT_INC(fs, n_clprobe);
             cs = get_fat(obj, ncl);             /* Get next cluster status */
             if (cs == 1 || cs == 0xFFFFFFFF) return cs; /* Test for error */
             if (cs != 0) {                      /* Not free? */
@@ -1578,6 +2132,7 @@ static DWORD create_chain ( /* 0:No free cluster, 1:Internal error, 0xFFFFFFFF:D
                     ncl = 2;
                     if (ncl > scl) return 0;    /* No free cluster found? */
                 }
+                STAT_INC(fs, n_clprobe);
                 cs = get_fat(obj, ncl);         /* Get the cluster status */
                 if (cs == 0) break;             /* Found a free cluster? */
                 if (cs == 1 || cs == 0xFFFFFFFF) return cs; /* Test for error */
@@ -1621,7 +2176,7 @@ static DWORD clmt_clust (   /* <2:Error, >=2:Cluster number */
 
 
     tbl = fp->cltbl + 1;    /* Top of CLMT */
-    cl = (DWORD)(ofs / SS(fs) / fs->csize); /* Cluster order from top of the file */
+    cl = (DWORD)(SNUM(fs, ofs) / fs->csize);    /* Cluster order from top of the file */
     for (;;) {
         ncl = *tbl++;           /* Number of cluters in the fragment */
         if (ncl == 0) return 0; /* End of table? (error) */
@@ -1661,13 +2216,13 @@ static FRESULT dir_clear (  /* Returns FR_OK or FR_DISK_ERR */
     if (szb > SS(fs)) {     /* Buffer allocated? */
         mem_set(ibuf, 0, szb);
         szb /= SS(fs);      /* Bytes -> Sectors */
-        for (n = 0; n < fs->csize && disk_write(fs->pdrv, ibuf, sect + n, szb) == RES_OK; n += szb) ;   /* Fill the cluster with 0 */
+        for (n = 0; n < fs->csize && DISK_WRITE(fs, ibuf, sect + n, szb) == RES_OK; n += szb) ;   /* Fill the cluster with 0 */
         ff_memfree(ibuf);
     } else
 #endif
     {
         ibuf = fs->win; szb = 1;    /* Use window buffer (many single-sector writes may take a time) */
-        for (n = 0; n < fs->csize && disk_write(fs->pdrv, ibuf, sect + n, szb) == RES_OK; n += szb) ;   /* Fill the cluster with 0 */
+        for (n = 0; n < fs->csize && DISK_WRITE(fs, ibuf, sect + n, szb) == RES_OK; n += szb) ;   /* Fill the cluster with 0 */
     }
     return (n == fs->csize) ? FR_OK : FR_DISK_ERR;
 }
@@ -1689,12 +2244,12 @@ static FRESULT dir_sdi (    /* FR_OK(0):succeeded, !=0:error */
     FATFS *fs = dp->obj.fs;
 
 
-    if (ofs >= (DWORD)((FF_FS_EXFAT && fs->fs_type == FS_EXFAT) ? MAX_DIR_EX : MAX_DIR) || ofs % SZDIRE) {  /* Check range of offset and alignment */
+    if (ofs >= (DWORD)((FF_FS_EXFAT && FS_TYPE(fs) == FS_EXFAT) ? MAX_DIR_EX : MAX_DIR) || ofs % SZDIRE) {  /* Check range of offset and alignment */
         return FR_INT_ERR;
     }
     dp->dptr = ofs;             /* Set current offset */
     clst = dp->obj.sclust;      /* Table start cluster (0:root) */
-    if (clst == 0 && fs->fs_type >= FS_FAT32) { /* Replace cluster# 0 with root cluster# */
+    if (clst == 0 && FS_TYPE(fs) >= FS_FAT32) { /* Replace cluster# 0 with root cluster# */
         clst = fs->dirbase;
         if (FF_FS_EXFAT) dp->obj.stat = 0;  /* exFAT: Root dir has an FAT chain */
     }
@@ -1715,8 +2270,8 @@ static FRESULT dir_sdi (    /* FR_OK(0):succeeded, !=0:error */
     }
     dp->clust = clst;                   /* Current cluster# */
     if (dp->sect == 0) return FR_INT_ERR;
-    dp->sect += ofs / SS(fs);           /* Sector# of the directory entry */
-    dp->dir = fs->win + (ofs % SS(fs)); /* Pointer to the entry in the win[] */
+    dp->sect += SNUM(fs, ofs);          /* Sector# of the directory entry */
+    dp->dir = fs->win + SOFS(fs, ofs);  /* Pointer to the entry in the win[] */
 
     return FR_OK;
 }
@@ -1738,10 +2293,10 @@ static FRESULT dir_next (   /* FR_OK(0):succeeded, FR_NO_FILE:End of table, FR_D
 
 
     ofs = dp->dptr + SZDIRE;    /* Next entry */
-    if (ofs >= (DWORD)((FF_FS_EXFAT && fs->fs_type == FS_EXFAT) ? MAX_DIR_EX : MAX_DIR)) dp->sect = 0;  /* Disable it if the offset reached the max value */
+    if (ofs >= (DWORD)((FF_FS_EXFAT && FS_TYPE(fs) == FS_EXFAT) ? MAX_DIR_EX : MAX_DIR)) dp->sect = 0;  /* Disable it if the offset reached the max value */
     if (dp->sect == 0) return FR_NO_FILE;   /* Report EOT if it has been disabled */
 
-    if (ofs % SS(fs) == 0) {    /* Sector changed? */
+    if (SOFS(fs, ofs) == 0) {   /* Sector changed? */
         dp->sect++;             /* Next sector */
 
         if (dp->clust == 0) {   /* Static table */
@@ -1750,7 +2305,7 @@ static FRESULT dir_next (   /* FR_OK(0):succeeded, FR_NO_FILE:End of table, FR_D
             }
         }
         else {                  /* Dynamic table */
-            if ((ofs / SS(fs) & (fs->csize - 1)) == 0) {    /* Cluster changed? */
+            if ((SNUM(fs, ofs) & (fs->csize - 1)) == 0) {   /* Cluster changed? */
                 clst = get_fat(&dp->obj, dp->clust);        /* Get next cluster */
                 if (clst <= 1) return FR_INT_ERR;           /* Internal error */
                 if (clst == 0xFFFFFFFF) return FR_DISK_ERR; /* Disk error */
@@ -1776,7 +2331,7 @@ static FRESULT dir_next (   /* FR_OK(0):succeeded, FR_NO_FILE:End of table, FR_D
         }
     }
     dp->dptr = ofs;                     /* Current entry */
-    dp->dir = fs->win + ofs % SS(fs);   /* Pointer to the entry in the win[] */
+    dp->dir = fs->win + SOFS(fs, ofs);  /* Pointer to the entry in the win[] */
 
     return FR_OK;
 }
@@ -1806,7 +2361,7 @@ static FRESULT dir_alloc (  /* FR_OK(0):succeeded, !=0:error */
             res = move_window(fs, dp->sect);
             if (res != FR_OK) break;
 #if FF_FS_EXFAT
-            if ((fs->fs_type == FS_EXFAT) ? (int)((dp->dir[XDIR_Type] & 0x80) == 0) : (int)(dp->dir[DIR_Name] == DDEM || dp->dir[DIR_Name] == 0)) {
+            if ((FS_TYPE(fs) == FS_EXFAT) ? (int)((dp->dir[XDIR_Type] & 0x80) == 0) : (int)(dp->dir[DIR_Name] == DDEM || dp->dir[DIR_Name] == 0)) {
 #else
             if (dp->dir[DIR_Name] == DDEM || dp->dir[DIR_Name] == 0) {
 #endif
@@ -1838,8 +2393,9 @@ static DWORD ld_clust ( /* Returns the top cluster value of the SFN entry */
 {
     DWORD cl;
 
+    (void)fs;   /* (unused when the FAT sub-type is fixed) */
     cl = ld_word(dir + DIR_FstClusLO);
-    if (fs->fs_type == FS_FAT32) {
+    if (FS_TYPE(fs) == FS_FAT32) {
         cl |= (DWORD)ld_word(dir + DIR_FstClusHI) << 16;
     }
 
@@ -1854,8 +2410,9 @@ static void st_clust (
     DWORD cl    /* Value to be set */
 )
 {
+    (void)fs;   /* (unused when the FAT sub-type is fixed) */
     st_word(dir + DIR_FstClusLO, (WORD)cl);
-    if (fs->fs_type == FS_FAT32) {
+    if (FS_TYPE(fs) == FS_FAT32) {
         st_word(dir + DIR_FstClusHI, (WORD)(cl >> 16));
     }
 }
@@ -1884,7 +2441,9 @@ static int cmp_lfn (        /* 1:matched, 0:not matched */
     for (wc = 1, s = 0; s < 13; s++) {      /* Process all characters in the entry */
         uc = ld_word(dir + LfnOfs[s]);      /* Pick an LFN character */
         if (wc != 0) {
-            if (i >= FF_MAX_LFN || ff_wtoupper(uc) != ff_wtoupper(lfnbuf[i++])) {   /* Compare it */
+            if (i >= FF_MAX_LFN) return 0;  /* Not matched (too long name) */
+            wc = lfnbuf[i++];
+            if (uc != wc && ff_wtoupper(uc) != ff_wtoupper(wc)) {   /* Compare it (up-case conversion only if different) */
                 return 0;                   /* Not matched */
             }
             wc = uc;
@@ -2059,22 +2618,30 @@ static BYTE sum_sfn (
 /* exFAT: Checksum                                                       */
 /*-----------------------------------------------------------------------*/
 
+static WORD xsum16 (    /* Returns 16-bit checksum */
+    const BYTE* dat,    /* Pointer to the data block to be calculated */
+    UINT cnt,           /* Number of bytes to be calculated */
+    WORD sum            /* Previous sum value */
+)
+{
+    while (cnt--) {
+        sum = (WORD)((sum >> 1 | (WORD)(sum << 15)) + *dat++);  /* Rotate right and add a byte */
+    }
+    return sum;
+}
+
+
 static WORD xdir_sum (  /* Get checksum of the directoly entry block */
     const BYTE* dir     /* Directory entry block to be calculated */
 )
 {
-    UINT i, szblk;
+    UINT szblk;
     WORD sum;
 
 
     szblk = (dir[XDIR_NumSec] + 1) * SZDIRE;    /* Number of bytes of the entry block */
-    for (i = sum = 0; i < szblk; i++) {
-        if (i == XDIR_SetSum) { /* Skip 2-byte sum field */
-            i++;
-        } else {
-            sum = ((sum & 1) ? 0x8000 : 0) + (sum >> 1) + dir[i];
-        }
-    }
+    sum = xsum16(dir, XDIR_SetSum, 0);          /* Sum the block but 2-byte sum field */
+    sum = xsum16(dir + XDIR_SetSum + 2, szblk - XDIR_SetSum - 2, sum);
     return sum;
 }
 
@@ -2089,9 +2656,13 @@ static WORD xname_sum ( /* Get check sum (to be used as hash) of the file name *
 
 
     while ((chr = *name++) != 0) {
-        chr = (WCHAR)ff_wtoupper(chr);      /* File name needs to be up-case converted */
-        sum = ((sum & 1) ? 0x8000 : 0) + (sum >> 1) + (chr & 0xFF);
-        sum = ((sum & 1) ? 0x8000 : 0) + (sum >> 1) + (chr >> 8);
+        if (chr < 0x80) {   /* File name needs to be up-case converted */
+            if (IsLower(chr)) chr -= 0x20;
+        } else {
+            chr = (WCHAR)ff_wtoupper(chr);
+        }
+        sum = (WORD)((sum >> 1 | (WORD)(sum << 15)) + (chr & 0xFF));
+        sum = (WORD)((sum >> 1 | (WORD)(sum << 15)) + (chr >> 8));
     }
     return sum;
 }
@@ -2099,11 +2670,14 @@ static WORD xname_sum ( /* Get check sum (to be used as hash) of the file name *
 
 #if !FF_FS_READONLY && FF_USE_MKFS
 static DWORD xsum32 (   /* Returns 32-bit checksum */
-    BYTE  dat,          /* Byte to be calculated (byte-by-byte processing) */
+    const BYTE* dat,    /* Pointer to the data block to be calculated */
+    UINT cnt,           /* Number of bytes to be calculated */
     DWORD sum           /* Previous sum value */
 )
 {
-    sum = ((sum & 1) ? 0x80000000 : 0) + (sum >> 1) + dat;
+    while (cnt--) {
+        sum = (sum >> 1 | sum << 31) + *dat++;  /* Rotate right and add a byte */
+    }
     return sum;
 }
 #endif
@@ -2351,7 +2925,7 @@ static FRESULT dir_read (
             res = FR_NO_FILE; break; /* Reached to end of the directory */
         }
 #if FF_FS_EXFAT
-        if (fs->fs_type == FS_EXFAT) {  /* On the exFAT volume */
+        if (FS_TYPE(fs) == FS_EXFAT) {  /* On the exFAT volume */
             if (FF_USE_LABEL && vol) {
                 if (b == ET_VLABEL) break;  /* Volume label entry? */
             } else {
@@ -2417,18 +2991,20 @@ static FRESULT dir_find (   /* FR_OK(0):succeeded, !=0:error */
     FATFS *fs = dp->obj.fs;
     BYTE c;
 #if FF_USE_LFN
-    BYTE a, ord, sum;
+    BYTE a, ord, sum, nord;
+    UINT n;
 #endif
 
     res = dir_sdi(dp, 0);           /* Rewind directory object */
     if (res != FR_OK) return res;
 #if FF_FS_EXFAT
-    if (fs->fs_type == FS_EXFAT) {  /* On the exFAT volume */
+    if (FS_TYPE(fs) == FS_EXFAT) {  /* On the exFAT volume */
         BYTE nc;
         UINT di, ni;
         WORD hash = xname_sum(fs->lfnbuf);      /* Hash value of the name to find */
 
         while ((res = DIR_READ_FILE(dp)) == FR_OK) {    /* Read an item */
+            STAT_ADD(fs, n_dirscan, fs->dirbuf[XDIR_NumSec] + 1);
 #if FF_MAX_LFN < 255
             if (fs->dirbuf[XDIR_NumName] > FF_MAX_LFN) continue;            /* Skip comparison if inaccessible object name */
 #endif
@@ -2444,11 +3020,14 @@ static FRESULT dir_find (   /* FR_OK(0):succeeded, !=0:error */
 #endif
     /* On the FAT/FAT32 volume */
 #if FF_USE_LFN
+    for (n = 0; fs->lfnbuf[n]; n++) ;   /* Number of LFN entries needed for the name to find */
+    nord = (BYTE)((n + 12) / 13);
     ord = sum = 0xFF; dp->blk_ofs = 0xFFFFFFFF; /* Reset LFN sequence */
 #endif
     do {
         res = move_window(fs, dp->sect);
         if (res != FR_OK) break;
+        STAT_INC(fs, n_dirscan);
         c = dp->dir[DIR_Name];
         if (c == 0) { res = FR_NO_FILE; break; }    /* Reached to end of table */
 #if FF_USE_LFN      /* LFN configuration */
@@ -2462,6 +3041,7 @@ static FRESULT dir_find (   /* FR_OK(0):succeeded, !=0:error */
                         sum = dp->dir[LDIR_Chksum];
                         c &= (BYTE)~LLEF; ord = c;  /* LFN start order */
                         dp->blk_ofs = dp->dptr; /* Start offset of LFN */
+                        if (c != nord) ord = 0xFF;  /* Skip comparison of the LFN sequence if the name length mismatched */
                     }
                     /* Check validity of the LFN entry and compare it with given name */
                     ord = (c == ord && sum == dp->dir[LDIR_Chksum] && cmp_lfn(fs->lfnbuf, dp->dir)) ? ord - 1 : 0xFF;
@@ -2476,6 +3056,10 @@ static FRESULT dir_find (   /* FR_OK(0):succeeded, !=0:error */
         dp->obj.attr = dp->dir[DIR_Attr] & AM_MASK;
         if (!(dp->dir[DIR_Attr] & AM_VOL) && !mem_cmp(dp->dir, dp->fn, 11)) break;  /* Is it a valid entry? */
 #endif
+        if (dp->sect != 0 && SOFS(fs, dp->dptr + SZDIRE) != 0) {   /* Next entry in the same sector? */
+            dp->dptr += SZDIRE; dp->dir += SZDIRE;
+            continue;
+        }
         res = dir_next(dp, 0);  /* Next entry */
     } while (res == FR_OK);
 
@@ -2505,7 +3089,7 @@ static FRESULT dir_register (   /* FR_OK:succeeded, FR_DENIED:no free entry or t
     for (nlen = 0; fs->lfnbuf[nlen]; nlen++) ;  /* Get lfn length */
 
 #if FF_FS_EXFAT
-    if (fs->fs_type == FS_EXFAT) {  /* On the exFAT volume */
+    if (FS_TYPE(fs) == FS_EXFAT) {  /* On the exFAT volume */
         nent = (nlen + 14) / 15 + 2;    /* Number of entries to allocate (85+C0+C1s) */
         res = dir_alloc(dp, nent);      /* Allocate directory entries */
         if (res != FR_OK) return res;
@@ -2610,7 +3194,7 @@ static FRESULT dir_remove ( /* FR_OK:Succeeded, FR_DISK_ERR:A disk error */
         do {
             res = move_window(fs, dp->sect);
             if (res != FR_OK) break;
-            if (FF_FS_EXFAT && fs->fs_type == FS_EXFAT) {   /* On the exFAT volume */
+            if (FF_FS_EXFAT && FS_TYPE(fs) == FS_EXFAT) {   /* On the exFAT volume */
                 dp->dir[XDIR_Type] &= 0x7F; /* Clear the entry InUse flag. */
             } else {                                    /* On the FAT/FAT32 volume */
                 dp->dir[DIR_Name] = DDEM;   /* Mark the entry 'deleted'. */
@@ -2661,7 +3245,7 @@ static void get_fileinfo (
 
 #if FF_USE_LFN      /* LFN configuration */
 #if FF_FS_EXFAT
-    if (fs->fs_type == FS_EXFAT) {  /* On the exFAT volume */
+    if (FS_TYPE(fs) == FS_EXFAT) {  /* On the exFAT volume */
         get_xfileinfo(fs->dirbuf, fno);
         return;
     } else
@@ -2840,6 +3424,12 @@ static FRESULT create_name (    /* FR_OK: successful, FR_INVALID_NAME: could not
     /* Create LFN into LFN working buffer */
     p = *path; lfn = dp->obj.fs->lfnbuf; di = 0;
     for (;;) {
+        for (;;) {      /* Store a run of plain ASCII characters without decoding */
+            uc = (DWORD)*p;
+            if (!IsLfnChr(uc)) break;
+            if (di >= FF_MAX_LFN) return FR_INVALID_NAME;   /* Reject too long name */
+            lfn[di++] = (WCHAR)uc; p++;
+        }
         uc = tchar2uni(&p);         /* Get a character */
         if (uc == 0xFFFFFFFF) return FR_INVALID_NAME;       /* Invalid code or UTF decode error */
         if (uc >= 0x10000) lfn[di++] = (WCHAR)(uc >> 16);   /* Store high surrogate if needed */
@@ -3043,7 +3633,7 @@ static FRESULT follow_path (    /* FR_OK(0): successful, !=0: error code */
 #if FF_FS_EXFAT
     dp->obj.n_frag = 0; /* Invalidate last fragment counter of the object */
 #if FF_FS_RPATH != 0
-    if (fs->fs_type == FS_EXFAT && dp->obj.sclust) {    /* exFAT: Retrieve the sub-directory's status */
+    if (FS_TYPE(fs) == FS_EXFAT && dp->obj.sclust) {    /* exFAT: Retrieve the sub-directory's status */
         DIR dj;
 
         dp->obj.c_scl = fs->cdc_scl;
@@ -3085,7 +3675,7 @@ static FRESULT follow_path (    /* FR_OK(0): successful, !=0: error code */
                 res = FR_NO_PATH; break;
             }
 #if FF_FS_EXFAT
-            if (fs->fs_type == FS_EXFAT) {      /* Save containing directory information for next dir */
+            if (FS_TYPE(fs) == FS_EXFAT) {      /* Save containing directory information for next dir */
                 dp->obj.c_scl = dp->obj.sclust;
                 dp->obj.c_size = ((DWORD)dp->obj.objsize & 0xFFFFFF00) | dp->obj.stat;
                 dp->obj.c_ofs = dp->blk_ofs;
@@ -3093,7 +3683,7 @@ static FRESULT follow_path (    /* FR_OK(0): successful, !=0: error code */
             } else
 #endif
             {
-                dp->obj.sclust = ld_clust(fs, fs->win + dp->dptr % SS(fs)); /* Open next directory */
+                dp->obj.sclust = ld_clust(fs, fs->win + SOFS(fs, dp->dptr));    /* Open next directory */
             }
         }
     }
@@ -3252,6 +3842,9 @@ static FRESULT find_volume (    /* FR_OK(0): successful, !=0: an error occurred
     /* Following code attempts to mount the volume. (analyze BPB and initialize the filesystem object) */
 
     fs->fs_type = 0;                    /* Clear the filesystem object */
+#if FF_USE_STATS
+    mem_set(&fs->stats, 0, sizeof fs->stats);   /* Clear the volume statistics */
+#endif
     fs->pdrv = LD2PD(vol);              /* Bind the logical drive and a physical drive */
     stat = disk_initialize(fs->pdrv);   /* Initialize the physical drive */
     if (stat & STA_NOINIT) {            /* Check if the initialization succeeded */
@@ -3263,6 +3856,7 @@ static FRESULT find_volume (    /* FR_OK(0): successful, !=0: an error occurred
 #if FF_MAX_SS != FF_MIN_SS              /* Get sector size (multiple sector size cfg only) */
     if (disk_ioctl(fs->pdrv, GET_SECTOR_SIZE, &SS(fs)) != RES_OK) return FR_DISK_ERR;
     if (SS(fs) > FF_MAX_SS || SS(fs) < FF_MIN_SS || (SS(fs) & (SS(fs) - 1))) return FR_DISK_ERR;
+    for (fs->ssshift = 0, i = SS(fs); i >>= 1; fs->ssshift++) ;   /* Log2 of sector size */
 #endif
 
     /* Find an FAT partition on the drive. Supports only generic partitioning rules, FDISK (MBR) and SFD (w/o partition). */
@@ -3381,6 +3975,7 @@ static FRESULT find_volume (    /* FR_OK(0): successful, !=0: an error occurred
         if (nclst <= MAX_FAT16) fmt = FS_FAT16;
         if (nclst <= MAX_FAT12) fmt = FS_FAT12;
         if (fmt == 0) return FR_NO_FILESYSTEM;
+        if (!(FF_FS_FATTYPE & 1 << (fmt - 1))) return FR_NO_FILESYSTEM; /* (FAT sub-type not supported in this configuration) */
 
         /* Boundaries and Limits */
         fs->n_fatent = nclst + 2;                       /* Number of FAT entries */
@@ -3437,6 +4032,15 @@ static FRESULT find_volume (    /* FR_OK(0): successful, !=0: an error occurred
 #if FF_FS_RPATH != 0
     fs->cdir = 0;           /* Initialize current directory */
 #endif
+#if !FF_FS_TINY && FF_FS_BUFPOOL
+    mem_set(fs->pown, 0, sizeof fs->pown);  /* Release all pool buffers */
+#if FF_USE_MAPREAD
+    mem_set(fs->ppin, 0, sizeof fs->ppin);
+#endif
+#endif
+#if FF_USE_TRIM && FF_TRIM_QUEUE && !FF_FS_READONLY
+    fs->n_trim = 0;         /* Clear discard queue */
+#endif
 #if FF_FS_LOCK != 0         /* Clear file lock semaphores */
     clear_lock(fs);
 #endif
@@ -3504,11 +4108,12 @@ FRESULT f_mount (
     int vol;
     FRESULT res;
     const TCHAR *rp = path;
+    DEF_TRACE(FTO_MOUNT)
 
 
     /* Get logical drive number */
     vol = get_ldnumber(&rp);
-    if (vol < 0) return FR_INVALID_DRIVE;
+    if (vol < 0) EXIT_FF(FR_INVALID_DRIVE);
     cfs = FatFs[vol];                   /* Pointer to fs object */
 
     if (cfs) {
@@ -3516,7 +4121,7 @@ FRESULT f_mount (
         clear_lock(cfs);
 #endif
 #if FF_FS_REENTRANT                     /* Discard sync object of the current volume */
-        if (!ff_del_syncobj(cfs->sobj)) return FR_INT_ERR;
+        if (!ff_del_syncobj(cfs->sobj)) EXIT_FF(FR_INT_ERR);
 #endif
         cfs->fs_type = 0;               /* Clear old fs object */
     }
@@ -3524,12 +4129,12 @@ FRESULT f_mount (
     if (fs) {
         fs->fs_type = 0;                /* Clear new fs object */
 #if FF_FS_REENTRANT                     /* Create sync object for the new volume */
-        if (!ff_cre_syncobj((BYTE)vol, &fs->sobj)) return FR_INT_ERR;
+        if (!ff_cre_syncobj((BYTE)vol, &fs->sobj)) EXIT_FF(FR_INT_ERR);
 #endif
     }
     FatFs[vol] = fs;                    /* Register new fs object */
 
-    if (opt == 0) return FR_OK;         /* Do not mount now, it will be mounted later */
+    if (opt == 0) EXIT_FF(FR_OK);      /* Do not mount now, it will be mounted later */
 
     res = find_volume(&path, &fs, 0);   /* Force mounted the volume */
     LEAVE_FF(fs, res);
@@ -3556,9 +4161,10 @@ FRESULT f_open (
     FSIZE_t ofs;
 #endif
     DEF_NAMBUF
+    DEF_TRACE(FTO_OPEN)
 
 
-    if (!fp) return FR_INVALID_OBJECT;
+    if (!fp) EXIT_FF(FR_INVALID_OBJECT);
 
     /* Get logical drive number */
     mode &= FF_FS_READONLY ? FA_READ : FA_READ | FA_WRITE | FA_CREATE_ALWAYS | FA_CREATE_NEW | FA_OPEN_ALWAYS | FA_OPEN_APPEND;
@@ -3599,7 +4205,7 @@ FRESULT f_open (
             }
             if (res == FR_OK && (mode & FA_CREATE_ALWAYS)) {    /* Truncate the file if overwrite mode */
 #if FF_FS_EXFAT
-                if (fs->fs_type == FS_EXFAT) {
+                if (FS_TYPE(fs) == FS_EXFAT) {
                     /* Get current allocation info */
                     fp->obj.fs = fs;
                     init_alloc_info(fs, &fp->obj);
@@ -3669,7 +4275,7 @@ FRESULT f_open (
 
         if (res == FR_OK) {
 #if FF_FS_EXFAT
-            if (fs->fs_type == FS_EXFAT) {
+            if (FS_TYPE(fs) == FS_EXFAT) {
                 fp->obj.c_scl = dj.obj.sclust;                          /* Get containing directory info */
                 fp->obj.c_size = ((DWORD)dj.obj.objsize & 0xFFFFFF00) | dj.obj.stat;
                 fp->obj.c_ofs = dj.blk_ofs;
@@ -3689,8 +4295,11 @@ FRESULT f_open (
             fp->err = 0;            /* Clear error flag */
             fp->sect = 0;           /* Invalidate current data sector */
             fp->fptr = 0;           /* Set file pointer top of the file */
+#if !FF_FS_TINY && FF_FS_BUFPOOL
+            fbuf_free(fp);          /* No buffer is assigned until the first access */
+#endif
 #if !FF_FS_READONLY
-#if !FF_FS_TINY
+#if !FF_FS_TINY && !FF_FS_BUFPOOL
             mem_set(fp->buf, 0, sizeof fp->buf);    /* Clear sector buffer */
 #endif
             if ((mode & FA_SEEKEND) && fp->obj.objsize > 0) {   /* Seek to end of file if FA_OPEN_APPEND is specified */
@@ -3703,13 +4312,13 @@ FRESULT f_open (
                     if (clst == 0xFFFFFFFF) res = FR_DISK_ERR;
                 }
                 fp->clust = clst;
-                if (res == FR_OK && ofs % SS(fs)) { /* Fill sector buffer if not on the sector boundary */
+                if (res == FR_OK && SOFS(fs, ofs)) {    /* Fill sector buffer if not on the sector boundary */
                     if ((sc = clst2sect(fs, clst)) == 0) {
                         res = FR_INT_ERR;
                     } else {
-                        fp->sect = sc + (DWORD)(ofs / SS(fs));
-#if !FF_FS_TINY
-                        if (disk_read(fs->pdrv, fp->buf, fp->sect, 1) != RES_OK) res = FR_DISK_ERR;
+                        fp->sect = sc + (DWORD)SNUM(fs, ofs);
+#if !FF_FS_TINY && !FF_FS_BUFPOOL   /* (the pool buffer is loaded on the first access) */
+                        if (DISK_READ(fs, fp->buf, fp->sect, 1) != RES_OK) res = FR_DISK_ERR;
 #endif
                     }
                 }
@@ -3728,36 +4337,155 @@ FRESULT f_open (
 
 
 
+#if FF_DISK_NSEG
+/*-----------------------------------------------------------------------*/
+/* Transfer File Data over Cluster Fragments in a Command                */
+/*-----------------------------------------------------------------------*/
+
+static FRESULT xfer_frags ( /* FR_OK(0):succeeded, !=0:hard error */
+    FIL* fp,        /* Pointer to the file object (fp->clust is the current cluster) */
+    BYTE* buff,     /* Pointer to the data buffer */
+    DWORD sect,     /* Sector to start the transfer */
+    UINT csect,     /* Sector offset of sect in the current cluster */
+    UINT* cc,       /* Number of sectors to transfer (in) and transferred (out) */
+    int wr          /* 0:read, 1:write */
+)
+{
+    FRESULT res = FR_OK;
+    FATFS *fs = fp->obj.fs;
+    FSIZE_t osz = fp->obj.objsize;
+    DSEG seg[FF_DISK_NSEG];
+    DWORD clst, nxt;
+    UINT n, i, tc, rc;
+    DRESULT dr;
+
+
+    clst = fp->clust;
+    seg[0].buff = buff; seg[0].sector = sect;
+    seg[0].count = tc = fs->csize - csect;      /* Rest of the current cluster */
+    n = 1;
+    while (tc < *cc) {  /* Gather the following clusters into the scatter list */
+        if (wr && fp->fptr + (FSIZE_t)tc * SS(fs) > fp->obj.objsize) {
+            fp->obj.objsize = fp->fptr + (FSIZE_t)tc * SS(fs);  /* Gathered clusters are in the object (needed to follow the contiguous chain at exFAT) */
+        }
+#if FF_USE_FASTSEEK
+        if (fp->cltbl) {
+            nxt = clmt_clust(fp, fp->fptr + (FSIZE_t)tc * SS(fs));  /* Get cluster# from the CLMT */
+        } else
+#endif
+        {
+#if !FF_FS_READONLY
+            if (wr) {
+                if (n == FF_DISK_NSEG) break;   /* Do not stretch the chain beyond the list */
+                nxt = create_chain(&fp->obj, clst);     /* Follow or stretch cluster chain on the FAT */
+            } else
+#endif
+            {
+                nxt = get_fat(&fp->obj, clst);  /* Follow cluster chain on the FAT */
+            }
+        }
+        if (nxt == 0 && wr) break;      /* Could not allocate a new cluster (disk full) */
+        if (nxt < 2) { res = FR_INT_ERR; break; }
+        if (nxt == 0xFFFFFFFF) { res = FR_DISK_ERR; break; }
+        sect = clst2sect(fs, nxt);
+        if (sect == 0) { res = FR_INT_ERR; break; }
+        rc = (*cc - tc < fs->csize) ? *cc - tc : fs->csize;    /* Sectors to transfer in this cluster */
+        if (sect != seg[n - 1].sector + seg[n - 1].count) { /* Not contiguous to the previous block? */
+            if (n == FF_DISK_NSEG) break;       /* The list is full */
+            seg[n].buff = buff + tc * SS(fs); seg[n].sector = sect; seg[n].count = 0;
+            n++;
+        }
+        seg[n - 1].count += rc;
+        tc += rc;
+        clst = nxt;
+    }
+    fp->obj.objsize = osz;  /* Data length is updated by the caller as the data is written */
+    if (res != FR_OK) return res;
+
+    if (n == 1) {       /* Single block (contiguous clusters) */
+#if !FF_FS_READONLY
+        if (wr) {
+            dr = DISK_WRITE(fs, seg[0].buff, seg[0].sector, seg[0].count);
+        } else
+#endif
+        {
+            dr = DISK_READ(fs, seg[0].buff, seg[0].sector, seg[0].count);
+        }
+    } else {
+#if !FF_FS_READONLY
+        if (wr) {
+            dr = DISK_WRITEV(fs, seg, n, tc);
+        } else
+#endif
+        {
+            dr = DISK_READV(fs, seg, n, tc);
+        }
+    }
+    if (dr != RES_OK) return FR_DISK_ERR;
+
+    for (i = 0; i < n; i++) {   /* Keep the sector cache coherent with the transferred blocks */
+#if !FF_FS_READONLY && FF_FS_MINIMIZE <= 2
+        if (wr) {
+#if FF_FS_TINY
+            if (fs->winsect - seg[i].sector < seg[i].count) {   /* Refill sector cache if it gets invalidated by the direct write */
+                mem_cpy(fs->win, seg[i].buff + ((fs->winsect - seg[i].sector) * SS(fs)), SS(fs));
+                fs->wflag = 0;
+            }
+#else
+            if (fp->sect - seg[i].sector < seg[i].count) {  /* Refill sector cache if it gets invalidated by the direct write */
+#if FF_FS_BUFPOOL
+                if (fp->buf)    /* (the sector will be reloaded if the buffer was taken away) */
+#endif
+                mem_cpy(fp->buf, seg[i].buff + ((fp->sect - seg[i].sector) * SS(fs)), SS(fs));
+                fp->flag &= (BYTE)~FA_DIRTY;
+            }
+#endif
+        } else {    /* Replace one of the read sectors with cached data if it contains a dirty sector */
+#if FF_FS_TINY
+            if (fs->wflag && fs->winsect - seg[i].sector < seg[i].count) {
+                mem_cpy(seg[i].buff + ((fs->winsect - seg[i].sector) * SS(fs)), fs->win, SS(fs));
+            }
+#else
+            if ((fp->flag & FA_DIRTY) && fp->sect - seg[i].sector < seg[i].count) {
+                mem_cpy(seg[i].buff + ((fp->sect - seg[i].sector) * SS(fs)), fp->buf, SS(fs));
+            }
+#endif
+        }
+#endif
+    }
+
+    fp->clust = clst;   /* Cluster containing the last sector transferred */
+    *cc = tc;
+    return FR_OK;
+}
+#endif
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Read File                                                             */
 /*-----------------------------------------------------------------------*/
 
-FRESULT f_read (
-    FIL* fp,    /* Pointer to the file object */
-    void* buff, /* Pointer to data buffer */
-    UINT btr,   /* Number of bytes to read */
-    UINT* br    /* Pointer to number of bytes read */
+static FRESULT read_file (  /* FR_OK(0):succeeded, !=0:hard error */
+    FIL* fp,        /* Pointer to the file object (validated and opened for read) */
+    BYTE* rbuff,    /* Pointer to data buffer */
+    UINT btr,       /* Number of bytes to read */
+    UINT* br        /* Pointer to number of bytes read (accumulated) */
 )
 {
-    FRESULT res;
-    FATFS *fs;
+    FATFS *fs = fp->obj.fs;
     DWORD clst, sect;
     FSIZE_t remain;
     UINT rcnt, cc, csect;
-    BYTE *rbuff = (BYTE*)buff;
 
 
-    *br = 0;    /* Clear read byte counter */
-    res = validate(&fp->obj, &fs);              /* Check validity of the file object */
-    if (res != FR_OK || (res = (FRESULT)fp->err) != FR_OK) LEAVE_FF(fs, res);   /* Check validity */
-    if (!(fp->flag & FA_READ)) LEAVE_FF(fs, FR_DENIED); /* Check access mode */
     remain = fp->obj.objsize - fp->fptr;
     if (btr > remain) btr = (UINT)remain;       /* Truncate btr by remaining bytes */
 
     for ( ;  btr;                               /* Repeat until btr bytes read */
         btr -= rcnt, *br += rcnt, rbuff += rcnt, fp->fptr += rcnt) {
-        if (fp->fptr % SS(fs) == 0) {           /* On the sector boundary? */
-            csect = (UINT)(fp->fptr / SS(fs) & (fs->csize - 1));    /* Sector offset in the cluster */
+        if (SOFS(fs, fp->fptr) == 0) {          /* On the sector boundary? */
+            csect = (UINT)SNUM(fs, fp->fptr) & (fs->csize - 1);     /* Sector offset in the cluster */
             if (csect == 0) {                   /* On the cluster boundary? */
                 if (fp->fptr == 0) {            /* On the top of the file? */
                     clst = fp->obj.sclust;      /* Follow cluster chain from the origin */
@@ -3771,19 +4499,28 @@ FRESULT f_read (
                         clst = get_fat(&fp->obj, fp->clust);    /* Follow cluster chain on the FAT */
                     }
                 }
-                if (clst < 2) ABORT(fs, FR_INT_ERR);
-                if (clst == 0xFFFFFFFF) ABORT(fs, FR_DISK_ERR);
+                if (clst < 2) return FR_INT_ERR;
+                if (clst == 0xFFFFFFFF) return FR_DISK_ERR;
                 fp->clust = clst;               /* Update current cluster */
             }
             sect = clst2sect(fs, fp->clust);    /* Get current sector */
-            if (sect == 0) ABORT(fs, FR_INT_ERR);
+            if (sect == 0) return FR_INT_ERR;
             sect += csect;
-            cc = btr / SS(fs);                  /* When remaining bytes >= sector size, */
+            cc = SNUM(fs, btr);                 /* When remaining bytes >= sector size, */
             if (cc > 0) {                       /* Read maximum contiguous sectors directly */
+#if FF_DISK_NSEG
+                if (csect + cc > fs->csize) {   /* Read the following cluster fragments in a command */
+                    FRESULT res = xfer_frags(fp, rbuff, sect, csect, &cc, 0);
+
+                    if (res != FR_OK) return res;
+                    rcnt = SS(fs) * cc;
+                    continue;
+                }
+#endif
                 if (csect + cc > fs->csize) {   /* Clip at cluster boundary */
                     cc = fs->csize - csect;
                 }
-                if (disk_read(fs->pdrv, rbuff, sect, cc) != RES_OK) ABORT(fs, FR_DISK_ERR);
+                if (DISK_READ(fs, rbuff, sect, cc) != RES_OK) return FR_DISK_ERR;
 #if !FF_FS_READONLY && FF_FS_MINIMIZE <= 2      /* Replace one of the read sectors with cached data if it contains a dirty sector */
 #if FF_FS_TINY
                 if (fs->wflag && fs->winsect - sect < cc) {
@@ -3799,67 +4536,128 @@ FRESULT f_read (
                 continue;
             }
 #if !FF_FS_TINY
+#if FF_FS_BUFPOOL
+            if (fbuf_take(fp, fp->sect == sect) != FR_OK) return FR_DISK_ERR;
+#endif
             if (fp->sect != sect) {         /* Load data sector if not in cache */
 #if !FF_FS_READONLY
                 if (fp->flag & FA_DIRTY) {      /* Write-back dirty sector cache */
-                    if (disk_write(fs->pdrv, fp->buf, fp->sect, 1) != RES_OK) ABORT(fs, FR_DISK_ERR);
+                    if (DISK_WRITE(fs, fp->buf, fp->sect, 1) != RES_OK) return FR_DISK_ERR;
                     fp->flag &= (BYTE)~FA_DIRTY;
                 }
 #endif
-                if (disk_read(fs->pdrv, fp->buf, sect, 1) != RES_OK)    ABORT(fs, FR_DISK_ERR); /* Fill sector cache */
+                if (DISK_READ(fs, fp->buf, sect, 1) != RES_OK)    return FR_DISK_ERR; /* Fill sector cache */
             }
 #endif
             fp->sect = sect;
         }
-        rcnt = SS(fs) - (UINT)fp->fptr % SS(fs);    /* Number of bytes left in the sector */
+        rcnt = SS(fs) - SOFS(fs, fp->fptr);     /* Number of bytes left in the sector */
         if (rcnt > btr) rcnt = btr;                 /* Clip it by btr if needed */
 #if FF_FS_TINY
-        if (move_window(fs, fp->sect) != FR_OK) ABORT(fs, FR_DISK_ERR); /* Move sector window */
-        mem_cpy(rbuff, fs->win + fp->fptr % SS(fs), rcnt);  /* Extract partial sector */
+        if (move_window(fs, fp->sect) != FR_OK) return FR_DISK_ERR; /* Move sector window */
+        mem_cpy(rbuff, fs->win + SOFS(fs, fp->fptr), rcnt);     /* Extract partial sector */
 #else
-        mem_cpy(rbuff, fp->buf + fp->fptr % SS(fs), rcnt);  /* Extract partial sector */
+#if FF_FS_BUFPOOL
+        if (fbuf_take(fp, 1) != FR_OK) return FR_DISK_ERR;
+#endif
+        mem_cpy(rbuff, fp->buf + SOFS(fs, fp->fptr), rcnt);     /* Extract partial sector */
 #endif
     }
 
+    return FR_OK;
+}
+
+
+FRESULT f_read (
+    FIL* fp,    /* Pointer to the file object */
+    void* buff, /* Pointer to data buffer */
+    UINT btr,   /* Number of bytes to read */
+    UINT* br    /* Pointer to number of bytes read */
+)
+{
+    FRESULT res;
+    FATFS *fs;
+    DEF_TRACE(FTO_READ)
+
+
+    *br = 0;    /* Clear read byte counter */
+    res = validate(&fp->obj, &fs);              /* Check validity of the file object */
+    if (res != FR_OK || (res = (FRESULT)fp->err) != FR_OK) LEAVE_FF(fs, res);   /* Check validity */
+    if (!(fp->flag & FA_READ)) LEAVE_FF(fs, FR_DENIED); /* Check access mode */
+
+    res = read_file(fp, (BYTE*)buff, btr, br);
+    if (res != FR_OK) ABORT(fs, res);
+
     LEAVE_FF(fs, FR_OK);
 }
 
 
 
 
-#if !FF_FS_READONLY
+#if FF_USE_IOVEC
 /*-----------------------------------------------------------------------*/
-/* Write File                                                            */
+/* Read File into Scattered Buffers                                      */
 /*-----------------------------------------------------------------------*/
 
-FRESULT f_write (
+FRESULT f_readv (
     FIL* fp,            /* Pointer to the file object */
-    const void* buff,   /* Pointer to the data to be written */
-    UINT btw,           /* Number of bytes to write */
-    UINT* bw            /* Pointer to number of bytes written */
+    const FFIOV* iov,   /* Pointer to the array of buffer segments */
+    UINT cnt,           /* Number of buffer segments */
+    UINT* br            /* Pointer to number of bytes read */
 )
 {
     FRESULT res;
     FATFS *fs;
-    DWORD clst, sect;
-    UINT wcnt, cc, csect;
-    const BYTE *wbuff = (const BYTE*)buff;
+    UINT i, n;
+    DEF_TRACE(FTO_READV)
 
 
-    *bw = 0;    /* Clear write byte counter */
-    res = validate(&fp->obj, &fs);          /* Check validity of the file object */
+    *br = 0;    /* Clear read byte counter */
+    res = validate(&fp->obj, &fs);              /* Check validity of the file object */
     if (res != FR_OK || (res = (FRESULT)fp->err) != FR_OK) LEAVE_FF(fs, res);   /* Check validity */
-    if (!(fp->flag & FA_WRITE)) LEAVE_FF(fs, FR_DENIED);    /* Check access mode */
+    if (!(fp->flag & FA_READ)) LEAVE_FF(fs, FR_DENIED); /* Check access mode */
+
+    for (i = 0; i < cnt; i++) {     /* Fill the segments in order (a sector split across segments is read once into the sector buffer) */
+        n = 0;
+        res = read_file(fp, (BYTE*)iov[i].buff, iov[i].len, &n);
+        *br += n;
+        if (res != FR_OK) ABORT(fs, res);
+        if (n < iov[i].len) break;  /* End of file */
+    }
+
+    LEAVE_FF(fs, FR_OK);
+}
+#endif
+
+
+
+
+#if !FF_FS_READONLY
+/*-----------------------------------------------------------------------*/
+/* Write File                                                            */
+/*-----------------------------------------------------------------------*/
+
+static FRESULT write_file ( /* FR_OK(0):succeeded, !=0:hard error */
+    FIL* fp,            /* Pointer to the file object (validated and opened for write) */
+    const BYTE* wbuff,  /* Pointer to the data to be written */
+    UINT btw,           /* Number of bytes to write */
+    UINT* bw            /* Pointer to number of bytes written (accumulated) */
+)
+{
+    FATFS *fs = fp->obj.fs;
+    DWORD clst, sect;
+    UINT wcnt, cc, csect;
+
 
     /* Check fptr wrap-around (file size cannot reach 4 GiB at FAT volume) */
-    if ((!FF_FS_EXFAT || fs->fs_type != FS_EXFAT) && (DWORD)(fp->fptr + btw) < (DWORD)fp->fptr) {
+    if ((!FF_FS_EXFAT || FS_TYPE(fs) != FS_EXFAT) && (DWORD)(fp->fptr + btw) < (DWORD)fp->fptr) {
         btw = (UINT)(0xFFFFFFFF - (DWORD)fp->fptr);
     }
 
     for ( ;  btw;                           /* Repeat until all data written */
         btw -= wcnt, *bw += wcnt, wbuff += wcnt, fp->fptr += wcnt, fp->obj.objsize = (fp->fptr > fp->obj.objsize) ? fp->fptr : fp->obj.objsize) {
-        if (fp->fptr % SS(fs) == 0) {       /* On the sector boundary? */
-            csect = (UINT)(fp->fptr / SS(fs)) & (fs->csize - 1);    /* Sector offset in the cluster */
+        if (SOFS(fs, fp->fptr) == 0) {      /* On the sector boundary? */
+            csect = (UINT)SNUM(fs, fp->fptr) & (fs->csize - 1);     /* Sector offset in the cluster */
             if (csect == 0) {               /* On the cluster boundary? */
                 if (fp->fptr == 0) {        /* On the top of the file? */
                     clst = fp->obj.sclust;  /* Follow from the origin */
@@ -3877,28 +4675,37 @@ FRESULT f_write (
                     }
                 }
                 if (clst == 0) break;       /* Could not allocate a new cluster (disk full) */
-                if (clst == 1) ABORT(fs, FR_INT_ERR);
-                if (clst == 0xFFFFFFFF) ABORT(fs, FR_DISK_ERR);
+                if (clst == 1) return FR_INT_ERR;
+                if (clst == 0xFFFFFFFF) return FR_DISK_ERR;
                 fp->clust = clst;           /* Update current cluster */
                 if (fp->obj.sclust == 0) fp->obj.sclust = clst; /* Set start cluster if the first write */
             }
 #if FF_FS_TINY
-            if (fs->winsect == fp->sect && sync_window(fs) != FR_OK) ABORT(fs, FR_DISK_ERR);    /* Write-back sector cache */
+            if (fs->winsect == fp->sect && sync_window(fs) != FR_OK) return FR_DISK_ERR;    /* Write-back sector cache */
 #else
             if (fp->flag & FA_DIRTY) {      /* Write-back sector cache */
-                if (disk_write(fs->pdrv, fp->buf, fp->sect, 1) != RES_OK) ABORT(fs, FR_DISK_ERR);
+                if (DISK_WRITE(fs, fp->buf, fp->sect, 1) != RES_OK) return FR_DISK_ERR;
                 fp->flag &= (BYTE)~FA_DIRTY;
             }
 #endif
             sect = clst2sect(fs, fp->clust);    /* Get current sector */
-            if (sect == 0) ABORT(fs, FR_INT_ERR);
+            if (sect == 0) return FR_INT_ERR;
             sect += csect;
-            cc = btw / SS(fs);              /* When remaining bytes >= sector size, */
+            cc = SNUM(fs, btw);             /* When remaining bytes >= sector size, */
             if (cc > 0) {                   /* Write maximum contiguous sectors directly */
+#if FF_DISK_NSEG
+                if (csect + cc > fs->csize) {   /* Write the following cluster fragments in a command */
+                    FRESULT res = xfer_frags(fp, (BYTE*)wbuff, sect, csect, &cc, 1);
+
+                    if (res != FR_OK) return res;
+                    wcnt = SS(fs) * cc;
+                    continue;
+                }
+#endif
                 if (csect + cc > fs->csize) {   /* Clip at cluster boundary */
                     cc = fs->csize - csect;
                 }
-                if (disk_write(fs->pdrv, wbuff, sect, cc) != RES_OK) ABORT(fs, FR_DISK_ERR);
+                if (DISK_WRITE(fs, wbuff, sect, cc) != RES_OK) return FR_DISK_ERR;
 #if FF_FS_MINIMIZE <= 2
 #if FF_FS_TINY
                 if (fs->winsect - sect < cc) {  /* Refill sector cache if it gets invalidated by the direct write */
@@ -3907,6 +4714,9 @@ FRESULT f_write (
                 }
 #else
                 if (fp->sect - sect < cc) { /* Refill sector cache if it gets invalidated by the direct write */
+#if FF_FS_BUFPOOL
+                    if (fp->buf)    /* (the sector will be reloaded if the buffer was taken away) */
+#endif
                     mem_cpy(fp->buf, wbuff + ((fp->sect - sect) * SS(fs)), SS(fs));
                     fp->flag &= (BYTE)~FA_DIRTY;
                 }
@@ -3917,31 +4727,60 @@ FRESULT f_write (
             }
 #if FF_FS_TINY
             if (fp->fptr >= fp->obj.objsize) {  /* Avoid silly cache filling on the growing edge */
-                if (sync_window(fs) != FR_OK) ABORT(fs, FR_DISK_ERR);
+                if (sync_window(fs) != FR_OK) return FR_DISK_ERR;
                 fs->winsect = sect;
             }
 #else
+#if FF_FS_BUFPOOL
+            if (fbuf_take(fp, fp->sect == sect) != FR_OK) return FR_DISK_ERR;
+#endif
             if (fp->sect != sect &&         /* Fill sector cache with file data */
                 fp->fptr < fp->obj.objsize &&
-                disk_read(fs->pdrv, fp->buf, sect, 1) != RES_OK) {
-                    ABORT(fs, FR_DISK_ERR);
+                DISK_READ(fs, fp->buf, sect, 1) != RES_OK) {
+                    return FR_DISK_ERR;
             }
 #endif
             fp->sect = sect;
         }
-        wcnt = SS(fs) - (UINT)fp->fptr % SS(fs);    /* Number of bytes left in the sector */
+        wcnt = SS(fs) - SOFS(fs, fp->fptr);     /* Number of bytes left in the sector */
         if (wcnt > btw) wcnt = btw;                 /* Clip it by btw if needed */
 #if FF_FS_TINY
-        if (move_window(fs, fp->sect) != FR_OK) ABORT(fs, FR_DISK_ERR); /* Move sector window */
-        mem_cpy(fs->win + fp->fptr % SS(fs), wbuff, wcnt);  /* Fit data to the sector */
+        if (move_window(fs, fp->sect) != FR_OK) return FR_DISK_ERR; /* Move sector window */
+        mem_cpy(fs->win + SOFS(fs, fp->fptr), wbuff, wcnt);     /* Fit data to the sector */
         fs->wflag = 1;
 #else
-        mem_cpy(fp->buf + fp->fptr % SS(fs), wbuff, wcnt);  /* Fit data to the sector */
+#if FF_FS_BUFPOOL
+        if (fbuf_take(fp, 1) != FR_OK) return FR_DISK_ERR;
+#endif
+        mem_cpy(fp->buf + SOFS(fs, fp->fptr), wbuff, wcnt);     /* Fit data to the sector */
         fp->flag |= FA_DIRTY;
 #endif
     }
 
     fp->flag |= FA_MODIFIED;                /* Set file change flag */
+    return FR_OK;
+}
+
+
+FRESULT f_write (
+    FIL* fp,            /* Pointer to the file object */
+    const void* buff,   /* Pointer to the data to be written */
+    UINT btw,           /* Number of bytes to write */
+    UINT* bw            /* Pointer to number of bytes written */
+)
+{
+    FRESULT res;
+    FATFS *fs;
+    DEF_TRACE(FTO_WRITE)
+
+
+    *bw = 0;    /* Clear write byte counter */
+    res = validate(&fp->obj, &fs);          /* Check validity of the file object */
+    if (res != FR_OK || (res = (FRESULT)fp->err) != FR_OK) LEAVE_FF(fs, res);   /* Check validity */
+    if (!(fp->flag & FA_WRITE)) LEAVE_FF(fs, FR_DENIED);    /* Check access mode */
+
+    res = write_file(fp, (const BYTE*)buff, btw, bw);
+    if (res != FR_OK) ABORT(fs, res);
 
     LEAVE_FF(fs, FR_OK);
 }
@@ -3949,85 +4788,260 @@ FRESULT f_write (
 
 
 
+#if FF_USE_IOVEC
 /*-----------------------------------------------------------------------*/
-/* Synchronize the File                                                  */
+/* Write File from Scattered Buffers                                     */
 /*-----------------------------------------------------------------------*/
 
-FRESULT f_sync (
-    FIL* fp     /* Pointer to the file object */
+FRESULT f_writev (
+    FIL* fp,            /* Pointer to the file object */
+    const FFIOV* iov,   /* Pointer to the array of data segments */
+    UINT cnt,           /* Number of data segments */
+    UINT* bw            /* Pointer to number of bytes written */
 )
 {
     FRESULT res;
     FATFS *fs;
-    DWORD tm;
+    UINT i, n;
+    DEF_TRACE(FTO_WRITEV)
+
+
+    *bw = 0;    /* Clear write byte counter */
+    res = validate(&fp->obj, &fs);          /* Check validity of the file object */
+    if (res != FR_OK || (res = (FRESULT)fp->err) != FR_OK) LEAVE_FF(fs, res);   /* Check validity */
+    if (!(fp->flag & FA_WRITE)) LEAVE_FF(fs, FR_DENIED);    /* Check access mode */
+
+    for (i = 0; i < cnt; i++) {     /* Write the segments in order (a sector split across segments is gathered in the sector buffer) */
+        n = 0;
+        res = write_file(fp, (const BYTE*)iov[i].buff, iov[i].len, &n);
+        *bw += n;
+        if (res != FR_OK) ABORT(fs, res);
+        if (n < iov[i].len) break;  /* Disk full or file size limit */
+    }
+
+    LEAVE_FF(fs, FR_OK);
+}
+#endif
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Synchronize the File                                                  */
+/*-----------------------------------------------------------------------*/
+
+static FRESULT sync_file (  /* FR_OK(0):succeeded, !=0:error */
+    FIL* fp,        /* Pointer to the file object (validated) */
+    BYTE full       /* 1:Update all metadata, 0:Update only metadata needed to retrieve the data */
+)
+{
+    FRESULT res = FR_OK;
+    FATFS *fs = fp->obj.fs;
+    DWORD tm = 0;
     BYTE *dir;
 
 
-    res = validate(&fp->obj, &fs);  /* Check validity of the file object */
-    if (res == FR_OK) {
-        if (fp->flag & FA_MODIFIED) {   /* Is there any change to the file? */
+    if (fp->flag & FA_MODIFIED) {   /* Is there any change to the file? */
 #if !FF_FS_TINY
-            if (fp->flag & FA_DIRTY) {  /* Write-back cached data if needed */
-                if (disk_write(fs->pdrv, fp->buf, fp->sect, 1) != RES_OK) LEAVE_FF(fs, FR_DISK_ERR);
-                fp->flag &= (BYTE)~FA_DIRTY;
-            }
+        if (fp->flag & FA_DIRTY) {  /* Write-back cached data if needed */
+            if (DISK_WRITE(fs, fp->buf, fp->sect, 1) != RES_OK) return FR_DISK_ERR;
+            fp->flag &= (BYTE)~FA_DIRTY;
+        }
 #endif
-            /* Update the directory entry */
-            tm = GET_FATTIME();             /* Modified time */
+        /* Update the directory entry (the entry is rewritten only if any change) */
+        if (full) tm = GET_FATTIME();   /* Modified time */
 #if FF_FS_EXFAT
-            if (fs->fs_type == FS_EXFAT) {
-                res = fill_first_frag(&fp->obj);    /* Fill first fragment on the FAT if needed */
-                if (res == FR_OK) {
-                    res = fill_last_frag(&fp->obj, fp->clust, 0xFFFFFFFF);  /* Fill last fragment on the FAT if needed */
-                }
-                if (res == FR_OK) {
-                    DIR dj;
-                    DEF_NAMBUF
+        if (FS_TYPE(fs) == FS_EXFAT) {
+            res = fill_first_frag(&fp->obj);    /* Fill first fragment on the FAT if needed */
+            if (res == FR_OK) {
+                res = fill_last_frag(&fp->obj, fp->clust, 0xFFFFFFFF);  /* Fill last fragment on the FAT if needed */
+            }
+            if (res == FR_OK) {
+                DIR dj;
+                DEF_NAMBUF
 
-                    INIT_NAMBUF(fs);
-                    res = load_obj_xdir(&dj, &fp->obj); /* Load directory entry block */
-                    if (res == FR_OK) {
-                        fs->dirbuf[XDIR_Attr] |= AM_ARC;                /* Set archive attribute to indicate that the file has been changed */
-                        fs->dirbuf[XDIR_GenFlags] = fp->obj.stat | 1;   /* Update file allocation information */
-                        st_dword(fs->dirbuf + XDIR_FstClus, fp->obj.sclust);
-                        st_qword(fs->dirbuf + XDIR_FileSize, fp->obj.objsize);
-                        st_qword(fs->dirbuf + XDIR_ValidFileSize, fp->obj.objsize);
-                        st_dword(fs->dirbuf + XDIR_ModTime, tm);        /* Update modified time */
-                        fs->dirbuf[XDIR_ModTime10] = 0;
-                        st_dword(fs->dirbuf + XDIR_AccTime, 0);
-                        res = store_xdir(&dj);  /* Restore it to the directory */
-                        if (res == FR_OK) {
-                            res = sync_fs(fs);
-                            fp->flag &= (BYTE)~FA_MODIFIED;
+                if (!ALLOC_NAMBUF(fs)) return FR_NOT_ENOUGH_CORE;   /* Directory entry block buffer (needed only at exFAT) */
+                res = load_obj_xdir(&dj, &fp->obj); /* Load directory entry block */
+                if (res == FR_OK) {
+                    dir = fs->dirbuf;
+                    if (dir[XDIR_GenFlags] != (fp->obj.stat | 1)
+                        || ld_dword(dir + XDIR_FstClus) != fp->obj.sclust
+                        || ld_qword(dir + XDIR_FileSize) != fp->obj.objsize
+                        || ld_qword(dir + XDIR_ValidFileSize) != fp->obj.objsize
+                        || (full && (!(dir[XDIR_Attr] & AM_ARC) || ld_dword(dir + XDIR_ModTime) != tm || dir[XDIR_ModTime10] != 0 || ld_dword(dir + XDIR_AccTime) != 0))) {
+                        dir[XDIR_GenFlags] = fp->obj.stat | 1;  /* Update file allocation information */
+                        st_dword(dir + XDIR_FstClus, fp->obj.sclust);
+                        st_qword(dir + XDIR_FileSize, fp->obj.objsize);
+                        st_qword(dir + XDIR_ValidFileSize, fp->obj.objsize);
+                        if (full) {
+                            dir[XDIR_Attr] |= AM_ARC;           /* Set archive attribute to indicate that the file has been changed */
+                            st_dword(dir + XDIR_ModTime, tm);   /* Update modified time */
+                            dir[XDIR_ModTime10] = 0;
+                            st_dword(dir + XDIR_AccTime, 0);
                         }
+                        res = store_xdir(&dj);  /* Restore it to the directory */
                     }
-                    FREE_NAMBUF();
                 }
-            } else
+                FREE_NAMBUF();
+            }
+        } else
 #endif
-            {
-                res = move_window(fs, fp->dir_sect);
-                if (res == FR_OK) {
-                    dir = fp->dir_ptr;
-                    dir[DIR_Attr] |= AM_ARC;                        /* Set archive attribute to indicate that the file has been changed */
-                    st_clust(fp->obj.fs, dir, fp->obj.sclust);      /* Update file allocation information  */
+        {
+            res = move_window(fs, fp->dir_sect);
+            if (res == FR_OK) {
+                dir = fp->dir_ptr;
+                if (ld_clust(fs, dir) != fp->obj.sclust
+                    || ld_dword(dir + DIR_FileSize) != (DWORD)fp->obj.objsize
+                    || (full && (!(dir[DIR_Attr] & AM_ARC) || ld_dword(dir + DIR_ModTime) != tm || ld_word(dir + DIR_LstAccDate) != 0))) {
+                    st_clust(fs, dir, fp->obj.sclust);      /* Update file allocation information  */
                     st_dword(dir + DIR_FileSize, (DWORD)fp->obj.objsize);   /* Update file size */
-                    st_dword(dir + DIR_ModTime, tm);                /* Update modified time */
-                    st_word(dir + DIR_LstAccDate, 0);
+                    if (full) {
+                        dir[DIR_Attr] |= AM_ARC;            /* Set archive attribute to indicate that the file has been changed */
+                        st_dword(dir + DIR_ModTime, tm);    /* Update modified time */
+                        st_word(dir + DIR_LstAccDate, 0);
+                    }
                     fs->wflag = 1;
-                    res = sync_fs(fs);                  /* Restore it to the directory */
-                    fp->flag &= (BYTE)~FA_MODIFIED;
                 }
             }
         }
+        if (res == FR_OK && full) fp->flag &= (BYTE)~FA_MODIFIED;  /* The timestamp is left to be updated at data-only sync */
     }
-
-    LEAVE_FF(fs, res);
+    return res;
 }
 
-#endif /* !FF_FS_READONLY */
-
-
+
+
+FRESULT f_sync (
+    FIL* fp     /* Pointer to the file object */
+)
+{
+    FRESULT res;
+    FATFS *fs;
+    DEF_TRACE(FTO_SYNC)
+
+
+    res = validate(&fp->obj, &fs);  /* Check validity of the file object */
+    if (res == FR_OK) {
+        if (fp->flag & FA_MODIFIED) {   /* Is there any change to the file? */
+            res = sync_file(fp, 1);     /* Update the file data and directory entry */
+            if (res == FR_OK) res = sync_fs(fs);    /* Flush the filesystem */
+        }
+#if FF_USE_TRIM && FF_TRIM_QUEUE
+        if (res == FR_OK) res = flush_trim(fs); /* Issue the queued discards */
+#endif
+    }
+
+    LEAVE_FF(fs, res);
+}
+
+
+
+#if FF_USE_SYNCMANY
+/*-----------------------------------------------------------------------*/
+/* Synchronize Multiple Files                                            */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_sync_many (
+    FIL* fps[],     /* Array of pointers to the file objects on a volume */
+    UINT nf         /* Number of file objects in the array */
+)
+{
+    FRESULT res;
+    FATFS *fs;
+    FIL *fp;
+    UINT i;
+#if FF_DISK_NSEG && !FF_FS_TINY
+    DSEG seg[FF_DISK_NSEG];
+    UINT n, k;
+#endif
+    DEF_TRACE(FTO_SYNCMANY)
+
+
+    if (!fps || nf == 0 || !fps[0]) EXIT_FF(FR_INVALID_OBJECT);
+    res = validate(&fps[0]->obj, &fs);  /* Check validity of the first file object */
+    if (res != FR_OK) LEAVE_FF(fs, res);
+    for (i = 1; i < nf; i++) {  /* All file objects must be valid and on the same volume */
+        if (!fps[i] || fps[i]->obj.fs != fs || fps[i]->obj.id != fs->id) LEAVE_FF(fs, FR_INVALID_OBJECT);
+    }
+
+#if FF_DISK_NSEG && !FF_FS_TINY
+    for (;;) {  /* Write-back cached data in ascending order of sector, up to FF_DISK_NSEG sectors in a command */
+        for (n = 0; n < FF_DISK_NSEG; n++) {
+            fp = 0;
+            for (i = 0; i < nf; i++) {
+                if ((fps[i]->flag & FA_DIRTY) && (n == 0 || fps[i]->sect > seg[n - 1].sector) && (!fp || fps[i]->sect < fp->sect)) fp = fps[i];
+            }
+            if (!fp) break;
+            seg[n].buff = fp->buf; seg[n].sector = fp->sect; seg[n].count = 1;
+        }
+        if (n == 0) break;
+        if (DISK_WRITEV(fs, seg, n, n) != RES_OK) LEAVE_FF(fs, FR_DISK_ERR);
+        for (i = 0; i < nf; i++) {
+            for (k = 0; k < n && fps[i]->buf != seg[k].buff; k++) ;
+            if (k < n) fps[i]->flag &= (BYTE)~FA_DIRTY;
+        }
+    }
+#elif !FF_FS_TINY
+    for (;;) {  /* Write-back cached data in ascending order of sector */
+        fp = 0;
+        for (i = 0; i < nf; i++) {
+            if ((fps[i]->flag & FA_DIRTY) && (!fp || fps[i]->sect < fp->sect)) fp = fps[i];
+        }
+        if (!fp) break;
+        if (DISK_WRITE(fs, fp->buf, fp->sect, 1) != RES_OK) LEAVE_FF(fs, FR_DISK_ERR);
+        fp->flag &= (BYTE)~FA_DIRTY;
+    }
+#endif
+    for (;;) {  /* Update the directory entries in ascending order of directory sector (each sector is written once) */
+        fp = 0;
+        for (i = 0; i < nf; i++) {
+            if ((fps[i]->flag & FA_MODIFIED) && (!fp || fps[i]->dir_sect < fp->dir_sect)) fp = fps[i];
+        }
+        if (!fp) break;
+        res = sync_file(fp, 1);
+        if (res != FR_OK) break;
+    }
+    if (res == FR_OK) res = sync_fs(fs);    /* Flush the filesystem (FSINFO and device cache) at a time */
+#if FF_USE_TRIM && FF_TRIM_QUEUE
+    if (res == FR_OK) res = flush_trim(fs); /* Issue the queued discards */
+#endif
+
+    LEAVE_FF(fs, res);
+}
+
+#endif
+
+
+
+#if FF_USE_DATASYNC
+/*-----------------------------------------------------------------------*/
+/* Synchronize the File Data                                             */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_datasync (
+    FIL* fp     /* Pointer to the file object */
+)
+{
+    FRESULT res;
+    FATFS *fs;
+    DEF_TRACE(FTO_DATASYNC)
+
+
+    res = validate(&fp->obj, &fs);  /* Check validity of the file object */
+    if (res == FR_OK && (fp->flag & FA_MODIFIED)) {
+        res = sync_file(fp, 0);     /* Update the file data and allocation information */
+        if (res == FR_OK) res = sync_window(fs);    /* Flush the FAT and directory (FSInfo is left to f_sync) */
+        if (res == FR_OK && DISK_SYNC(fs) != RES_OK) res = FR_DISK_ERR;
+    }
+
+    LEAVE_FF(fs, res);
+}
+
+#endif
+
+#endif /* !FF_FS_READONLY */
+
+
 
 
 /*-----------------------------------------------------------------------*/
@@ -4040,6 +5054,7 @@ FRESULT f_close (
 {
     FRESULT res;
     FATFS *fs;
+    DEF_TRACE(FTO_CLOSE)
 
 #if !FF_FS_READONLY
     res = f_sync(fp);                   /* Flush cached data */
@@ -4048,6 +5063,9 @@ FRESULT f_close (
     {
         res = validate(&fp->obj, &fs);  /* Lock volume */
         if (res == FR_OK) {
+#if !FF_FS_TINY && FF_FS_BUFPOOL
+            fbuf_free(fp);                      /* Release the pool buffer */
+#endif
 #if FF_FS_LOCK != 0
             res = dec_lock(fp->obj.lockid);     /* Decrement file open counter */
             if (res == FR_OK) fp->obj.fs = 0;   /* Invalidate file object */
@@ -4059,7 +5077,7 @@ FRESULT f_close (
 #endif
         }
     }
-    return res;
+    EXIT_FF(res);
 }
 
 
@@ -4098,6 +5116,7 @@ FRESULT f_chdir (
     DIR dj;
     FATFS *fs;
     DEF_NAMBUF
+    DEF_TRACE(FTO_CHDIR)
 
 
     /* Get logical drive */
@@ -4110,7 +5129,7 @@ FRESULT f_chdir (
             if (dj.fn[NSFLAG] & NS_NONAME) {    /* Is it the start directory itself? */
                 fs->cdir = dj.obj.sclust;
 #if FF_FS_EXFAT
-                if (fs->fs_type == FS_EXFAT) {
+                if (FS_TYPE(fs) == FS_EXFAT) {
                     fs->cdc_scl = dj.obj.c_scl;
                     fs->cdc_size = dj.obj.c_size;
                     fs->cdc_ofs = dj.obj.c_ofs;
@@ -4119,7 +5138,7 @@ FRESULT f_chdir (
             } else {
                 if (dj.obj.attr & AM_DIR) { /* It is a sub-directory */
 #if FF_FS_EXFAT
-                    if (fs->fs_type == FS_EXFAT) {
+                    if (FS_TYPE(fs) == FS_EXFAT) {
                         fs->cdir = ld_dword(fs->dirbuf + XDIR_FstClus);     /* Sub-directory cluster */
                         fs->cdc_scl = dj.obj.sclust;                        /* Save containing directory information */
                         fs->cdc_size = ((DWORD)dj.obj.objsize & 0xFFFFFF00) | dj.obj.stat;
@@ -4168,6 +5187,7 @@ FRESULT f_getcwd (
 #endif
     FILINFO fno;
     DEF_NAMBUF
+    DEF_TRACE(FTO_GETCWD)
 
 
     /* Get logical drive */
@@ -4179,7 +5199,7 @@ FRESULT f_getcwd (
 
         /* Follow parent directories and create the path */
         i = len;            /* Bottom of buffer (directory stack base) */
-        if (!FF_FS_EXFAT || fs->fs_type != FS_EXFAT) {  /* (Cannot do getcwd on exFAT and returns root path) */
+        if (!FF_FS_EXFAT || FS_TYPE(fs) != FS_EXFAT) {  /* (Cannot do getcwd on exFAT and returns root path) */
             dj.obj.sclust = fs->cdir;               /* Start to follow upper directory from current directory */
             while ((ccl = dj.obj.sclust) != 0) {    /* Repeat while current directory is a sub-directory */
                 res = dir_sdi(&dj, 1 * SZDIRE); /* Get parent directory */
@@ -4261,11 +5281,12 @@ FRESULT f_lseek (
 #if FF_USE_FASTSEEK
     DWORD cl, pcl, ncl, tcl, dsc, tlen, ulen, *tbl;
 #endif
+    DEF_TRACE(FTO_LSEEK)
 
     res = validate(&fp->obj, &fs);      /* Check validity of the file object */
     if (res == FR_OK) res = (FRESULT)fp->err;
 #if FF_FS_EXFAT && !FF_FS_READONLY
-    if (res == FR_OK && fs->fs_type == FS_EXFAT) {
+    if (res == FR_OK && FS_TYPE(fs) == FS_EXFAT) {
         res = fill_last_frag(&fp->obj, fp->clust, 0xFFFFFFFF);  /* Fill last fragment on the FAT if needed */
     }
 #endif
@@ -4305,16 +5326,19 @@ FRESULT f_lseek (
                 fp->clust = clmt_clust(fp, ofs - 1);
                 dsc = clst2sect(fs, fp->clust);
                 if (dsc == 0) ABORT(fs, FR_INT_ERR);
-                dsc += (DWORD)((ofs - 1) / SS(fs)) & (fs->csize - 1);
-                if (fp->fptr % SS(fs) && dsc != fp->sect) { /* Refill sector cache if needed */
+                dsc += (DWORD)SNUM(fs, ofs - 1) & (fs->csize - 1);
+                if (SOFS(fs, fp->fptr) && dsc != fp->sect) {    /* Refill sector cache if needed */
 #if !FF_FS_TINY
 #if !FF_FS_READONLY
                     if (fp->flag & FA_DIRTY) {      /* Write-back dirty sector cache */
-                        if (disk_write(fs->pdrv, fp->buf, fp->sect, 1) != RES_OK) ABORT(fs, FR_DISK_ERR);
+                        if (DISK_WRITE(fs, fp->buf, fp->sect, 1) != RES_OK) ABORT(fs, FR_DISK_ERR);
                         fp->flag &= (BYTE)~FA_DIRTY;
                     }
 #endif
-                    if (disk_read(fs->pdrv, fp->buf, dsc, 1) != RES_OK) ABORT(fs, FR_DISK_ERR); /* Load current sector */
+#if FF_FS_BUFPOOL
+                    if (fbuf_take(fp, 0) != FR_OK) ABORT(fs, FR_DISK_ERR);
+#endif
+                    if (DISK_READ(fs, fp->buf, dsc, 1) != RES_OK) ABORT(fs, FR_DISK_ERR); /* Load current sector */
 #endif
                     fp->sect = dsc;
                 }
@@ -4326,7 +5350,7 @@ FRESULT f_lseek (
     /* Normal Seek */
     {
 #if FF_FS_EXFAT
-        if (fs->fs_type != FS_EXFAT && ofs >= 0x100000000) ofs = 0xFFFFFFFF;    /* Clip at 4 GiB - 1 if at FATxx */
+        if (FS_TYPE(fs) != FS_EXFAT && ofs >= 0x100000000) ofs = 0xFFFFFFFF;    /* Clip at 4 GiB - 1 if at FATxx */
 #endif
         if (ofs > fp->obj.objsize && (FF_FS_READONLY || !(fp->flag & FA_WRITE))) {  /* In read-only mode, clip offset with the file size */
             ofs = fp->obj.objsize;
@@ -4375,10 +5399,10 @@ FRESULT f_lseek (
                     fp->clust = clst;
                 }
                 fp->fptr += ofs;
-                if (ofs % SS(fs)) {
+                if (SOFS(fs, ofs)) {
                     nsect = clst2sect(fs, clst);    /* Current sector */
                     if (nsect == 0) ABORT(fs, FR_INT_ERR);
-                    nsect += (DWORD)(ofs / SS(fs));
+                    nsect += (DWORD)SNUM(fs, ofs);
                 }
             }
         }
@@ -4386,15 +5410,18 @@ FRESULT f_lseek (
             fp->obj.objsize = fp->fptr;
             fp->flag |= FA_MODIFIED;
         }
-        if (fp->fptr % SS(fs) && nsect != fp->sect) {   /* Fill sector cache if needed */
+        if (SOFS(fs, fp->fptr) && nsect != fp->sect) {  /* Fill sector cache if needed */
 #if !FF_FS_TINY
 #if !FF_FS_READONLY
             if (fp->flag & FA_DIRTY) {          /* Write-back dirty sector cache */
-                if (disk_write(fs->pdrv, fp->buf, fp->sect, 1) != RES_OK) ABORT(fs, FR_DISK_ERR);
+                if (DISK_WRITE(fs, fp->buf, fp->sect, 1) != RES_OK) ABORT(fs, FR_DISK_ERR);
                 fp->flag &= (BYTE)~FA_DIRTY;
             }
 #endif
-            if (disk_read(fs->pdrv, fp->buf, nsect, 1) != RES_OK) ABORT(fs, FR_DISK_ERR);   /* Fill sector cache */
+#if FF_FS_BUFPOOL
+            if (fbuf_take(fp, 0) != FR_OK) ABORT(fs, FR_DISK_ERR);
+#endif
+            if (DISK_READ(fs, fp->buf, nsect, 1) != RES_OK) ABORT(fs, FR_DISK_ERR);   /* Fill sector cache */
 #endif
             fp->sect = nsect;
         }
@@ -4418,9 +5445,10 @@ FRESULT f_opendir (
     FRESULT res;
     FATFS *fs;
     DEF_NAMBUF
+    DEF_TRACE(FTO_OPENDIR)
 
 
-    if (!dp) return FR_INVALID_OBJECT;
+    if (!dp) EXIT_FF(FR_INVALID_OBJECT);
 
     /* Get logical drive */
     res = find_volume(&path, &fs, 0);
@@ -4432,7 +5460,7 @@ FRESULT f_opendir (
             if (!(dp->fn[NSFLAG] & NS_NONAME)) {    /* It is not the origin directory itself */
                 if (dp->obj.attr & AM_DIR) {        /* This object is a sub-directory */
 #if FF_FS_EXFAT
-                    if (fs->fs_type == FS_EXFAT) {
+                    if (FS_TYPE(fs) == FS_EXFAT) {
                         dp->obj.c_scl = dp->obj.sclust;                         /* Get containing directory inforamation */
                         dp->obj.c_size = ((DWORD)dp->obj.objsize & 0xFFFFFF00) | dp->obj.stat;
                         dp->obj.c_ofs = dp->blk_ofs;
@@ -4482,6 +5510,7 @@ FRESULT f_closedir (
 {
     FRESULT res;
     FATFS *fs;
+    DEF_TRACE(FTO_CLOSEDIR)
 
 
     res = validate(&dp->obj, &fs);  /* Check validity of the file object */
@@ -4496,7 +5525,7 @@ FRESULT f_closedir (
         unlock_fs(fs, FR_OK);       /* Unlock volume */
 #endif
     }
-    return res;
+    EXIT_FF(res);
 }
 
 
@@ -4514,6 +5543,7 @@ FRESULT f_readdir (
     FRESULT res;
     FATFS *fs;
     DEF_NAMBUF
+    DEF_TRACE(FTO_READDIR)
 
 
     res = validate(&dp->obj, &fs);  /* Check validity of the directory object */
@@ -4602,6 +5632,7 @@ FRESULT f_stat (
     FRESULT res;
     DIR dj;
     DEF_NAMBUF
+    DEF_TRACE(FTO_STAT)
 
 
     /* Get logical drive */
@@ -4640,6 +5671,7 @@ FRESULT f_getfree (
     DWORD nfree, clst, sect, stat;
     UINT i;
     FFOBJID obj;
+    DEF_TRACE(FTO_GETFREE)
 
 
     /* Get logical drive */
@@ -4652,7 +5684,7 @@ FRESULT f_getfree (
         } else {
             /* Scan FAT to obtain number of free clusters */
             nfree = 0;
-            if (fs->fs_type == FS_FAT12) {  /* FAT12: Scan bit field FAT entries */
+            if (FS_TYPE(fs) == FS_FAT12) {  /* FAT12: Scan bit field FAT entries */
                 clst = 2; obj.fs = fs;
                 do {
                     stat = get_fat(&obj, clst);
@@ -4662,7 +5694,7 @@ FRESULT f_getfree (
                 } while (++clst < fs->n_fatent);
             } else {
 #if FF_FS_EXFAT
-                if (fs->fs_type == FS_EXFAT) {  /* exFAT: Scan allocation bitmap */
+                if (FS_TYPE(fs) == FS_EXFAT) {  /* exFAT: Scan allocation bitmap */
                     BYTE bm;
                     UINT b;
 
@@ -4678,7 +5710,7 @@ FRESULT f_getfree (
                             if (!(bm & 1)) nfree++;
                             bm >>= 1;
                         }
-                        i = (i + 1) % SS(fs);
+                        i = SOFS(fs, i + 1);
                     } while (clst);
                 } else
 #endif
@@ -4691,14 +5723,14 @@ FRESULT f_getfree (
                             res = move_window(fs, sect++);
                             if (res != FR_OK) break;
                         }
-                        if (fs->fs_type == FS_FAT16) {
+                        if (FS_TYPE(fs) == FS_FAT16) {
                             if (ld_word(fs->win + i) == 0) nfree++;
                             i += 2;
                         } else {
                             if ((ld_dword(fs->win + i) & 0x0FFFFFFF) == 0) nfree++;
                             i += 4;
                         }
-                        i %= SS(fs);
+                        i = SOFS(fs, i);
                     } while (--clst);
                 }
             }
@@ -4725,6 +5757,7 @@ FRESULT f_truncate (
     FRESULT res;
     FATFS *fs;
     DWORD ncl;
+    DEF_TRACE(FTO_TRUNCATE)
 
 
     res = validate(&fp->obj, &fs);  /* Check validity of the file object */
@@ -4748,7 +5781,7 @@ FRESULT f_truncate (
         fp->flag |= FA_MODIFIED;
 #if !FF_FS_TINY
         if (res == FR_OK && (fp->flag & FA_DIRTY)) {
-            if (disk_write(fs->pdrv, fp->buf, fp->sect, 1) != RES_OK) {
+            if (DISK_WRITE(fs, fp->buf, fp->sect, 1) != RES_OK) {
                 res = FR_DISK_ERR;
             } else {
                 fp->flag &= (BYTE)~FA_DIRTY;
@@ -4780,6 +5813,7 @@ FRESULT f_unlink (
     FFOBJID obj;
 #endif
     DEF_NAMBUF
+    DEF_TRACE(FTO_UNLINK)
 
 
     /* Get logical drive */
@@ -4805,7 +5839,7 @@ FRESULT f_unlink (
             if (res == FR_OK) {
 #if FF_FS_EXFAT
                 obj.fs = fs;
-                if (fs->fs_type == FS_EXFAT) {
+                if (FS_TYPE(fs) == FS_EXFAT) {
                     init_alloc_info(fs, &obj);
                     dclst = obj.sclust;
                 } else
@@ -4823,7 +5857,7 @@ FRESULT f_unlink (
                         sdj.obj.fs = fs;                /* Open the sub-directory */
                         sdj.obj.sclust = dclst;
 #if FF_FS_EXFAT
-                        if (fs->fs_type == FS_EXFAT) {
+                        if (FS_TYPE(fs) == FS_EXFAT) {
                             sdj.obj.objsize = obj.objsize;
                             sdj.obj.stat = obj.stat;
                         }
@@ -4872,6 +5906,7 @@ FRESULT f_mkdir (
     FATFS *fs;
     DWORD dcl, pcl, tm;
     DEF_NAMBUF
+    DEF_TRACE(FTO_MKDIR)
 
 
     res = find_volume(&path, &fs, FA_WRITE);    /* Get logical drive */
@@ -4894,7 +5929,7 @@ FRESULT f_mkdir (
             if (res == FR_OK) {
                 res = dir_clear(fs, dcl);       /* Clean up the new table */
                 if (res == FR_OK) {
-                    if (!FF_FS_EXFAT || fs->fs_type != FS_EXFAT) {  /* Create dot entries (FAT only) */
+                    if (!FF_FS_EXFAT || FS_TYPE(fs) != FS_EXFAT) {  /* Create dot entries (FAT only) */
                         mem_set(fs->win + DIR_Name, ' ', 11);   /* Create "." entry */
                         fs->win[DIR_Name] = '.';
                         fs->win[DIR_Attr] = AM_DIR;
@@ -4910,7 +5945,7 @@ FRESULT f_mkdir (
             }
             if (res == FR_OK) {
 #if FF_FS_EXFAT
-                if (fs->fs_type == FS_EXFAT) {  /* Initialize directory entry block */
+                if (FS_TYPE(fs) == FS_EXFAT) {  /* Initialize directory entry block */
                     st_dword(fs->dirbuf + XDIR_ModTime, tm);    /* Created time */
                     st_dword(fs->dirbuf + XDIR_FstClus, dcl);   /* Table start cluster */
                     st_dword(fs->dirbuf + XDIR_FileSize, (DWORD)fs->csize * SS(fs));    /* File size needs to be valid */
@@ -4957,6 +5992,7 @@ FRESULT f_rename (
     BYTE buf[FF_FS_EXFAT ? SZDIRE * 2 : SZDIRE], *dir;
     DWORD dw;
     DEF_NAMBUF
+    DEF_TRACE(FTO_RENAME)
 
 
     get_ldnumber(&path_new);                        /* Snip the drive number of new name off */
@@ -4973,7 +6009,7 @@ FRESULT f_rename (
 #endif
         if (res == FR_OK) {                     /* Object to be renamed is found */
 #if FF_FS_EXFAT
-            if (fs->fs_type == FS_EXFAT) {  /* At exFAT volume */
+            if (FS_TYPE(fs) == FS_EXFAT) {  /* At exFAT volume */
                 BYTE nf, nn;
                 WORD nh;
 
@@ -5066,6 +6102,7 @@ FRESULT f_chmod (
     DIR dj;
     FATFS *fs;
     DEF_NAMBUF
+    DEF_TRACE(FTO_CHMOD)
 
 
     res = find_volume(&path, &fs, FA_WRITE);    /* Get logical drive */
@@ -5077,7 +6114,7 @@ FRESULT f_chmod (
         if (res == FR_OK) {
             mask &= AM_RDO|AM_HID|AM_SYS|AM_ARC;    /* Valid attribute mask */
 #if FF_FS_EXFAT
-            if (fs->fs_type == FS_EXFAT) {
+            if (FS_TYPE(fs) == FS_EXFAT) {
                 fs->dirbuf[XDIR_Attr] = (attr & mask) | (fs->dirbuf[XDIR_Attr] & (BYTE)~mask);  /* Apply attribute change */
                 res = store_xdir(&dj);
             } else
@@ -5112,6 +6149,7 @@ FRESULT f_utime (
     DIR dj;
     FATFS *fs;
     DEF_NAMBUF
+    DEF_TRACE(FTO_UTIME)
 
 
     res = find_volume(&path, &fs, FA_WRITE);    /* Get logical drive */
@@ -5122,7 +6160,7 @@ FRESULT f_utime (
         if (res == FR_OK && (dj.fn[NSFLAG] & (NS_DOT | NS_NONAME))) res = FR_INVALID_NAME;  /* Check object validity */
         if (res == FR_OK) {
 #if FF_FS_EXFAT
-            if (fs->fs_type == FS_EXFAT) {
+            if (FS_TYPE(fs) == FS_EXFAT) {
                 st_dword(fs->dirbuf + XDIR_ModTime, (DWORD)fno->fdate << 16 | fno->ftime);
                 res = store_xdir(&dj);
             } else
@@ -5161,6 +6199,7 @@ FRESULT f_getlabel (
     FATFS *fs;
     UINT si, di;
     WCHAR wc;
+    DEF_TRACE(FTO_GETLABEL)
 
     /* Get logical drive */
     res = find_volume(&path, &fs, 0);
@@ -5173,7 +6212,7 @@ FRESULT f_getlabel (
             res = DIR_READ_LABEL(&dj);      /* Find a volume label entry */
             if (res == FR_OK) {
 #if FF_FS_EXFAT
-                if (fs->fs_type == FS_EXFAT) {
+                if (FS_TYPE(fs) == FS_EXFAT) {
                     WCHAR hs;
 
                     for (si = di = hs = 0; si < dj.dir[XDIR_NumLabel]; si++) {  /* Extract volume label from 83 entry */
@@ -5221,7 +6260,7 @@ FRESULT f_getlabel (
     if (res == FR_OK && vsn) {
         res = move_window(fs, fs->volbase);
         if (res == FR_OK) {
-            switch (fs->fs_type) {
+            switch (FS_TYPE(fs)) {
             case FS_EXFAT:
                 di = BPB_VolIDEx; break;
 
@@ -5259,13 +6298,14 @@ FRESULT f_setlabel (
 #if FF_USE_LFN
     DWORD dc;
 #endif
+    DEF_TRACE(FTO_SETLABEL)
 
     /* Get logical drive */
     res = find_volume(&label, &fs, FA_WRITE);
     if (res != FR_OK) LEAVE_FF(fs, res);
 
 #if FF_FS_EXFAT
-    if (fs->fs_type == FS_EXFAT) {  /* On the exFAT volume */
+    if (FS_TYPE(fs) == FS_EXFAT) {  /* On the exFAT volume */
         mem_set(dirvn, 0, 22);
         di = 0;
         while ((UINT)*label >= ' ') {   /* Create volume label */
@@ -5317,7 +6357,7 @@ FRESULT f_setlabel (
     if (res == FR_OK) {
         res = DIR_READ_LABEL(&dj);  /* Get volume label entry */
         if (res == FR_OK) {
-            if (FF_FS_EXFAT && fs->fs_type == FS_EXFAT) {
+            if (FF_FS_EXFAT && FS_TYPE(fs) == FS_EXFAT) {
                 dj.dir[XDIR_NumLabel] = (BYTE)di;   /* Change the volume label */
                 mem_cpy(dj.dir + XDIR_Label, dirvn, 22);
             } else {
@@ -5336,7 +6376,7 @@ FRESULT f_setlabel (
                     res = dir_alloc(&dj, 1);    /* Allocate an entry */
                     if (res == FR_OK) {
                         mem_set(dj.dir, 0, SZDIRE); /* Clean the entry */
-                        if (FF_FS_EXFAT && fs->fs_type == FS_EXFAT) {
+                        if (FF_FS_EXFAT && FS_TYPE(fs) == FS_EXFAT) {
                             dj.dir[XDIR_Type] = ET_VLABEL;  /* Create volume label entry */
                             dj.dir[XDIR_NumLabel] = (BYTE)di;
                             mem_cpy(dj.dir + XDIR_Label, dirvn, 22);
@@ -5360,6 +6400,55 @@ FRESULT f_setlabel (
 
 
 
+#if (FF_USE_EXPAND || FF_USE_DEFRAG || (FF_USE_COPY && FF_FS_MINIMIZE == 0)) && !FF_FS_READONLY
+/*-----------------------------------------------------------------------*/
+/* Find a Contiguous Free Cluster Block                                  */
+/*-----------------------------------------------------------------------*/
+
+static DWORD find_contiguous (  /* 0:Not found, 1:Internal error, 0xFFFFFFFF:Disk error, >=2:Top of the block found */
+    FFOBJID* obj,   /* Object to be used for the FAT access */
+    DWORD stcl,     /* Cluster number to scan from */
+    DWORD tcl       /* Number of contiguous clusters to find (1..) */
+)
+{
+    FATFS *fs = obj->fs;
+    DWORD n, clst, scl, ncl;
+
+
+#if FF_FS_EXFAT
+    if (FS_TYPE(fs) == FS_EXFAT) {
+        scl = find_bitmap(fs, stcl, tcl, 0);    /* Find a contiguous cluster block on the bitmap */
+        if (scl >= 2 && scl != 0xFFFFFFFF && scl + tcl > fs->n_fatent) {   /* Reject a block wrapped around the end */
+            scl = 0;
+            if (stcl > 2) { /* Find it again in the area below the scan origin */
+                scl = find_bitmap(fs, 2, tcl, stcl);
+                if (scl >= 2 && scl != 0xFFFFFFFF && scl + tcl > fs->n_fatent) scl = 0;
+            }
+        }
+        return scl;
+    }
+#endif
+    scl = clst = stcl; ncl = 0;
+    for (;;) {  /* Find a contiguous cluster block on the FAT */
+        n = get_fat(obj, clst);
+        if (n == 1 || n == 0xFFFFFFFF) return n;
+        if (n == 0) {   /* Is it a free cluster? */
+            if (++ncl == tcl) return scl;   /* Return if a contiguous cluster block is found */
+        } else {
+            ncl = 0;                        /* Not a free cluster */
+        }
+        if (++clst >= fs->n_fatent) {       /* Next cluster (a block cannot wrap around the end) */
+            clst = 2; ncl = 0;
+        }
+        if (ncl == 0) scl = clst;
+        if (clst == stcl) return 0;         /* No contiguous cluster? */
+    }
+}
+
+#endif /* (FF_USE_EXPAND || FF_USE_DEFRAG || (FF_USE_COPY && FF_FS_MINIMIZE == 0)) && !FF_FS_READONLY */
+
+
+
 #if FF_USE_EXPAND && !FF_FS_READONLY
 /*-----------------------------------------------------------------------*/
 /* Allocate a Contiguous Blocks to the File                              */
@@ -5373,59 +6462,42 @@ FRESULT f_expand (
 {
     FRESULT res;
     FATFS *fs;
-    DWORD n, clst, stcl, scl, ncl, tcl, lclst;
+    DWORD n, clst, stcl, scl, tcl, lclst;
+    DEF_TRACE(FTO_EXPAND)
 
 
     res = validate(&fp->obj, &fs);      /* Check validity of the file object */
     if (res != FR_OK || (res = (FRESULT)fp->err) != FR_OK) LEAVE_FF(fs, res);
     if (fsz == 0 || fp->obj.objsize != 0 || !(fp->flag & FA_WRITE)) LEAVE_FF(fs, FR_DENIED);
 #if FF_FS_EXFAT
-    if (fs->fs_type != FS_EXFAT && fsz >= 0x100000000) LEAVE_FF(fs, FR_DENIED); /* Check if in size limit */
+    if (FS_TYPE(fs) != FS_EXFAT && fsz >= 0x100000000) LEAVE_FF(fs, FR_DENIED); /* Check if in size limit */
 #endif
     n = (DWORD)fs->csize * SS(fs);  /* Cluster size */
     tcl = (DWORD)(fsz / n) + ((fsz & (n - 1)) ? 1 : 0); /* Number of clusters required */
     stcl = fs->last_clst; lclst = 0;
     if (stcl < 2 || stcl >= fs->n_fatent) stcl = 2;
 
+    scl = find_contiguous(&fp->obj, stcl, tcl);     /* Find a contiguous cluster block */
+    if (scl == 0) res = FR_DENIED;                  /* No contiguous cluster block was found */
+    if (scl == 1) res = FR_INT_ERR;
+    if (scl == 0xFFFFFFFF) res = FR_DISK_ERR;
+    if (res == FR_OK) { /* A contiguous free area is found */
+        if (opt) {      /* Allocate it now */
 #if FF_FS_EXFAT
-    if (fs->fs_type == FS_EXFAT) {
-        scl = find_bitmap(fs, stcl, tcl);           /* Find a contiguous cluster block */
-        if (scl == 0) res = FR_DENIED;              /* No contiguous cluster block was found */
-        if (scl == 0xFFFFFFFF) res = FR_DISK_ERR;
-        if (res == FR_OK) { /* A contiguous free area is found */
-            if (opt) {      /* Allocate it now */
+            if (FS_TYPE(fs) == FS_EXFAT) {
                 res = change_bitmap(fs, scl, tcl, 1);   /* Mark the cluster block 'in use' */
                 lclst = scl + tcl - 1;
-            } else {        /* Set it as suggested point for next allocation */
-                lclst = scl - 1;
-            }
-        }
-    } else
+            } else
 #endif
-    {
-        scl = clst = stcl; ncl = 0;
-        for (;;) {  /* Find a contiguous cluster block */
-            n = get_fat(&fp->obj, clst);
-            if (++clst >= fs->n_fatent) clst = 2;
-            if (n == 1) { res = FR_INT_ERR; break; }
-            if (n == 0xFFFFFFFF) { res = FR_DISK_ERR; break; }
-            if (n == 0) {   /* Is it a free cluster? */
-                if (++ncl == tcl) break;    /* Break if a contiguous cluster block is found */
-            } else {
-                scl = clst; ncl = 0;        /* Not a free cluster */
-            }
-            if (clst == stcl) { res = FR_DENIED; break; }   /* No contiguous cluster? */
-        }
-        if (res == FR_OK) { /* A contiguous free area is found */
-            if (opt) {      /* Allocate it now */
+            {
                 for (clst = scl, n = tcl; n; clst++, n--) { /* Create a cluster chain on the FAT */
                     res = put_fat(fs, clst, (n == 1) ? 0xFFFFFFFF : clst + 1);
                     if (res != FR_OK) break;
                     lclst = clst;
                 }
-            } else {        /* Set it as suggested point for next allocation */
-                lclst = scl - 1;
             }
+        } else {        /* Set it as suggested point for next allocation */
+            lclst = scl - 1;
         }
     }
 
@@ -5450,126 +6522,861 @@ FRESULT f_expand (
 
 
 
-#if FF_USE_FORWARD
+#if FF_USE_DEFRAG && !FF_FS_READONLY
 /*-----------------------------------------------------------------------*/
-/* Forward Data to the Stream Directly                                   */
+/* Relocate the File Data into a Contiguous Block                        */
 /*-----------------------------------------------------------------------*/
 
-FRESULT f_forward (
-    FIL* fp,                        /* Pointer to the file object */
-    UINT (*func)(const BYTE*,UINT), /* Pointer to the streaming function */
-    UINT btf,                       /* Number of bytes to forward */
-    UINT* bf                        /* Pointer to number of bytes forwarded */
+static FRESULT copy_chain ( /* FR_OK(0):succeeded, !=0:error */
+    FIL* fp,        /* File object to be relocated */
+    DWORD scl,      /* Top of the destination cluster block */
+    DWORD tcl,      /* Number of clusters to be copied */
+    BYTE* buf,      /* Working buffer */
+    UINT sz_buf     /* Size of working buffer [sector] */
+)
+{
+    FATFS *fs = fp->obj.fs;
+    DWORD clst, nxt = 0, ncl, frag, sect, dsect, nsect, fcl = 0, fsc = 0;
+    UINT n;
+
+
+    clst = fp->obj.sclust; ncl = scl;
+    while (tcl) {
+        for (frag = 1; frag < tcl; frag++) {    /* Get length of the contiguous fragment */
+            nxt = get_fat(&fp->obj, clst + frag - 1);
+            if (nxt == 0xFFFFFFFF) return FR_DISK_ERR;
+            if (nxt != clst + frag) break;
+        }
+        if (frag < tcl && (nxt < 2 || nxt >= fs->n_fatent)) return FR_INT_ERR;  /* Broken chain? */
+        sect = clst2sect(fs, clst);
+        dsect = clst2sect(fs, ncl);
+        if (sect == 0 || dsect == 0) return FR_INT_ERR;
+        nsect = frag * fs->csize;
+        if (fp->clust - clst < frag) fcl = ncl + (fp->clust - clst);    /* Follow the current cluster */
+        if (fp->sect - sect < nsect) fsc = dsect + (fp->sect - sect);   /* Follow the current sector */
+        do {    /* Copy the fragment in multiple sector transfers */
+            n = (nsect > sz_buf) ? sz_buf : (UINT)nsect;
+            if (DISK_READ(fs, buf, sect, n) != RES_OK) return FR_DISK_ERR;
+            if (DISK_WRITE(fs, buf, dsect, n) != RES_OK) return FR_DISK_ERR;
+            if (fs->winsect - dsect < n) {  /* Refill sector window if it gets invalidated by the direct write */
+                mem_cpy(fs->win, buf + ((fs->winsect - dsect) * SS(fs)), SS(fs));
+            }
+            sect += n; dsect += n; nsect -= n;
+        } while (nsect);
+        clst = nxt; ncl += frag; tcl -= frag;
+    }
+    if (fcl != 0) fp->clust = fcl;
+    if (fsc != 0) fp->sect = fsc;
+    return FR_OK;
+}
+
+
+
+FRESULT f_defrag (
+    FIL* fp,        /* Pointer to the file object */
+    void* work,     /* Pointer to working buffer (null: use heap memory) */
+    UINT len        /* Size of working buffer [byte] */
 )
 {
     FRESULT res;
     FATFS *fs;
-    DWORD clst, sect;
-    FSIZE_t remain;
-    UINT rcnt, csect;
-    BYTE *dbuf;
+    FFOBJID obj;
+    DWORD n, clst, stcl, scl, tcl;
+    UINT sz_buf;
+    BYTE *buf;
+    DEF_TRACE(FTO_DEFRAG)
 
 
-    *bf = 0;    /* Clear transfer byte counter */
     res = validate(&fp->obj, &fs);      /* Check validity of the file object */
     if (res != FR_OK || (res = (FRESULT)fp->err) != FR_OK) LEAVE_FF(fs, res);
-    if (!(fp->flag & FA_READ)) LEAVE_FF(fs, FR_DENIED); /* Check access mode */
+    if (!(fp->flag & FA_WRITE)) LEAVE_FF(fs, FR_DENIED);    /* Check access mode */
+    if (fp->obj.sclust == 0 || fp->obj.objsize == 0) LEAVE_FF(fs, FR_OK);   /* No data to be relocated */
+    n = (DWORD)fs->csize * SS(fs);  /* Cluster size */
+    tcl = (DWORD)(fp->obj.objsize / n) + ((fp->obj.objsize & (n - 1)) ? 1 : 0); /* Number of clusters in use */
 
-    remain = fp->obj.objsize - fp->fptr;
-    if (btf > remain) btf = (UINT)remain;           /* Truncate btf by remaining bytes */
+#if FF_FS_EXFAT
+    if (FS_TYPE(fs) == FS_EXFAT) {
+        res = fill_first_frag(&fp->obj);    /* Fill first fragment on the FAT if needed */
+        if (res == FR_OK) res = fill_last_frag(&fp->obj, fp->clust, 0xFFFFFFFF);    /* Fill last fragment on the FAT if needed */
+        if (res != FR_OK) ABORT(fs, res);
+    }
+#endif
+    for (clst = fp->obj.sclust, n = 1; n < tcl; clst++, n++) {  /* Check if the file is already contiguous */
+        scl = get_fat(&fp->obj, clst);
+        if (scl == 0xFFFFFFFF) ABORT(fs, FR_DISK_ERR);
+        if (scl != clst + 1) break;
+    }
+    if (n == tcl) LEAVE_FF(fs, FR_OK);
 
-    for ( ;  btf && (*func)(0, 0);                  /* Repeat until all data transferred or stream goes busy */
-        fp->fptr += rcnt, *bf += rcnt, btf -= rcnt) {
-        csect = (UINT)(fp->fptr / SS(fs) & (fs->csize - 1));    /* Sector offset in the cluster */
-        if (fp->fptr % SS(fs) == 0) {               /* On the sector boundary? */
-            if (csect == 0) {                       /* On the cluster boundary? */
-                clst = (fp->fptr == 0) ?            /* On the top of the file? */
-                    fp->obj.sclust : get_fat(&fp->obj, fp->clust);
-                if (clst <= 1) ABORT(fs, FR_INT_ERR);
-                if (clst == 0xFFFFFFFF) ABORT(fs, FR_DISK_ERR);
-                fp->clust = clst;                   /* Update current cluster */
-            }
+    /* Flush the cached data to the current location */
+#if !FF_FS_TINY
+    if (fp->flag & FA_DIRTY) {
+        if (DISK_WRITE(fs, fp->buf, fp->sect, 1) != RES_OK) ABORT(fs, FR_DISK_ERR);
+        fp->flag &= (BYTE)~FA_DIRTY;
+    }
+#endif
+    if (sync_window(fs) != FR_OK) ABORT(fs, FR_DISK_ERR);
+
+    /* Get working buffer */
+#if FF_USE_LFN == 3
+    if (!work) {    /* Use heap memory for working buffer */
+        for (n = MAX_MALLOC, buf = 0; n >= SS(fs) && (buf = ff_memalloc(n)) == 0; n /= 2) ;
+        sz_buf = n / SS(fs);    /* Size of working buffer (sector) */
+    } else
+#endif
+    {
+        buf = (BYTE*)work;          /* Working buffer */
+        sz_buf = len / SS(fs);      /* Size of working buffer (sector) */
+    }
+    if (!buf || sz_buf == 0) LEAVE_FF(fs, FR_NOT_ENOUGH_CORE);
+
+    /* Find a contiguous free block and copy the file data into it */
+    stcl = fs->last_clst;
+    if (stcl < 2 || stcl >= fs->n_fatent) stcl = 2;
+    scl = find_contiguous(&fp->obj, stcl, tcl);
+    if (scl == 0) res = FR_DENIED;      /* No contiguous cluster block was found */
+    if (scl == 1) res = FR_INT_ERR;
+    if (scl == 0xFFFFFFFF) res = FR_DISK_ERR;
+    if (res == FR_OK) {
+        res = copy_chain(fp, scl, tcl, buf, sz_buf);
+    }
+#if FF_USE_LFN == 3
+    if (!work) ff_memfree(buf);
+#endif
+    if (res != FR_OK) LEAVE_FF(fs, res);    /* The file and the volume are left unchanged */
+
+    /* Allocate the new chain and flush it prior to switch the file to it */
+#if FF_FS_EXFAT
+    if (FS_TYPE(fs) == FS_EXFAT) {
+        res = change_bitmap(fs, scl, tcl, 1);   /* Mark the cluster block 'in use' */
+    } else
+#endif
+    {
+        for (clst = scl, n = tcl; n && res == FR_OK; clst++, n--) { /* Create a cluster chain on the FAT */
+            res = put_fat(fs, clst, (n == 1) ? 0xFFFFFFFF : clst + 1);
         }
-        sect = clst2sect(fs, fp->clust);            /* Get current data sector */
-        if (sect == 0) ABORT(fs, FR_INT_ERR);
-        sect += csect;
-#if FF_FS_TINY
-        if (move_window(fs, sect) != FR_OK) ABORT(fs, FR_DISK_ERR); /* Move sector window to the file data */
-        dbuf = fs->win;
-#else
-        if (fp->sect != sect) {     /* Fill sector cache with file data */
-#if !FF_FS_READONLY
-            if (fp->flag & FA_DIRTY) {      /* Write-back dirty sector cache */
-                if (disk_write(fs->pdrv, fp->buf, fp->sect, 1) != RES_OK) ABORT(fs, FR_DISK_ERR);
-                fp->flag &= (BYTE)~FA_DIRTY;
-            }
+    }
+    if (res == FR_OK) {
+        fs->last_clst = scl + tcl - 1;
+        if (fs->free_clst <= fs->n_fatent - 2) {    /* Update FSINFO */
+            fs->free_clst -= tcl;
+            fs->fsi_flag |= 1;
+        }
+        res = sync_fs(fs);
+    }
+    if (res != FR_OK) ABORT(fs, res);
+
+    /* Switch the directory entry to the new chain */
+    obj = fp->obj;              /* Save the old chain */
+    fp->obj.sclust = scl;
+#if FF_USE_FASTSEEK
+    if (fp->cltbl) {            /* Update the cluster link map (it fits in the current size) */
+        fp->cltbl[0] = 4; fp->cltbl[1] = tcl; fp->cltbl[2] = scl; fp->cltbl[3] = 0;
+    }
 #endif
-            if (disk_read(fs->pdrv, fp->buf, sect, 1) != RES_OK) ABORT(fs, FR_DISK_ERR);
+#if FF_FS_EXFAT
+    if (FS_TYPE(fs) == FS_EXFAT) {
+        DIR dj;
+        DEF_NAMBUF
+
+        fp->obj.stat = 2;       /* Set status 'contiguous chain' */
+        INIT_NAMBUF(fs);
+        res = load_obj_xdir(&dj, &fp->obj); /* Load directory entry block */
+        if (res == FR_OK) {
+            fs->dirbuf[XDIR_GenFlags] = fp->obj.stat | 1;   /* Update file allocation information */
+            st_dword(fs->dirbuf + XDIR_FstClus, fp->obj.sclust);
+            res = store_xdir(&dj);
         }
-        dbuf = fp->buf;
+        FREE_NAMBUF();
+    } else
 #endif
-        fp->sect = sect;
-        rcnt = SS(fs) - (UINT)fp->fptr % SS(fs);    /* Number of bytes left in the sector */
-        if (rcnt > btf) rcnt = btf;                 /* Clip it by btr if needed */
-        rcnt = (*func)(dbuf + ((UINT)fp->fptr % SS(fs)), rcnt); /* Forward the file data */
-        if (rcnt == 0) ABORT(fs, FR_INT_ERR);
+    {
+        res = move_window(fs, fp->dir_sect);
+        if (res == FR_OK) {
+            st_clust(fs, fp->dir_ptr, fp->obj.sclust); /* Update file allocation information */
+            fs->wflag = 1;
+        }
     }
+    if (res == FR_OK) res = sync_fs(fs);
+
+    /* Remove the old chain */
+    if (res == FR_OK) {
+        res = remove_chain(&obj, obj.sclust, 0);
+        if (res == FR_OK) res = sync_fs(fs);
+    }
+    if (res != FR_OK) ABORT(fs, res);
 
     LEAVE_FF(fs, FR_OK);
 }
-#endif /* FF_USE_FORWARD */
 
+#endif /* FF_USE_DEFRAG && !FF_FS_READONLY */
 
 
-#if FF_USE_MKFS && !FF_FS_READONLY
+
+#if FF_USE_COPY && !FF_FS_READONLY && FF_FS_MINIMIZE == 0
 /*-----------------------------------------------------------------------*/
-/* Create an FAT/exFAT volume                                            */
+/* Copy a File                                                           */
 /*-----------------------------------------------------------------------*/
 
-FRESULT f_mkfs (
-    const TCHAR* path,  /* Logical drive number */
-    BYTE opt,           /* Format option */
-    DWORD au,           /* Size of allocation unit (cluster) [byte] */
-    void* work,         /* Pointer to working buffer (null: use heap memory) */
-    UINT len            /* Size of working buffer [byte] */
+static FRESULT copy_contiguous (    /* FR_OK(0):succeeded, FR_DENIED:No contiguous free block (nothing changed), others:error */
+    FIL* dfp,       /* Destination file object (just created) */
+    FIL* sfp,       /* Source file object (on the same volume) */
+    BYTE* buf,      /* Working buffer */
+    UINT sz_buf     /* Size of working buffer [sector] */
 )
 {
-    const UINT n_fats = 1;      /* Number of FATs for FAT/FAT32 volume (1 or 2) */
-    const UINT n_rootdir = 512; /* Number of root directory entries for FAT volume */
-    static const WORD cst[] = {1, 4, 16, 64, 256, 512, 0};  /* Cluster size boundary for FAT volume (4Ks unit) */
-    static const WORD cst32[] = {1, 2, 4, 8, 16, 32, 0};    /* Cluster size boundary for FAT32 volume (128Ks unit) */
-    BYTE fmt, sys, *buf, *pte, pdrv, part;
-    WORD ss;    /* Sector size */
-    DWORD szb_buf, sz_buf, sz_blk, n_clst, pau, sect, nsect, n;
-    DWORD b_vol, b_fat, b_data;             /* Base LBA for volume, fat, data */
-    DWORD sz_vol, sz_rsv, sz_fat, sz_dir;   /* Size for volume, fat, dir, data */
-    UINT i;
-    int vol;
-    DSTATUS stat;
-#if FF_USE_TRIM || FF_FS_EXFAT
-    DWORD tbl[3];
+    FRESULT res;
+    FATFS *fs;
+    DWORD n, clst, nxt = 0, stcl, scl, tcl, frag, sect, dsect, nsect, tsect;
+#if FF_USE_COPY == 2
+    DWORD cp[3];
+    BYTE offload = 1;
 #endif
 
 
-    /* Check mounted drive and clear work area */
-    vol = get_ldnumber(&path);                  /* Get target logical drive */
-    if (vol < 0) return FR_INVALID_DRIVE;
-    if (FatFs[vol]) FatFs[vol]->fs_type = 0;    /* Clear the volume if mounted */
-    pdrv = LD2PD(vol);  /* Physical drive */
-    part = LD2PT(vol);  /* Partition (0:create as new, 1-4:get from partition table) */
+    res = validate(&dfp->obj, &fs);     /* Check validity of the file object and lock the volume */
+    if (res != FR_OK) return res;
+    if (sfp->obj.objsize > 0) {
+        n = (DWORD)fs->csize * SS(fs);  /* Cluster size */
+        tcl = (DWORD)(sfp->obj.objsize / n) + ((sfp->obj.objsize & (n - 1)) ? 1 : 0);  /* Number of clusters required */
+        tsect = (DWORD)(sfp->obj.objsize / SS(fs)) + ((sfp->obj.objsize & (SS(fs) - 1)) ? 1 : 0);    /* Number of sectors to be copied */
+        if (sync_window(fs) != FR_OK) res = FR_DISK_ERR;    /* Flush the window, it can have file data at tiny cfg */
 
-    /* Check physical drive status */
-    stat = disk_initialize(pdrv);
-    if (stat & STA_NOINIT) return FR_NOT_READY;
-    if (stat & STA_PROTECT) return FR_WRITE_PROTECTED;
-    if (disk_ioctl(pdrv, GET_BLOCK_SIZE, &sz_blk) != RES_OK || !sz_blk || sz_blk > 32768 || (sz_blk & (sz_blk - 1))) sz_blk = 1;    /* Erase block to align data area */
-#if FF_MAX_SS != FF_MIN_SS      /* Get sector size of the medium if variable sector size cfg. */
-    if (disk_ioctl(pdrv, GET_SECTOR_SIZE, &ss) != RES_OK) return FR_DISK_ERR;
-    if (ss > FF_MAX_SS || ss < FF_MIN_SS || (ss & (ss - 1))) return FR_DISK_ERR;
+        /* Find a contiguous free block and allocate it to the destination file (as f_expand does) */
+        if (res == FR_OK) {
+            stcl = fs->last_clst;
+            if (stcl < 2 || stcl >= fs->n_fatent) stcl = 2;
+            scl = find_contiguous(&dfp->obj, stcl, tcl);
+            if (scl == 0) res = FR_DENIED;      /* No contiguous cluster block was found */
+            if (scl == 1) res = FR_INT_ERR;
+            if (scl == 0xFFFFFFFF) res = FR_DISK_ERR;
+        }
+        if (res == FR_OK) {
+#if FF_FS_EXFAT
+            if (FS_TYPE(fs) == FS_EXFAT) {
+                res = change_bitmap(fs, scl, tcl, 1);   /* Mark the cluster block 'in use' */
+            } else
+#endif
+            {
+                for (clst = scl, n = tcl; n && res == FR_OK; clst++, n--) { /* Create a cluster chain on the FAT */
+                    res = put_fat(fs, clst, (n == 1) ? 0xFFFFFFFF : clst + 1);
+                }
+            }
+        }
+        if (res == FR_OK) {
+            fs->last_clst = scl + tcl - 1;
+            if (fs->free_clst <= fs->n_fatent - 2) {    /* Update FSINFO */
+                fs->free_clst -= tcl;
+                fs->fsi_flag |= 1;
+            }
+            dfp->obj.sclust = scl;      /* Update object allocation information */
+            dfp->obj.objsize = sfp->obj.objsize;
+            if (FF_FS_EXFAT) dfp->obj.stat = 2; /* Set status 'contiguous chain' */
+            dfp->flag |= FA_MODIFIED;
+        }
+
+        /* Copy the source file fragment by fragment in multiple sector transfers */
+        if (res == FR_OK) {
+            clst = sfp->obj.sclust;
+            dsect = clst2sect(fs, scl);
+            while (tsect) {
+                for (frag = 1; frag * fs->csize < tsect; frag++) {  /* Get length of the contiguous fragment */
+                    nxt = get_fat(&sfp->obj, clst + frag - 1);
+                    if (nxt == 0xFFFFFFFF || nxt != clst + frag) break;
+                }
+                if (nxt == 0xFFFFFFFF) {
+                    res = FR_DISK_ERR; break;
+                }
+                if (frag * fs->csize < tsect && (nxt < 2 || nxt >= fs->n_fatent)) {  /* Broken chain? */
+                    res = FR_INT_ERR; break;
+                }
+                sect = clst2sect(fs, clst);
+                if (sect == 0 || dsect == 0) {
+                    res = FR_INT_ERR; break;
+                }
+                nsect = frag * fs->csize;
+                if (nsect > tsect) nsect = tsect;   /* Clip at end of the file */
+                tsect -= nsect;
+#if FF_USE_COPY == 2
+                if (offload) {  /* Let the device copy the fragment if possible */
+                    cp[0] = sect; cp[1] = dsect; cp[2] = nsect;
+                    if (disk_ioctl(fs->pdrv, CTRL_COPY, cp) == RES_OK) {
+                        if (fs->winsect - dsect < nsect) fs->winsect = 0xFFFFFFFF;  /* Invalidate sector window if it gets overwritten */
+                        dsect += nsect; nsect = 0;
+                    } else {
+                        offload = 0;    /* Copy with read/write from now on */
+                    }
+                }
+#endif
+                while (nsect) {
+                    n = (nsect > sz_buf) ? sz_buf : nsect;
+                    if (DISK_READ(fs, buf, sect, (UINT)n) != RES_OK || DISK_WRITE(fs, buf, dsect, (UINT)n) != RES_OK) break;
+                    if (fs->winsect - dsect < n) {  /* Refill sector window if it gets invalidated by the direct write */
+                        mem_cpy(fs->win, buf + ((fs->winsect - dsect) * SS(fs)), SS(fs));
+                    }
+                    sect += n; dsect += n; nsect -= n;
+                }
+                if (nsect) {
+                    res = FR_DISK_ERR; break;
+                }
+                clst = nxt;
+            }
+        }
+    }
+
+#if FF_FS_REENTRANT
+    unlock_fs(fs, res);
+#endif
+    return res;
+}
+
+
+
+FRESULT f_copy (
+    const TCHAR* path_old,  /* Pointer to the source file name */
+    const TCHAR* path_new,  /* Pointer to the destination file name */
+    void* work,             /* Pointer to working buffer (null: use heap memory) */
+    UINT len                /* Size of working buffer [byte] */
+)
+{
+    FRESULT res, res2;
+    FIL sf, df;
+    UINT br, bw;
+    BYTE *buf;
+    DEF_TRACE(FTO_COPY)
+
+
+    res = f_open(&sf, path_old, FA_READ);   /* Open the source file */
+    if (res != FR_OK) EXIT_FF(res);
+
+    /* Get working buffer */
+#if FF_USE_LFN == 3
+    if (!work) {    /* Use heap memory for working buffer */
+        for (len = MAX_MALLOC, buf = 0; len >= SS(sf.obj.fs) && (buf = ff_memalloc(len)) == 0; len /= 2) ;
+    } else
+#endif
+    {
+        buf = (BYTE*)work;
+    }
+    if (!buf || len < SS(sf.obj.fs)) res = FR_NOT_ENOUGH_CORE;
+
+    if (res == FR_OK) {
+        res = f_open(&df, path_new, FA_WRITE | FA_CREATE_NEW);  /* Create the destination file */
+        if (res == FR_OK) {
+            res = FR_DENIED;
+            if (df.obj.fs == sf.obj.fs) {   /* On the same volume? */
+                res = copy_contiguous(&df, &sf, buf, len / SS(sf.obj.fs));
+            }
+            if (res == FR_DENIED) {     /* Different volume or no contiguous free block: Copy via the file objects */
+                do {
+                    res = f_read(&sf, buf, len, &br);
+                    if (res != FR_OK || br == 0) break;
+                    res = f_write(&df, buf, br, &bw);
+                    if (res == FR_OK && bw < br) res = FR_DENIED;   /* Disk full */
+                } while (res == FR_OK);
+            }
+            res2 = f_close(&df);
+            if (res == FR_OK) res = res2;
+            if (res != FR_OK) f_unlink(path_new);   /* Remove the incomplete copy */
+        }
+    }
+
+#if FF_USE_LFN == 3
+    if (!work) ff_memfree(buf);
+#endif
+    f_close(&sf);
+
+    EXIT_FF(res);
+}
+
+#endif /* FF_USE_COPY && !FF_FS_READONLY && FF_FS_MINIMIZE == 0 */
+
+
+
+#if FF_USE_TRIM && !FF_FS_READONLY
+#if FF_TRIM_QUEUE
+/*-----------------------------------------------------------------------*/
+/* Issue Queued Discards                                                 */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_trim_flush (
+    const TCHAR* path   /* Logical drive number */
+)
+{
+    FRESULT res;
+    FATFS *fs;
+    DEF_TRACE(FTO_TRIMFLUSH)
+
+
+    res = find_volume(&path, &fs, FA_WRITE);    /* Get logical drive */
+    if (res == FR_OK) {
+        res = flush_trim(fs);
+    }
+
+    LEAVE_FF(fs, res);
+}
+
+#endif  /* FF_TRIM_QUEUE */
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Discard All Free Clusters                                             */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_trim_free (
+    const TCHAR* path   /* Logical drive number */
+)
+{
+    FRESULT res;
+    FATFS *fs;
+    DWORD nfree, clst, scl, stat;
+    FFOBJID obj;
+    DEF_TRACE(FTO_TRIMFREE)
+
+
+    res = find_volume(&path, &fs, FA_WRITE);    /* Get logical drive */
+    if (res == FR_OK) {
+        res = sync_fs(fs);      /* Flush the FAT/bitmap prior to discard */
+    }
+    if (res == FR_OK) {
+#if FF_TRIM_QUEUE
+        fs->n_trim = 0;         /* Queued blocks are discarded in this process */
+#endif
+        nfree = scl = 0; obj.fs = fs;
+        for (clst = 2; clst < fs->n_fatent; clst++) {
+#if FF_FS_EXFAT
+            if (FS_TYPE(fs) == FS_EXFAT) {  /* exFAT: Get cluster status from the allocation bitmap */
+                res = move_window(fs, fs->bitbase + SNUM(fs, (clst - 2) / 8));
+                if (res != FR_OK) break;
+                stat = fs->win[SOFS(fs, (clst - 2) / 8)] >> ((clst - 2) % 8) & 1;
+            } else
+#endif
+            {                               /* FAT/FAT32: Get cluster status from the FAT */
+                stat = get_fat(&obj, clst);
+                if (stat == 0xFFFFFFFF) { res = FR_DISK_ERR; break; }
+                if (stat == 1) { res = FR_INT_ERR; break; }
+            }
+            if (stat == 0) {        /* Free cluster */
+                if (scl == 0) scl = clst;
+                nfree++;
+            } else {
+                if (scl != 0) trim_block(fs, scl, clst - 1);    /* Discard the free block */
+                scl = 0;
+            }
+        }
+        if (res == FR_OK) {
+            if (scl != 0) trim_block(fs, scl, fs->n_fatent - 1);
+            fs->free_clst = nfree;  /* Now free_clst is valid */
+            fs->fsi_flag |= 1;      /* FAT32: FSInfo is to be updated */
+        }
+    }
+
+    LEAVE_FF(fs, res);
+}
+
+#endif /* FF_USE_TRIM && !FF_FS_READONLY */
+
+
+
+#if FF_USE_STATS
+/*-----------------------------------------------------------------------*/
+/* Get Volume Statistics                                                 */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_getstats (
+    const TCHAR* path,  /* Logical drive number */
+    FFSTATS* st         /* Pointer to the structure to receive the statistics */
+)
+{
+    FRESULT res;
+    FATFS *fs;
+    DEF_TRACE(FTO_GETSTATS)
+
+
+    if (!st) EXIT_FF(FR_INVALID_PARAMETER);
+    res = find_volume(&path, &fs, 0);   /* Get logical drive */
+    if (res == FR_OK) {
+        *st = fs->stats;
+    }
+    LEAVE_FF(fs, res);
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Clear Volume Statistics                                               */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_resetstats (
+    const TCHAR* path   /* Logical drive number */
+)
+{
+    FRESULT res;
+    FATFS *fs;
+    DEF_TRACE(FTO_RESETSTATS)
+
+
+    res = find_volume(&path, &fs, 0);   /* Get logical drive */
+    if (res == FR_OK) {
+        mem_set(&fs->stats, 0, sizeof fs->stats);
+    }
+    LEAVE_FF(fs, res);
+}
+
+#endif /* FF_USE_STATS */
+
+
+
+#if FF_USE_TRACE
+/*-----------------------------------------------------------------------*/
+/* Get Latency Histogram of an Operation                                 */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_trace_hist (
+    BYTE op,        /* Operation ID (FTO_*) */
+    DWORD* hist     /* Pointer to the array to receive the histogram (FTO_NBIN items) */
+)
+{
+    if (op >= FTO_NUM || !hist) return FR_INVALID_PARAMETER;
+    mem_cpy(hist, TrHist[op], sizeof TrHist[op]);
+    return FR_OK;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Move Out the Records in the Trace Buffer                              */
+/*-----------------------------------------------------------------------*/
+
+UINT f_trace_dump (     /* Returns number of bytes stored */
+    void* buff,     /* Pointer to the buffer to store the records */
+    UINT len        /* Size of the buffer [byte] */
+)
+{
+    UINT n = 0;
+#if FF_TRACE_BUF
+    BYTE *d = (BYTE*)buff;
+    UINT i;
+
+
+    i = (TrHead + FF_TRACE_BUF - TrCnt) % FF_TRACE_BUF;  /* Oldest record */
+    while (TrCnt > 0 && len - n >= FTO_RECSIZE) {
+        mem_cpy(d + n, TrBuf[i], FTO_RECSIZE);
+        n += FTO_RECSIZE;
+        if (++i == FF_TRACE_BUF) i = 0;
+        TrCnt--;
+    }
+#else
+    (void)buff; (void)len;
+#endif
+    return n;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Clear the Histograms and the Trace Buffer                             */
+/*-----------------------------------------------------------------------*/
+
+void f_trace_clear (void)
+{
+    mem_set(TrHist, 0, sizeof TrHist);
+#if FF_TRACE_BUF
+    TrHead = TrCnt = 0;
+#endif
+}
+
+#endif /* FF_USE_TRACE */
+
+
+
+#if FF_USE_FORWARD
+/*-----------------------------------------------------------------------*/
+/* Forward Data to the Stream Directly                                   */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_forward (
+    FIL* fp,                        /* Pointer to the file object */
+    UINT (*func)(const BYTE*,UINT), /* Pointer to the streaming function */
+    UINT btf,                       /* Number of bytes to forward */
+    UINT* bf                        /* Pointer to number of bytes forwarded */
+)
+{
+    FRESULT res;
+    FATFS *fs;
+    DWORD clst, sect;
+    FSIZE_t remain;
+    UINT rcnt, csect;
+    BYTE *dbuf;
+    DEF_TRACE(FTO_FORWARD)
+
+
+    *bf = 0;    /* Clear transfer byte counter */
+    res = validate(&fp->obj, &fs);      /* Check validity of the file object */
+    if (res != FR_OK || (res = (FRESULT)fp->err) != FR_OK) LEAVE_FF(fs, res);
+    if (!(fp->flag & FA_READ)) LEAVE_FF(fs, FR_DENIED); /* Check access mode */
+
+    remain = fp->obj.objsize - fp->fptr;
+    if (btf > remain) btf = (UINT)remain;           /* Truncate btf by remaining bytes */
+
+    for ( ;  btf && (*func)(0, 0);                  /* Repeat until all data transferred or stream goes busy */
+        fp->fptr += rcnt, *bf += rcnt, btf -= rcnt) {
+        csect = (UINT)SNUM(fs, fp->fptr) & (fs->csize - 1);     /* Sector offset in the cluster */
+        if (SOFS(fs, fp->fptr) == 0) {              /* On the sector boundary? */
+            if (csect == 0) {                       /* On the cluster boundary? */
+                clst = (fp->fptr == 0) ?            /* On the top of the file? */
+                    fp->obj.sclust : get_fat(&fp->obj, fp->clust);
+                if (clst <= 1) ABORT(fs, FR_INT_ERR);
+                if (clst == 0xFFFFFFFF) ABORT(fs, FR_DISK_ERR);
+                fp->clust = clst;                   /* Update current cluster */
+            }
+        }
+        sect = clst2sect(fs, fp->clust);            /* Get current data sector */
+        if (sect == 0) ABORT(fs, FR_INT_ERR);
+        sect += csect;
+#if FF_FS_TINY
+        if (move_window(fs, sect) != FR_OK) ABORT(fs, FR_DISK_ERR); /* Move sector window to the file data */
+        dbuf = fs->win;
+#else
+#if FF_FS_BUFPOOL
+        if (fbuf_take(fp, fp->sect == sect) != FR_OK) ABORT(fs, FR_DISK_ERR);
+#endif
+        if (fp->sect != sect) {     /* Fill sector cache with file data */
+#if !FF_FS_READONLY
+            if (fp->flag & FA_DIRTY) {      /* Write-back dirty sector cache */
+                if (DISK_WRITE(fs, fp->buf, fp->sect, 1) != RES_OK) ABORT(fs, FR_DISK_ERR);
+                fp->flag &= (BYTE)~FA_DIRTY;
+            }
+#endif
+            if (DISK_READ(fs, fp->buf, sect, 1) != RES_OK) ABORT(fs, FR_DISK_ERR);
+        }
+        dbuf = fp->buf;
+#endif
+        fp->sect = sect;
+        rcnt = SS(fs) - SOFS(fs, fp->fptr);     /* Number of bytes left in the sector */
+        if (rcnt > btf) rcnt = btf;                 /* Clip it by btr if needed */
+        rcnt = (*func)(dbuf + SOFS(fs, fp->fptr), rcnt);    /* Forward the file data */
+        if (rcnt == 0) ABORT(fs, FR_INT_ERR);
+    }
+
+    LEAVE_FF(fs, FR_OK);
+}
+#endif /* FF_USE_FORWARD */
+
+
+
+#if FF_USE_MAPREAD
+/*-----------------------------------------------------------------------*/
+/* Map File Data in the Sector Buffer                                    */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_map_read (
+    FIL* fp,            /* Pointer to the file object */
+    FSIZE_t ofs,        /* File offset of the data to be mapped */
+    const void** ptr,   /* Pointer to the variable to return the pointer to the data */
+    UINT* len           /* Pointer to the variable to return the number of bytes mapped */
+)
+{
+    FRESULT res;
+    FATFS *fs;
+    DWORD clst, sect, ncl;
+    FSIZE_t bcs;
+    UINT csect, n;
+    BYTE *dbuf;
+    DEF_TRACE(FTO_MAPREAD)
+
+
+    *ptr = 0; *len = 0;
+    res = validate(&fp->obj, &fs);      /* Check validity of the file object */
+    if (res != FR_OK || (res = (FRESULT)fp->err) != FR_OK) LEAVE_FF(fs, res);
+    if (!(fp->flag & FA_READ)) LEAVE_FF(fs, FR_DENIED); /* Check access mode */
+#if FF_FS_EXFAT && !FF_FS_READONLY
+    if (FS_TYPE(fs) == FS_EXFAT) {
+        res = fill_last_frag(&fp->obj, fp->clust, 0xFFFFFFFF);  /* Fill last fragment on the FAT if needed */
+        if (res != FR_OK) LEAVE_FF(fs, res);
+    }
+#endif
+    if (ofs >= fp->obj.objsize) LEAVE_FF(fs, FR_OK);    /* Nothing to map at or beyond the end of the file */
+
+#if !FF_FS_TINY && FF_FS_BUFPOOL
+    if (!fp->buf || !fs->ppin[(UINT)(fp->buf - fs->pool[0]) / FF_MAX_SS]) {  /* The file does not hold a pinned buffer? */
+        for (csect = n = 0; csect < FF_FS_BUFPOOL; csect++) n += fs->ppin[csect];
+        if (n + 1 >= FF_FS_BUFPOOL) LEAVE_FF(fs, FR_TOO_MANY_OPEN_FILES);   /* Leave a buffer for the other files */
+    }
+#endif
+
+    /* Get the cluster that contains the offset */
+    bcs = (FSIZE_t)fs->csize * SS(fs);  /* Cluster size (byte) */
+#if FF_USE_FASTSEEK
+    if (fp->cltbl) {
+        clst = clmt_clust(fp, ofs);     /* Get cluster# from the CLMT */
+        ncl = 0;
+    } else
+#endif
+    {
+        if (fp->fptr > 0 && fp->clust >= 2 && ofs / bcs >= (fp->fptr - 1) / bcs) {  /* At or after the current cluster? */
+            clst = fp->clust;           /* Follow cluster chain from the current cluster */
+            ncl = (DWORD)(ofs / bcs - (fp->fptr - 1) / bcs);
+        } else {
+            clst = fp->obj.sclust;      /* Follow cluster chain from the origin */
+            ncl = (DWORD)(ofs / bcs);
+        }
+    }
+    for ( ; ncl > 0 && clst >= 2; ncl--) {
+        clst = get_fat(&fp->obj, clst);
+        if (clst == 0xFFFFFFFF) ABORT(fs, FR_DISK_ERR);
+    }
+    if (clst < 2 || clst >= fs->n_fatent) ABORT(fs, FR_INT_ERR);
+    sect = clst2sect(fs, clst);         /* Get the data sector */
+    if (sect == 0) ABORT(fs, FR_INT_ERR);
+    csect = (UINT)SNUM(fs, ofs) & (fs->csize - 1);      /* Sector offset in the cluster */
+    sect += csect;
+
+    /* Load the sector into the buffer */
+#if FF_FS_TINY
+    if (move_window(fs, sect) != FR_OK) ABORT(fs, FR_DISK_ERR); /* Move sector window to the file data */
+    dbuf = fs->win;
+#else
+#if FF_FS_BUFPOOL
+    if (fbuf_take(fp, fp->sect == sect) != FR_OK) ABORT(fs, FR_DISK_ERR);
+#endif
+    if (fp->sect != sect) {     /* Fill sector cache with file data */
+#if !FF_FS_READONLY
+        if (fp->flag & FA_DIRTY) {      /* Write-back dirty sector cache */
+            if (DISK_WRITE(fs, fp->buf, fp->sect, 1) != RES_OK) ABORT(fs, FR_DISK_ERR);
+            fp->flag &= (BYTE)~FA_DIRTY;
+        }
+#endif
+        if (DISK_READ(fs, fp->buf, sect, 1) != RES_OK) ABORT(fs, FR_DISK_ERR);
+    }
+    dbuf = fp->buf;
+#if FF_FS_BUFPOOL
+    fs->ppin[(UINT)(fp->buf - fs->pool[0]) / FF_MAX_SS] = 1;    /* Pin the buffer to the file until released */
+#endif
+#endif
+    fp->sect = sect;
+    fp->clust = clst;
+
+    /* Lend the data to the end of the sector, and move the file pointer past it as f_read does */
+    n = SS(fs) - (UINT)SOFS(fs, ofs);   /* Number of bytes left in the sector */
+    if (n > fp->obj.objsize - ofs) n = (UINT)(fp->obj.objsize - ofs);   /* Clip it at end of the file */
+    fp->fptr = ofs + n;
+    *ptr = dbuf + SOFS(fs, ofs);
+    *len = n;
+
+    LEAVE_FF(fs, FR_OK);
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Release the Mapped File Data                                          */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_map_release (
+    FIL* fp             /* Pointer to the file object */
+)
+{
+    FRESULT res;
+    FATFS *fs;
+    DEF_TRACE(FTO_MAPRELEASE)
+
+
+    res = validate(&fp->obj, &fs);      /* Check validity of the file object */
+#if !FF_FS_TINY && FF_FS_BUFPOOL
+    if (res == FR_OK && fp->buf) {      /* Unpin the buffer (the data is kept as the sector cache of the file) */
+        fs->ppin[(UINT)(fp->buf - fs->pool[0]) / FF_MAX_SS] = 0;
+    }
+#endif
+
+    LEAVE_FF(fs, res);
+}
+#endif /* FF_USE_MAPREAD */
+
+
+
+#if FF_USE_MKFS && !FF_FS_READONLY
+/*-----------------------------------------------------------------------*/
+/* Create an FAT/exFAT volume                                            */
+/*-----------------------------------------------------------------------*/
+
+static DRESULT fill_zero (  /* RES_OK(0):succeeded, !=0:error */
+    BYTE pdrv,      /* Physical drive number */
+    DWORD sect,     /* Start sector to be cleared */
+    DWORD nsect,    /* Number of sectors to be cleared */
+    BYTE* buf,      /* Working buffer */
+    DWORD sz_buf,   /* Size of working buffer [sector] */
+    UINT ss         /* Sector size [byte] */
+)
+{
+    DWORD n;
+#if FF_USE_ZEROFILL
+    DWORD rt[2];
+#endif
+
+
+    if (nsect == 0) return RES_OK;
+#if FF_USE_ZEROFILL
+    rt[0] = sect; rt[1] = sect + nsect - 1;
+    if (disk_ioctl(pdrv, CTRL_ZERO, rt) == RES_OK) return RES_OK;  /* Let the device clear the block if possible */
+#endif
+    mem_set(buf, 0, (UINT)(((nsect > sz_buf) ? sz_buf : nsect) * ss));
+    do {    /* Fill the block with zero-filled buffer */
+        n = (nsect > sz_buf) ? sz_buf : nsect;
+        if (disk_write(pdrv, buf, sect, (UINT)n) != RES_OK) return RES_ERROR;
+        sect += n; nsect -= n;
+    } while (nsect);
+    return RES_OK;
+}
+
+
+FRESULT f_mkfs (
+    const TCHAR* path,  /* Logical drive number */
+    BYTE opt,           /* Format option */
+    DWORD au,           /* Size of allocation unit (cluster) [byte] */
+    void* work,         /* Pointer to working buffer (null: use heap memory) */
+    UINT len            /* Size of working buffer [byte] */
+)
+{
+    const UINT n_fats = 1;      /* Number of FATs for FAT/FAT32 volume (1 or 2) */
+    const UINT n_rootdir = 512; /* Number of root directory entries for FAT volume */
+    static const WORD cst[] = {1, 4, 16, 64, 256, 512, 0};  /* Cluster size boundary for FAT volume (4Ks unit) */
+    static const WORD cst32[] = {1, 2, 4, 8, 16, 32, 0};    /* Cluster size boundary for FAT32 volume (128Ks unit) */
+    BYTE fmt, sys, *buf, *pte, pdrv, part;
+    WORD ss;    /* Sector size */
+    DWORD szb_buf, sz_buf, sz_blk, n_clst, pau, sect, nsect, n;
+    DWORD b_vol, b_fat, b_data;             /* Base LBA for volume, fat, data */
+    DWORD sz_vol, sz_rsv, sz_fat, sz_dir;   /* Size for volume, fat, dir, data */
+    UINT i;
+    int vol;
+    DSTATUS stat;
+#if FF_USE_TRIM || FF_FS_EXFAT
+    DWORD tbl[3];
+#endif
+    DEF_TRACE(FTO_MKFS)
+
+
+    /* Check mounted drive and clear work area */
+    vol = get_ldnumber(&path);                  /* Get target logical drive */
+    if (vol < 0) EXIT_FF(FR_INVALID_DRIVE);
+    if (FatFs[vol]) FatFs[vol]->fs_type = 0;    /* Clear the volume if mounted */
+    pdrv = LD2PD(vol);  /* Physical drive */
+    part = LD2PT(vol);  /* Partition (0:create as new, 1-4:get from partition table) */
+
+    /* Check physical drive status */
+    stat = disk_initialize(pdrv);
+    if (stat & STA_NOINIT) EXIT_FF(FR_NOT_READY);
+    if (stat & STA_PROTECT) EXIT_FF(FR_WRITE_PROTECTED);
+    if (disk_ioctl(pdrv, GET_BLOCK_SIZE, &sz_blk) != RES_OK || !sz_blk || sz_blk > 32768 || (sz_blk & (sz_blk - 1))) sz_blk = 1;    /* Erase block to align data area */
+#if FF_MAX_SS != FF_MIN_SS      /* Get sector size of the medium if variable sector size cfg. */
+    if (disk_ioctl(pdrv, GET_SECTOR_SIZE, &ss) != RES_OK) EXIT_FF(FR_DISK_ERR);
+    if (ss > FF_MAX_SS || ss < FF_MIN_SS || (ss & (ss - 1))) EXIT_FF(FR_DISK_ERR);
 #else
     ss = FF_MAX_SS;
 #endif
-    if ((au != 0 && au < ss) || au > 0x1000000 || (au & (au - 1))) return FR_INVALID_PARAMETER; /* Check if au is valid */
+    if ((au != 0 && au < ss) || au > 0x1000000 || (au & (au - 1))) EXIT_FF(FR_INVALID_PARAMETER); /* Check if au is valid */
     au /= ss;   /* Cluster size in unit of sector */
 
     /* Get working buffer */
@@ -5584,7 +7391,7 @@ FRESULT f_mkfs (
         sz_buf = len / ss;      /* Size of working buffer (sector) */
         szb_buf = sz_buf * ss;  /* Size of working buffer (byte) */
     }
-    if (!buf || sz_buf == 0) return FR_NOT_ENOUGH_CORE;
+    if (!buf || sz_buf == 0) EXIT_FF(FR_NOT_ENOUGH_CORE);
 
     /* Determine where the volume to be located (b_vol, sz_vol) */
     if (FF_MULTI_PARTITION && part != 0) {
@@ -5626,10 +7433,11 @@ FRESULT f_mkfs (
         DWORD szb_bit, szb_case, sum, nb, cl;
         WCHAR ch, si;
         UINT j, st;
-        BYTE b;
+        BYTE b, *pb;
 
         if (sz_vol < 0x1000) LEAVE_MKFS(FR_MKFS_ABORTED);   /* Too small volume? */
 #if FF_USE_TRIM
+        MKFS_PHASE(FMP_ERASE);
         tbl[0] = b_vol; tbl[1] = b_vol + sz_vol - 1;    /* Inform the device the volume area may be erased */
         disk_ioctl(pdrv, CTRL_TRIM, tbl);
 #endif
@@ -5651,6 +7459,7 @@ FRESULT f_mkfs (
         tbl[0] = (szb_bit + au * ss - 1) / (au * ss);   /* Number of allocation bitmap clusters */
 
         /* Create a compressed up-case table */
+        MKFS_PHASE(FMP_UPCASE);
         sect = b_data + au * tbl[0];    /* Table start sector */
         sum = 0;                        /* Table checksum to be stored in the 82 entry */
         st = 0; si = 0; i = 0; j = 0; szb_case = 0;
@@ -5676,10 +7485,11 @@ FRESULT f_mkfs (
                 ch = (WCHAR)j; si += (WCHAR)j;  /* Number of chars to skip */
                 st = 0;
             }
-            sum = xsum32(buf[i + 0] = (BYTE)ch, sum);       /* Put it into the write buffer */
-            sum = xsum32(buf[i + 1] = (BYTE)(ch >> 8), sum);
+            buf[i + 0] = (BYTE)ch;          /* Put it into the write buffer */
+            buf[i + 1] = (BYTE)(ch >> 8);
             i += 2; szb_case += 2;
             if (si == 0 || i == szb_buf) {      /* Write buffered data when buffer full or end of process */
+                sum = xsum32(buf, i, sum);      /* Table checksum */
                 n = (i + ss - 1) / ss;
                 if (disk_write(pdrv, buf, sect, n) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);
                 sect += n; i = 0;
@@ -5689,18 +7499,22 @@ FRESULT f_mkfs (
         tbl[2] = 1;                                     /* Number of root dir clusters */
 
         /* Initialize the allocation bitmap */
+        MKFS_PHASE(FMP_BITMAP);
         sect = b_data; nsect = (szb_bit + ss - 1) / ss; /* Start of bitmap and number of sectors */
         nb = tbl[0] + tbl[1] + tbl[2];                  /* Number of clusters in-use by system */
         do {
             mem_set(buf, 0, szb_buf);
             for (i = 0; nb >= 8 && i < szb_buf; buf[i++] = 0xFF, nb -= 8) ;
             for (b = 1; nb != 0 && i < szb_buf; buf[i] |= b, b <<= 1, nb--) ;
-            n = (nsect > sz_buf) ? sz_buf : nsect;      /* Write the buffered data */
+            n = (nb == 0 && i < szb_buf) ? i / ss + 1 : sz_buf; /* Write the buffered data (only sectors with in-use bits at last) */
+            if (n > nsect) n = nsect;
             if (disk_write(pdrv, buf, sect, n) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);
             sect += n; nsect -= n;
-        } while (nsect);
+        } while (nb != 0 && nsect);
+        if (fill_zero(pdrv, sect, nsect, buf, sz_buf, ss) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);  /* Clear rest of the bitmap */
 
         /* Initialize the FAT */
+        MKFS_PHASE(FMP_FAT);
         sect = b_fat; nsect = sz_fat;   /* Start of FAT and number of FAT sectors */
         j = nb = cl = 0;
         do {
@@ -5716,13 +7530,16 @@ FRESULT f_mkfs (
                 }
                 if (nb == 0 && j < 3) nb = tbl[j++];    /* Next chain */
             } while (nb != 0 && i < szb_buf);
-            n = (nsect > sz_buf) ? sz_buf : nsect;  /* Write the buffered data */
+            n = (nb == 0) ? (i + ss - 1) / ss : sz_buf; /* Write the buffered data (only sectors with the chains at last) */
+            if (n > nsect) n = nsect;
             if (disk_write(pdrv, buf, sect, n) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);
             sect += n; nsect -= n;
-        } while (nsect);
+        } while (nb != 0 && nsect);
+        if (fill_zero(pdrv, sect, nsect, buf, sz_buf, ss) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);  /* Clear rest of the FAT */
 
         /* Initialize the root directory */
-        mem_set(buf, 0, szb_buf);
+        MKFS_PHASE(FMP_ROOT);
+        mem_set(buf, 0, ss);
         buf[SZDIRE * 0 + 0] = ET_VLABEL;        /* Volume label entry */
         buf[SZDIRE * 1 + 0] = ET_BITMAP;        /* Bitmap entry */
         st_dword(buf + SZDIRE * 1 + 20, 2);             /* cluster */
@@ -5732,54 +7549,47 @@ FRESULT f_mkfs (
         st_dword(buf + SZDIRE * 2 + 20, 2 + tbl[0]);    /* cluster */
         st_dword(buf + SZDIRE * 2 + 24, szb_case);      /* size */
         sect = b_data + au * (tbl[0] + tbl[1]); nsect = au; /* Start of the root directory and number of sectors */
-        do {    /* Fill root directory sectors */
-            n = (nsect > sz_buf) ? sz_buf : nsect;
-            if (disk_write(pdrv, buf, sect, n) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);
-            mem_set(buf, 0, ss);
-            sect += n; nsect -= n;
-        } while (nsect);
+        if (disk_write(pdrv, buf, sect, 1) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);  /* Write the entries */
+        if (fill_zero(pdrv, sect + 1, nsect - 1, buf, sz_buf, ss) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);  /* Clear rest of the cluster */
 
-        /* Create two set of the exFAT VBR blocks */
-        sect = b_vol;
+        /* Create two set of the exFAT VBR blocks (in multiple sector write as possible) */
+        MKFS_PHASE(FMP_VBR);
+        sect = b_vol; nsect = 0;    /* Write sector and number of sectors buffered */
         for (n = 0; n < 2; n++) {
-            /* Main record (+0) */
-            mem_set(buf, 0, ss);
-            mem_cpy(buf + BS_JmpBoot, "\xEB\x76\x90" "EXFAT   ", 11);   /* Boot jump code (x86), OEM name */
-            st_dword(buf + BPB_VolOfsEx, b_vol);                    /* Volume offset in the physical drive [sector] */
-            st_dword(buf + BPB_TotSecEx, sz_vol);                   /* Volume size [sector] */
-            st_dword(buf + BPB_FatOfsEx, b_fat - b_vol);            /* FAT offset [sector] */
-            st_dword(buf + BPB_FatSzEx, sz_fat);                    /* FAT size [sector] */
-            st_dword(buf + BPB_DataOfsEx, b_data - b_vol);          /* Data offset [sector] */
-            st_dword(buf + BPB_NumClusEx, n_clst);                  /* Number of clusters */
-            st_dword(buf + BPB_RootClusEx, 2 + tbl[0] + tbl[1]);    /* Root dir cluster # */
-            st_dword(buf + BPB_VolIDEx, GET_FATTIME());             /* VSN */
-            st_word(buf + BPB_FSVerEx, 0x100);                      /* Filesystem version (1.00) */
-            for (buf[BPB_BytsPerSecEx] = 0, i = ss; i >>= 1; buf[BPB_BytsPerSecEx]++) ; /* Log2 of sector size [byte] */
-            for (buf[BPB_SecPerClusEx] = 0, i = au; i >>= 1; buf[BPB_SecPerClusEx]++) ; /* Log2 of cluster size [sector] */
-            buf[BPB_NumFATsEx] = 1;                 /* Number of FATs */
-            buf[BPB_DrvNumEx] = 0x80;               /* Drive number (for int13) */
-            st_word(buf + BS_BootCodeEx, 0xFEEB);   /* Boot code (x86) */
-            st_word(buf + BS_55AA, 0xAA55);         /* Signature (placed here regardless of sector size) */
-            for (i = sum = 0; i < ss; i++) {        /* VBR checksum */
-                if (i != BPB_VolFlagEx && i != BPB_VolFlagEx + 1 && i != BPB_PercInUseEx) sum = xsum32(buf[i], sum);
-            }
-            if (disk_write(pdrv, buf, sect++, 1) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);
-            /* Extended bootstrap record (+1..+8) */
-            mem_set(buf, 0, ss);
-            st_word(buf + ss - 2, 0xAA55);  /* Signature (placed at end of sector) */
-            for (j = 1; j < 9; j++) {
-                for (i = 0; i < ss; sum = xsum32(buf[i++], sum)) ;  /* VBR checksum */
-                if (disk_write(pdrv, buf, sect++, 1) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);
-            }
-            /* OEM/Reserved record (+9..+10) */
-            mem_set(buf, 0, ss);
-            for ( ; j < 11; j++) {
-                for (i = 0; i < ss; sum = xsum32(buf[i++], sum)) ;  /* VBR checksum */
-                if (disk_write(pdrv, buf, sect++, 1) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);
+            for (j = 0; j < 12; j++) {
+                pb = buf + nsect * ss;  /* Sector to be created in the buffer */
+                mem_set(pb, 0, ss);
+                if (j == 0) {           /* Main record (+0) */
+                    mem_cpy(pb + BS_JmpBoot, "\xEB\x76\x90" "EXFAT   ", 11);    /* Boot jump code (x86), OEM name */
+                    st_dword(pb + BPB_VolOfsEx, b_vol);                     /* Volume offset in the physical drive [sector] */
+                    st_dword(pb + BPB_TotSecEx, sz_vol);                    /* Volume size [sector] */
+                    st_dword(pb + BPB_FatOfsEx, b_fat - b_vol);             /* FAT offset [sector] */
+                    st_dword(pb + BPB_FatSzEx, sz_fat);                     /* FAT size [sector] */
+                    st_dword(pb + BPB_DataOfsEx, b_data - b_vol);           /* Data offset [sector] */
+                    st_dword(pb + BPB_NumClusEx, n_clst);                   /* Number of clusters */
+                    st_dword(pb + BPB_RootClusEx, 2 + tbl[0] + tbl[1]);     /* Root dir cluster # */
+                    st_dword(pb + BPB_VolIDEx, GET_FATTIME());              /* VSN */
+                    st_word(pb + BPB_FSVerEx, 0x100);                       /* Filesystem version (1.00) */
+                    for (pb[BPB_BytsPerSecEx] = 0, i = ss; i >>= 1; pb[BPB_BytsPerSecEx]++) ;  /* Log2 of sector size [byte] */
+                    for (pb[BPB_SecPerClusEx] = 0, i = au; i >>= 1; pb[BPB_SecPerClusEx]++) ;  /* Log2 of cluster size [sector] */
+                    pb[BPB_NumFATsEx] = 1;                  /* Number of FATs */
+                    pb[BPB_DrvNumEx] = 0x80;                /* Drive number (for int13) */
+                    st_word(pb + BS_BootCodeEx, 0xFEEB);    /* Boot code (x86) */
+                    st_word(pb + BS_55AA, 0xAA55);          /* Signature (placed here regardless of sector size) */
+                    sum = xsum32(pb, BPB_VolFlagEx, 0);     /* VBR checksum (excluding BPB_VolFlagEx and BPB_PercInUseEx) */
+                    sum = xsum32(pb + BPB_VolFlagEx + 2, BPB_PercInUseEx - BPB_VolFlagEx - 2, sum);
+                    sum = xsum32(pb + BPB_PercInUseEx + 1, ss - BPB_PercInUseEx - 1, sum);
+                } else if (j < 11) {    /* Extended bootstrap record (+1..+8), OEM/Reserved record (+9..+10) */
+                    if (j < 9) st_word(pb + ss - 2, 0xAA55);    /* Signature (placed at end of sector) */
+                    sum = xsum32(pb, ss, sum);  /* VBR checksum */
+                } else {                /* Sum record (+11) */
+                    for (i = 0; i < ss; i += 4) st_dword(pb + i, sum);  /* Fill with checksum value */
+                }
+                if (++nsect == sz_buf || (n == 1 && j == 11)) {     /* Write the buffered sectors */
+                    if (disk_write(pdrv, buf, sect, nsect) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);
+                    sect += nsect; nsect = 0;
+                }
             }
-            /* Sum record (+11) */
-            for (i = 0; i < ss; i += 4) st_dword(buf + i, sum);     /* Fill with checksum value */
-            if (disk_write(pdrv, buf, sect++, 1) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);
         }
 
     } else
@@ -5857,10 +7667,12 @@ FRESULT f_mkfs (
         } while (1);
 
 #if FF_USE_TRIM
+        MKFS_PHASE(FMP_ERASE);
         tbl[0] = b_vol; tbl[1] = b_vol + sz_vol - 1;    /* Inform the device the volume area can be erased */
         disk_ioctl(pdrv, CTRL_TRIM, tbl);
 #endif
         /* Create FAT VBR */
+        MKFS_PHASE(FMP_VBR);
         mem_set(buf, 0, ss);
         mem_cpy(buf + BS_JmpBoot, "\xEB\xFE\x90" "MSDOS5.0", 11);/* Boot jump code (x86), OEM name */
         st_word(buf + BPB_BytsPerSec, ss);              /* Sector size [byte] */
@@ -5894,25 +7706,38 @@ FRESULT f_mkfs (
             mem_cpy(buf + BS_VolLab, "NO NAME    " "FAT     ", 19); /* Volume label, FAT signature */
         }
         st_word(buf + BS_55AA, 0xAA55);                 /* Signature (offset is fixed here regardless of sector size) */
-        if (disk_write(pdrv, buf, b_vol, 1) != RES_OK) LEAVE_MKFS(FR_DISK_ERR); /* Write it to the VBR sector */
 
-        /* Create FSINFO record if needed */
-        if (fmt == FS_FAT32) {
-            disk_write(pdrv, buf, b_vol + 6, 1);        /* Write backup VBR (VBR + 6) */
-            mem_set(buf, 0, ss);
-            st_dword(buf + FSI_LeadSig, 0x41615252);
-            st_dword(buf + FSI_StrucSig, 0x61417272);
-            st_dword(buf + FSI_Free_Count, n_clst - 1); /* Number of free clusters */
-            st_dword(buf + FSI_Nxt_Free, 2);            /* Last allocated cluster# */
-            st_word(buf + BS_55AA, 0xAA55);
-            disk_write(pdrv, buf, b_vol + 7, 1);        /* Write backup FSINFO (VBR + 7) */
-            disk_write(pdrv, buf, b_vol + 1, 1);        /* Write original FSINFO (VBR + 1) */
+        if (fmt == FS_FAT32 && szb_buf >= (DWORD)ss * 8) {   /* FAT32: Create VBR, FSINFO and their backup in the buffer and write them at a time */
+            mem_set(buf + ss, 0, ss * 7);
+            st_dword(buf + ss + FSI_LeadSig, 0x41615252);
+            st_dword(buf + ss + FSI_StrucSig, 0x61417272);
+            st_dword(buf + ss + FSI_Free_Count, n_clst - 1);    /* Number of free clusters */
+            st_dword(buf + ss + FSI_Nxt_Free, 2);               /* Last allocated cluster# */
+            st_word(buf + ss + BS_55AA, 0xAA55);
+            mem_cpy(buf + ss * 6, buf, ss * 2);                 /* Backup VBR (VBR + 6) and FSINFO (VBR + 7) */
+            if (disk_write(pdrv, buf, b_vol, 8) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);
+        } else {
+            if (disk_write(pdrv, buf, b_vol, 1) != RES_OK) LEAVE_MKFS(FR_DISK_ERR); /* Write it to the VBR sector */
+
+            /* Create FSINFO record if needed */
+            if (fmt == FS_FAT32) {
+                disk_write(pdrv, buf, b_vol + 6, 1);        /* Write backup VBR (VBR + 6) */
+                mem_set(buf, 0, ss);
+                st_dword(buf + FSI_LeadSig, 0x41615252);
+                st_dword(buf + FSI_StrucSig, 0x61417272);
+                st_dword(buf + FSI_Free_Count, n_clst - 1); /* Number of free clusters */
+                st_dword(buf + FSI_Nxt_Free, 2);            /* Last allocated cluster# */
+                st_word(buf + BS_55AA, 0xAA55);
+                disk_write(pdrv, buf, b_vol + 7, 1);        /* Write backup FSINFO (VBR + 7) */
+                disk_write(pdrv, buf, b_vol + 1, 1);        /* Write original FSINFO (VBR + 1) */
+            }
         }
 
         /* Initialize FAT area */
-        mem_set(buf, 0, (UINT)szb_buf);
+        MKFS_PHASE(FMP_FAT);
         sect = b_fat;       /* FAT start sector */
         for (i = 0; i < n_fats; i++) {          /* Initialize FATs each */
+            mem_set(buf, 0, ss);
             if (fmt == FS_FAT32) {
                 st_dword(buf + 0, 0xFFFFFFF8);  /* Entry 0 */
                 st_dword(buf + 4, 0xFFFFFFFF);  /* Entry 1 */
@@ -5920,22 +7745,15 @@ FRESULT f_mkfs (
             } else {
                 st_dword(buf + 0, (fmt == FS_FAT12) ? 0xFFFFF8 : 0xFFFFFFF8);   /* Entry 0 and 1 */
             }
-            nsect = sz_fat;     /* Number of FAT sectors */
-            do {    /* Fill FAT sectors */
-                n = (nsect > sz_buf) ? sz_buf : nsect;
-                if (disk_write(pdrv, buf, sect, (UINT)n) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);
-                mem_set(buf, 0, ss);
-                sect += n; nsect -= n;
-            } while (nsect);
+            if (disk_write(pdrv, buf, sect, 1) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);  /* Write the first FAT sector */
+            if (fill_zero(pdrv, sect + 1, sz_fat - 1, buf, sz_buf, ss) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);  /* Clear rest of the FAT */
+            sect += sz_fat;
         }
 
         /* Initialize root directory (fill with zero) */
+        MKFS_PHASE(FMP_ROOT);
         nsect = (fmt == FS_FAT32) ? pau : sz_dir;   /* Number of root directory sectors */
-        do {
-            n = (nsect > sz_buf) ? sz_buf : nsect;
-            if (disk_write(pdrv, buf, sect, (UINT)n) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);
-            sect += n; nsect -= n;
-        } while (nsect);
+        if (fill_zero(pdrv, sect, nsect, buf, sz_buf, ss) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);
     }
 
     /* Determine system ID in the partition table */
@@ -5954,6 +7772,7 @@ FRESULT f_mkfs (
     }
 
     /* Update partition information */
+    MKFS_PHASE(FMP_PART);
     if (FF_MULTI_PARTITION && part != 0) {  /* Created in the existing partition */
         /* Update system ID in the partition table */
         if (disk_read(pdrv, buf, 0, 1) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);  /* Read the MBR */
@@ -5979,8 +7798,10 @@ FRESULT f_mkfs (
         }
     }
 
+    MKFS_PHASE(FMP_SYNC);
     if (disk_ioctl(pdrv, CTRL_SYNC, 0) != RES_OK) LEAVE_MKFS(FR_DISK_ERR);
 
+    MKFS_PHASE(FMP_DONE);
     LEAVE_MKFS(FR_OK);
 }
 
@@ -6002,18 +7823,19 @@ FRESULT f_fdisk (
     DSTATUS stat;
     DWORD sz_disk, sz_part, s_part;
     FRESULT res;
+    DEF_TRACE(FTO_FDISK)
 
 
     stat = disk_initialize(pdrv);
-    if (stat & STA_NOINIT) return FR_NOT_READY;
-    if (stat & STA_PROTECT) return FR_WRITE_PROTECTED;
-    if (disk_ioctl(pdrv, GET_SECTOR_COUNT, &sz_disk)) return FR_DISK_ERR;
+    if (stat & STA_NOINIT) EXIT_FF(FR_NOT_READY);
+    if (stat & STA_PROTECT) EXIT_FF(FR_WRITE_PROTECTED);
+    if (disk_ioctl(pdrv, GET_SECTOR_COUNT, &sz_disk)) EXIT_FF(FR_DISK_ERR);
 
     buf = (BYTE*)work;
 #if FF_USE_LFN == 3
     if (!buf) buf = ff_memalloc(FF_MAX_SS); /* Use heap memory for working buffer */
 #endif
-    if (!buf) return FR_NOT_ENOUGH_CORE;
+    if (!buf) EXIT_FF(FR_NOT_ENOUGH_CORE);
 
     /* Determine the CHS without any consideration of the drive geometry */
     for (n = 16; n < 256 && sz_disk / n / 63 > 1024; n *= 2) ;
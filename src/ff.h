@@ -118,6 +118,35 @@ typedef DWORD FSIZE_t;
 
 
 
+/* Buffer segment structure for f_readv/f_writev (FFIOV) */
+
+typedef struct {
+    void*   buff;           /* Pointer to the buffer segment */
+    UINT    len;            /* Size of the buffer segment [byte] */
+} FFIOV;
+
+
+
+/* Volume statistics structure (FFSTATS) */
+
+typedef struct {
+    DWORD   n_rdcmd;        /* Number of disk_read() calls */
+    DWORD   n_rdsect;       /* Number of sectors read */
+    DWORD   n_wrcmd;        /* Number of disk_write() calls */
+    DWORD   n_wrsect;       /* Number of sectors written */
+    DWORD   n_sync;         /* Number of CTRL_SYNC requests */
+    DWORD   n_winhit;       /* Number of move_window() calls satisfied by the win[] */
+    DWORD   n_winmiss;      /* Number of move_window() calls that loaded a sector */
+    DWORD   n_winwb;        /* Number of dirty win[] write-backs */
+    DWORD   n_fat2wr;       /* Number of FAT sectors mirrored to the second FAT */
+    DWORD   n_getfat;       /* Number of FAT entry reads (get_fat) */
+    DWORD   n_putfat;       /* Number of FAT entry writes (put_fat) */
+    DWORD   n_dirscan;      /* Number of directory entries scanned in name search */
+    DWORD   n_clprobe;      /* Number of clusters probed in cluster allocation */
+} FFSTATS;
+
+
+
 /* Filesystem object structure (FATFS) */
 
 typedef struct {
@@ -131,6 +160,7 @@ typedef struct {
     WORD    csize;          /* Cluster size [sectors] */
 #if FF_MAX_SS != FF_MIN_SS
     WORD    ssize;          /* Sector size (512, 1024, 2048 or 4096) */
+    BYTE    ssshift;        /* Sector size in log2 (9, 10, 11 or 12) */
 #endif
 #if FF_USE_LFN
     WCHAR*  lfnbuf;         /* LFN working buffer */
@@ -145,6 +175,10 @@ typedef struct {
     DWORD   last_clst;      /* Last allocated cluster */
     DWORD   free_clst;      /* Number of free clusters */
 #endif
+#if FF_USE_TRIM && FF_TRIM_QUEUE && !FF_FS_READONLY
+    UINT    n_trim;         /* Number of cluster blocks in the discard queue */
+    DWORD   trimq[FF_TRIM_QUEUE][2];    /* Discard queue (first and last cluster of each freed block) */
+#endif
 #if FF_FS_RPATH
     DWORD   cdir;           /* Current directory start cluster (0:root) */
 #if FF_FS_EXFAT
@@ -164,6 +198,18 @@ typedef struct {
 #endif
     DWORD   winsect;        /* Current sector appearing in the win[] */
     BYTE    win[FF_MAX_SS]; /* Disk access window for Directory, FAT (and file data at tiny cfg) */
+#if !FF_FS_TINY && FF_FS_BUFPOOL
+    DWORD   pclk;           /* Access counter of the buffer pool */
+    DWORD   pstamp[FF_FS_BUFPOOL];  /* Last access count of each pool buffer */
+    void*   pown[FF_FS_BUFPOOL];    /* File object that owns each pool buffer (0:free) */
+#if FF_USE_MAPREAD
+    BYTE    ppin[FF_FS_BUFPOOL];    /* Pool buffer is pinned by f_map_read (1:pinned) */
+#endif
+    BYTE    pool[FF_FS_BUFPOOL][FF_MAX_SS]; /* Sector buffers shared by the files on the volume */
+#endif
+#if FF_USE_STATS
+    FFSTATS stats;          /* Volume statistics */
+#endif
 } FATFS;
 
 
@@ -208,8 +254,12 @@ typedef struct {
     DWORD*  cltbl;          /* Pointer to the cluster link map table (nulled on open, set by application) */
 #endif
 #if !FF_FS_TINY
+#if FF_FS_BUFPOOL
+    BYTE*   buf;            /* Pointer to the pool buffer assigned to the file (0:not assigned) */
+#else
     BYTE    buf[FF_MAX_SS]; /* File private data read/write window */
 #endif
+#endif
 } FIL;
 
 
@@ -284,9 +334,13 @@ FRESULT f_open (FIL* fp, const TCHAR* path, BYTE mode);             /* Open or c
 FRESULT f_close (FIL* fp);                                          /* Close an open file object */
 FRESULT f_read (FIL* fp, void* buff, UINT btr, UINT* br);           /* Read data from the file */
 FRESULT f_write (FIL* fp, const void* buff, UINT btw, UINT* bw);    /* Write data to the file */
+FRESULT f_readv (FIL* fp, const FFIOV* iov, UINT cnt, UINT* br);    /* Read data from the file into scattered buffers */
+FRESULT f_writev (FIL* fp, const FFIOV* iov, UINT cnt, UINT* bw);   /* Write data in scattered buffers to the file */
 FRESULT f_lseek (FIL* fp, FSIZE_t ofs);                             /* Move file pointer of the file object */
 FRESULT f_truncate (FIL* fp);                                       /* Truncate the file */
 FRESULT f_sync (FIL* fp);                                           /* Flush cached data of the writing file */
+FRESULT f_datasync (FIL* fp);                                       /* Flush cached data and allocation information of the writing file */
+FRESULT f_sync_many (FIL* fps[], UINT nf);                          /* Flush cached data of the writing files on a volume at a time */
 FRESULT f_opendir (DIR* dp, const TCHAR* path);                     /* Open a directory */
 FRESULT f_closedir (DIR* dp);                                       /* Close an open directory */
 FRESULT f_readdir (DIR* dp, FILINFO* fno);                          /* Read a directory item */
@@ -305,7 +359,18 @@ FRESULT f_getfree (const TCHAR* path, DWORD* nclst, FATFS** fatfs); /* Get numbe
 FRESULT f_getlabel (const TCHAR* path, TCHAR* label, DWORD* vsn);   /* Get volume label */
 FRESULT f_setlabel (const TCHAR* label);                            /* Set volume label */
 FRESULT f_forward (FIL* fp, UINT(*func)(const BYTE*,UINT), UINT btf, UINT* bf); /* Forward data to the stream */
+FRESULT f_map_read (FIL* fp, FSIZE_t ofs, const void** ptr, UINT* len);    /* Get pointer to the file data in the sector buffer */
+FRESULT f_map_release (FIL* fp);                                    /* Release the file data mapped by f_map_read */
 FRESULT f_expand (FIL* fp, FSIZE_t szf, BYTE opt);                  /* Allocate a contiguous block to the file */
+FRESULT f_defrag (FIL* fp, void* work, UINT len);                   /* Relocate the file data into a contiguous block */
+FRESULT f_copy (const TCHAR* path_old, const TCHAR* path_new, void* work, UINT len);   /* Copy a file */
+FRESULT f_trim_flush (const TCHAR* path);                           /* Issue the queued discards to the drive */
+FRESULT f_trim_free (const TCHAR* path);                            /* Discard all free clusters on the drive */
+FRESULT f_getstats (const TCHAR* path, FFSTATS* st);                /* Get statistics of the drive */
+FRESULT f_resetstats (const TCHAR* path);                           /* Clear statistics of the drive */
+FRESULT f_trace_hist (BYTE op, DWORD* hist);                        /* Get latency histogram of an operation */
+UINT f_trace_dump (void* buff, UINT len);                           /* Move out the records in the trace buffer */
+void f_trace_clear (void);                                          /* Clear the histograms and the trace buffer */
 FRESULT f_mount (FATFS* fs, const TCHAR* path, BYTE opt);           /* Mount/Unmount a logical drive */
 FRESULT f_mkfs (const TCHAR* path, BYTE opt, DWORD au, void* work, UINT len);   /* Create a FAT volume */
 FRESULT f_fdisk (BYTE pdrv, const DWORD* szt, void* work);          /* Divide a physical drive into some partitions */
@@ -350,6 +415,20 @@ void* ff_memalloc (UINT msize);         /* Allocate memory block */
 void ff_memfree (void* mblock);         /* Free memory block */
 #endif
 
+/* Progress report function */
+#if FF_USE_MKFS && FF_MKFS_PHASE && !FF_FS_READONLY
+void ff_mkfs_phase (BYTE phase);        /* Called at start of each f_mkfs phase (FMP_*) */
+#endif
+
+/* Trace functions */
+#if FF_USE_TRACE
+DWORD ff_trace_clock (void);            /* Get current time in arbitrary tick unit */
+#if FF_USE_TRACE == 2
+void ff_trace_begin (BYTE op);          /* Called at start of each operation (FTO_*) */
+void ff_trace_end (BYTE op, UINT res, DWORD tick);  /* Called at end of each operation with the result and elapsed time */
+#endif
+#endif
+
 /* Sync functions */
 #if FF_FS_REENTRANT
 int ff_cre_syncobj (BYTE vol, FF_SYNC_t* sobj); /* Create a sync object */
@@ -384,6 +463,67 @@ int ff_del_syncobj (FF_SYNC_t sobj);    /* Delete a sync object */
 #define FM_ANY      0x07
 #define FM_SFD      0x08
 
+/* Phase of f_mkfs (argument of ff_mkfs_phase) */
+#define FMP_DONE    0
+#define FMP_ERASE   1
+#define FMP_UPCASE  2
+#define FMP_BITMAP  3
+#define FMP_FAT     4
+#define FMP_ROOT    5
+#define FMP_VBR     6
+#define FMP_PART    7
+#define FMP_SYNC    8
+
+/* Operation ID of the trace (FF_USE_TRACE) */
+#define FTO_MOUNT       0x00
+#define FTO_OPEN        0x01
+#define FTO_CLOSE       0x02
+#define FTO_READ        0x03
+#define FTO_WRITE       0x04
+#define FTO_LSEEK       0x05
+#define FTO_TRUNCATE    0x06
+#define FTO_SYNC        0x07
+#define FTO_DATASYNC    0x08
+#define FTO_SYNCMANY    0x09
+#define FTO_OPENDIR     0x0A
+#define FTO_CLOSEDIR    0x0B
+#define FTO_READDIR     0x0C
+#define FTO_MKDIR       0x0D
+#define FTO_UNLINK      0x0E
+#define FTO_RENAME      0x0F
+#define FTO_STAT        0x10
+#define FTO_CHMOD       0x11
+#define FTO_UTIME       0x12
+#define FTO_CHDIR       0x13
+#define FTO_GETCWD      0x14
+#define FTO_GETFREE     0x15
+#define FTO_GETLABEL    0x16
+#define FTO_SETLABEL    0x17
+#define FTO_FORWARD     0x18
+#define FTO_EXPAND      0x19
+#define FTO_DEFRAG      0x1A
+#define FTO_TRIMFLUSH   0x1B
+#define FTO_TRIMFREE    0x1C
+#define FTO_GETSTATS    0x1D
+#define FTO_RESETSTATS  0x1E
+#define FTO_MKFS        0x1F
+#define FTO_FDISK       0x20
+#define FTO_MAPREAD     0x21
+#define FTO_MAPRELEASE  0x22
+#define FTO_READV       0x23
+#define FTO_WRITEV      0x24
+#define FTO_COPY        0x25
+#define FTO_DISK_INIT   0x30
+#define FTO_DISK_STATUS 0x31
+#define FTO_DISK_READ   0x32
+#define FTO_DISK_WRITE  0x33
+#define FTO_DISK_IOCTL  0x34
+#define FTO_DISK_READV  0x35
+#define FTO_DISK_WRITEV 0x36
+#define FTO_NUM         0x37    /* Number of operation IDs */
+#define FTO_NBIN        24      /* Number of bins in a latency histogram */
+#define FTO_RECSIZE     16      /* Size of a trace record [byte] */
+
 /* Filesystem type (FATFS.fs_type) */
 #define FS_FAT12    1
 #define FS_FAT16    2
@@ -42,6 +42,12 @@
 /* This option switches f_mkfs() function. (0:Disable or 1:Enable) */
 
 
+#define FF_MKFS_PHASE   0
+/* This option switches progress report of f_mkfs() function. (0:Disable or 1:Enable)
+/  When enable, f_mkfs() calls a user defined function ff_mkfs_phase() at start of
+/  each phase and at completion with the phase code, FMP_*. */
+
+
 #define FF_USE_FASTSEEK 0
 /* This option switches fast seek function. (0:Disable or 1:Enable) */
 
@@ -50,6 +56,29 @@
 /* This option switches f_expand function. (0:Disable or 1:Enable) */
 
 
+#define FF_USE_DEFRAG   0
+/* This option switches f_defrag() function. (0:Disable or 1:Enable)
+/  Also FF_FS_READONLY needs to be 0 to enable this option. */
+
+
+#define FF_USE_COPY     0
+/* This option switches f_copy() function. (0:Disable, 1:Enable or 2:Enable with
+/  copy offload) At 2, f_copy() requests the device to copy the sectors with
+/  CTRL_COPY command of disk_ioctl() function and it falls back to read/write when
+/  the command failed. Also FF_FS_READONLY needs to be 0 and FF_FS_MINIMIZE needs
+/  to be 0 to enable this option. */
+
+
+#define FF_USE_DATASYNC 0
+/* This option switches f_datasync() function. (0:Disable or 1:Enable)
+/  Also FF_FS_READONLY needs to be 0 to enable this option. */
+
+
+#define FF_USE_SYNCMANY 0
+/* This option switches f_sync_many() function. (0:Disable or 1:Enable)
+/  Also FF_FS_READONLY needs to be 0 to enable this option. */
+
+
 #define FF_USE_CHMOD    0
 /* This option switches attribute manipulation functions, f_chmod() and f_utime().
 /  (0:Disable or 1:Enable) Also FF_FS_READONLY needs to be 0 to enable this option. */
@@ -64,6 +93,41 @@
 /* This option switches f_forward() function. (0:Disable or 1:Enable) */
 
 
+#define FF_USE_MAPREAD  0
+/* This option switches f_map_read() and f_map_release() function, which lend the
+/  file data in the sector buffer to the application without copying it.
+/  (0:Disable or 1:Enable) When FF_FS_BUFPOOL is not zero, a mapped pool buffer is
+/  pinned to the file until it is released and up to FF_FS_BUFPOOL - 1 files can
+/  hold a mapped buffer at a time, so that FF_FS_BUFPOOL = 1 is not allowed. */
+
+
+#define FF_USE_IOVEC    0
+/* This option switches vectored read/write functions, f_readv() and f_writev().
+/  (0:Disable or 1:Enable) f_writev() is available when FF_FS_READONLY == 0. */
+
+
+#define FF_USE_STATS    0
+/* This option switches volume statistics functions, f_getstats() and f_resetstats().
+/  (0:Disable or 1:Enable) When enabled, each filesystem object counts the disk
+/  accesses and the internal operations on the volume. The counters are cleared at
+/  mount and can be used to tune the cache and allocation options above. */
+
+
+#define FF_USE_TRACE    0
+#define FF_TRACE_BUF    0
+/* The FF_USE_TRACE switches the operation tracing of the API functions and the
+/  disk I/O functions.
+/
+/   0: Disable tracing. FF_TRACE_BUF has no effect.
+/   1: Enable latency histograms and trace buffer.
+/   2: Enable with user defined hook functions, ff_trace_begin() and ff_trace_end().
+/
+/  When enable, a user defined function ff_trace_clock() to get the current time
+/  needs to be added to the project. The FF_TRACE_BUF defines number of records
+/  held in the trace buffer, 0:no trace buffer. Each record occupies 16 bytes and
+/  the oldest record is overwritten when the buffer is full. */
+
+
 /*---------------------------------------------------------------------------/
 / Locale and Namespace Configurations
 /---------------------------------------------------------------------------*/
@@ -137,6 +201,25 @@
 /  on character encoding. When LFN is not enabled, these options have no effect. */
 
 
+#define FF_LFN_UPTBL    0
+/* This option switches the up-case conversion table used to compare the LFNs.
+/  (0:Compressed table or 1:Two-level table)
+/  The compressed table occupies about 0.7 KB and it is searched linearly. The
+/  two-level table occupies about 7.4 KB and the conversion is done in constant
+/  time. When LFN is not enabled, this option has no effect. */
+
+
+#define FF_LFN_CVTIDX   0
+/* This option switches the index tables to speed up the Unicode <=> OEM code
+/  conversion for the file names. (0:Disable or 1:Enable)
+/  When enabled, the conversion of SBCS code page finds the OEM code by a direct
+/  table of the main letters and binary search for others instead of linear search,
+/  and the conversion of DBCS code page narrows the binary search down to the
+/  codes with the same upper byte. It occupies 258 bytes for each SBCS code page
+/  and 1028 bytes for each DBCS code page (8498 bytes for all code pages at
+/  FF_CODE_PAGE = 0). When LFN is not enabled, this option has no effect. */
+
+
 #define FF_STRF_ENCODE  3
 /* When FF_LFN_UNICODE >= 1 with LFN enabled, string I/O functions, f_gets(),
 /  f_putc(), f_puts and f_printf() convert the character encoding in it.
@@ -201,9 +284,32 @@
 
 
 #define FF_USE_TRIM     0
-/* This option switches support for ATA-TRIM. (0:Disable or 1:Enable)
+#define FF_TRIM_QUEUE   0
+/* The FF_USE_TRIM switches support for ATA-TRIM. (0:Disable or 1:Enable)
 /  To enable Trim function, also CTRL_TRIM command should be implemented to the
-/  disk_ioctl() function. */
+/  disk_ioctl() function. f_trim_free() function is available when enabled.
+/  The FF_TRIM_QUEUE defines number of freed cluster blocks to be queued in the
+/  filesystem object. When it is 0, each freed block is discarded immediately.
+/  When it is 1 or larger, the freed blocks are merged and sorted in the queue
+/  and they are discarded when the queue gets full, at f_sync() or f_close()
+/  and by f_trim_flush() function. Each queued block occupies 8 bytes. */
+
+
+#define FF_USE_ZEROFILL 0
+/* This option switches zero fill request on the f_mkfs() function. (0:Disable or
+/  1:Enable) When enable, f_mkfs() requests the device to clear the FAT and directory
+/  area with CTRL_ZERO command of disk_ioctl() function instead of writing zeros.
+/  When the command fails, f_mkfs() writes zeros to the area as usual. */
+
+
+#define FF_DISK_NSEG    0
+/* This option enables the scatter list disk functions, disk_readv() and disk_writev().
+/
+/   0: Disable. The disk I/O module does not need to have them.
+/   2-255: Enable. A transfer that is split into some sector blocks is issued in a
+/          call with up to FF_DISK_NSEG blocks, i.e. f_read()/f_write() over the
+/          fragmented file data, reflection of the FAT sector to the 2nd FAT and
+/          write-back of the files at f_sync_many(). */
 
 
 #define FF_FS_NOFSINFO  0
@@ -230,12 +336,48 @@
 /  buffer in the filesystem object (FATFS) is used for the file data transfer. */
 
 
+#define FF_FS_BUFPOOL   0
+/* This option switches sector buffer pool for the file objects. (0:Disable or 1-255)
+/  When enabled, the private sector buffer is eliminated from the file object and
+/  each filesystem object (FATFS) holds FF_FS_BUFPOOL sector buffers shared by the
+/  open files on the volume instead. A buffer is assigned to the file on demand and
+/  the least recently used one is written-back and reassigned when no free buffer
+/  is left. Any file object opened with this option must be closed with f_close.
+/  This option has no effect at tiny configuration (FF_FS_TINY = 1). */
+
+
 #define FF_FS_EXFAT     0
 /* This option switches support for exFAT filesystem. (0:Disable or 1:Enable)
 /  To enable exFAT, also LFN needs to be enabled. (FF_USE_LFN >= 1)
 /  Note that enabling exFAT discards ANSI C (C89) compatibility. */
 
 
+#define FF_FS_FATTYPE   7
+/* This option specifies the FAT sub-types supported in addition to exFAT by bit
+/  mask. (bit0:FAT12, bit1:FAT16, bit2:FAT32)
+/  The volume in the FAT sub-type not specified here is rejected at mount. When only
+/  one type is supported (1, 2 or 4 without exFAT, or 0 with exFAT), the type checks
+/  in the module are resolved at compile time and the code for other types is
+/  removed. f_mkfs() is not affected by this option. */
+
+
+#define FF_USE_STDMEM   0
+/* This option switches the memory functions used to copy, fill and compare the
+/  data blocks in the module. (0:Built-in byte-by-byte loops or 1:memcpy(), memset()
+/  and memcmp() in the C standard library)
+/  The library functions process the data in word or wider unit and they are
+/  usually much faster than the built-in functions. */
+
+
+#define FF_WORD_ACCESS  0
+/* This option switches the access method to the multi-byte words in the FAT
+/  structure. (0:Byte-by-byte access or 1:Native word access)
+/  The byte-by-byte access is always compatible with all platforms. The native
+/  word access loads/stores the words with memcpy() that is compiled into a single
+/  load/store instruction on the processor which allows unaligned memory access.
+/  Do not enable this option unless the processor is little-endian. */
+
+
 #define FF_FS_NORTC     0
 #define FF_NORTC_MON    1
 #define FF_NORTC_MDAY   1
@@ -15214,6 +15214,529 @@ static const WCHAR uc869[] = {  /*  CP869(Greek 2) to Unicode conversion table *
 };
 #endif
 
+#if FF_LFN_CVTIDX && FF_CODE_PAGE < 900
+#if FF_CODE_PAGE == 437 || FF_CODE_PAGE == 0
+static const BYTE ri437[] = {  /*  CP437(US) Unicode to OEM conversion index (U+0080 - U+00FF direct) */
+    0x7F, 0x2D, 0x1B, 0x1C, 0x1D, 0x26, 0x2E, 0x2A, 0x78, 0x71, 0x7D, 0x66, 0x7A, 0x27, 0x2F, 0x2C,
+    0x2B, 0x28, 0x0E, 0x0F, 0x12, 0x00, 0x10, 0x25, 0x19, 0x1A, 0x61, 0x05, 0x20, 0x03, 0x04, 0x06,
+    0x11, 0x07, 0x0A, 0x02, 0x08, 0x09, 0x0D, 0x21, 0x0C, 0x0B, 0x24, 0x15, 0x22, 0x13, 0x14, 0x76,
+    0x17, 0x23, 0x16, 0x01, 0x18, 0x1F, 0x62, 0x69, 0x64, 0x68, 0x6A, 0x60, 0x6B, 0x6E, 0x63, 0x65,
+    0x67, 0x6D, 0x7C, 0x1E, 0x79, 0x7B, 0x6C, 0x6F, 0x77, 0x70, 0x73, 0x72, 0x29, 0x74, 0x75, 0x44,
+    0x33, 0x5A, 0x3F, 0x40, 0x59, 0x43, 0x34, 0x42, 0x41, 0x45, 0x4D, 0x3A, 0x55, 0x56, 0x49, 0x38,
+    0x37, 0x3B, 0x54, 0x53, 0x48, 0x3E, 0x3D, 0x3C, 0x46, 0x47, 0x4C, 0x35, 0x36, 0x39, 0x51, 0x52,
+    0x4B, 0x4F, 0x50, 0x4A, 0x58, 0x57, 0x4E, 0x5F, 0x5C, 0x5B, 0x5D, 0x5E, 0x30, 0x31, 0x32, 0x7E,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xFF, 0xAD, 0x9B, 0x9C, 0x00, 0x9D, 0x00, 0x00, 0x00, 0x00, 0xA6, 0xAE, 0xAA, 0x00, 0x00, 0x00,
+    0xF8, 0xF1, 0xFD, 0x00, 0x00, 0xE6, 0x00, 0xFA, 0x00, 0x00, 0xA7, 0xAF, 0xAC, 0xAB, 0x00, 0xA8,
+    0x00, 0x00, 0x00, 0x00, 0x8E, 0x8F, 0x92, 0x80, 0x00, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xA5, 0x00, 0x00, 0x00, 0x00, 0x99, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9A, 0x00, 0x00, 0xE1,
+    0x85, 0xA0, 0x83, 0x00, 0x84, 0x86, 0x91, 0x87, 0x8A, 0x82, 0x88, 0x89, 0x8D, 0xA1, 0x8C, 0x8B,
+    0x00, 0xA4, 0x95, 0xA2, 0x93, 0x00, 0x94, 0xF6, 0x00, 0x97, 0xA3, 0x96, 0x81, 0x00, 0x00, 0x98,
+    0x80, 0x00
+};
+#endif
+#if FF_CODE_PAGE == 720 || FF_CODE_PAGE == 0
+static const BYTE ri720[] = {  /*  CP720(Arabic) Unicode to OEM conversion index (U+0600 - U+067F direct) */
+    0x00, 0x01, 0x04, 0x06, 0x0D, 0x0E, 0x0F, 0x10, 0x7F, 0x1C, 0x14, 0x2E, 0x78, 0x7D, 0x66, 0x7A,
+    0x2F, 0x05, 0x03, 0x07, 0x0A, 0x02, 0x08, 0x09, 0x0C, 0x0B, 0x13, 0x17, 0x16, 0x18, 0x19, 0x1A,
+    0x1B, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B,
+    0x2C, 0x2D, 0x60, 0x61, 0x62, 0x63, 0x64, 0x15, 0x65, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D,
+    0x6E, 0x6F, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x11, 0x12, 0x7C, 0x79, 0x7B, 0x77, 0x70, 0x44,
+    0x33, 0x5A, 0x3F, 0x40, 0x59, 0x43, 0x34, 0x42, 0x41, 0x45, 0x4D, 0x3A, 0x55, 0x56, 0x49, 0x38,
+    0x37, 0x3B, 0x54, 0x53, 0x48, 0x3E, 0x3D, 0x3C, 0x46, 0x47, 0x4C, 0x35, 0x36, 0x39, 0x51, 0x52,
+    0x4B, 0x4F, 0x50, 0x4A, 0x58, 0x57, 0x4E, 0x5F, 0x5C, 0x5B, 0x5D, 0x5E, 0x30, 0x31, 0x32, 0x7E,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x98, 0x99, 0x9A, 0x9B, 0x9D, 0x9E, 0x9F, 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7,
+    0xA8, 0xA9, 0xAA, 0xAB, 0xAC, 0xAD, 0xE0, 0xE1, 0xE2, 0xE3, 0xE4, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x95, 0xE5, 0xE7, 0xE8, 0xE9, 0xEA, 0xEB, 0xEC, 0xED, 0xEE, 0xEF, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5,
+    0xF6, 0x91, 0x92, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x06
+};
+#endif
+#if FF_CODE_PAGE == 737 || FF_CODE_PAGE == 0
+static const BYTE ri737[] = {  /*  CP737(Greek) Unicode to OEM conversion index (U+0380 - U+03FF direct) */
+    0x7F, 0x78, 0x71, 0x7D, 0x7A, 0x76, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F, 0x70, 0x00, 0x01, 0x02,
+    0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12,
+    0x13, 0x14, 0x15, 0x16, 0x17, 0x74, 0x75, 0x61, 0x62, 0x63, 0x65, 0x18, 0x19, 0x1A, 0x1B, 0x1C,
+    0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x2A, 0x29, 0x2B, 0x2C,
+    0x2D, 0x2E, 0x2F, 0x60, 0x64, 0x68, 0x66, 0x67, 0x69, 0x7C, 0x79, 0x7B, 0x77, 0x73, 0x72, 0x44,
+    0x33, 0x5A, 0x3F, 0x40, 0x59, 0x43, 0x34, 0x42, 0x41, 0x45, 0x4D, 0x3A, 0x55, 0x56, 0x49, 0x38,
+    0x37, 0x3B, 0x54, 0x53, 0x48, 0x3E, 0x3D, 0x3C, 0x46, 0x47, 0x4C, 0x35, 0x36, 0x39, 0x51, 0x52,
+    0x4B, 0x4F, 0x50, 0x4A, 0x58, 0x57, 0x4E, 0x5F, 0x5C, 0x5B, 0x5D, 0x5E, 0x30, 0x31, 0x32, 0x7E,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xEA, 0x00, 0xEB, 0xEC, 0xED, 0x00, 0xEE, 0x00, 0xEF, 0xF0,
+    0x00, 0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E,
+    0x8F, 0x90, 0x00, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0xF4, 0xF5, 0xE1, 0xE2, 0xE3, 0xE5,
+    0x00, 0x98, 0x99, 0x9A, 0x9B, 0x9C, 0x9D, 0x9E, 0x9F, 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6,
+    0xA7, 0xA8, 0xAA, 0xA9, 0xAB, 0xAC, 0xAD, 0xAE, 0xAF, 0xE0, 0xE4, 0xE8, 0xE6, 0xE7, 0xE9, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0x03
+};
+#endif
+#if FF_CODE_PAGE == 771 || FF_CODE_PAGE == 0
+static const BYTE ri771[] = {  /*  CP771(KBL) Unicode to OEM conversion index (U+0400 - U+047F direct) */
+    0x7F, 0x5C, 0x5D, 0x5E, 0x5F, 0x72, 0x73, 0x70, 0x71, 0x74, 0x75, 0x76, 0x77, 0x7A, 0x7B, 0x78,
+    0x79, 0x7C, 0x7D, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C,
+    0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C,
+    0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C,
+    0x2D, 0x2E, 0x2F, 0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C,
+    0x6D, 0x6E, 0x6F, 0x44, 0x33, 0x5A, 0x3F, 0x40, 0x59, 0x43, 0x34, 0x42, 0x41, 0x45, 0x4D, 0x3A,
+    0x55, 0x56, 0x49, 0x38, 0x37, 0x3B, 0x3E, 0x54, 0x53, 0x48, 0x3D, 0x3C, 0x46, 0x47, 0x4C, 0x35,
+    0x36, 0x39, 0x51, 0x52, 0x4B, 0x4F, 0x50, 0x4A, 0x58, 0x57, 0x4E, 0x5B, 0x30, 0x31, 0x32, 0x7E,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F,
+    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0x9B, 0x9C, 0x9D, 0x9E, 0x9F,
+    0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xAB, 0xAC, 0xAD, 0xAE, 0xAF,
+    0xE0, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xEB, 0xEC, 0xED, 0xEE, 0xEF,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x04
+};
+#endif
+#if FF_CODE_PAGE == 775 || FF_CODE_PAGE == 0
+static const BYTE ri775[] = {  /*  CP775(Baltic) Unicode to OEM conversion index (U+0100 - U+017F direct) */
+    0x7F, 0x16, 0x1C, 0x1F, 0x27, 0x75, 0x28, 0x2E, 0x2A, 0x70, 0x29, 0x78, 0x71, 0x7D, 0x7C, 0x66,
+    0x74, 0x7A, 0x7B, 0x2F, 0x2C, 0x2B, 0x73, 0x0E, 0x0F, 0x12, 0x10, 0x60, 0x65, 0x19, 0x1E, 0x1D,
+    0x1A, 0x61, 0x04, 0x06, 0x11, 0x02, 0x22, 0x64, 0x14, 0x76, 0x1B, 0x01, 0x20, 0x03, 0x35, 0x50,
+    0x00, 0x07, 0x36, 0x51, 0x6D, 0x09, 0x38, 0x53, 0x37, 0x52, 0x15, 0x05, 0x21, 0x0C, 0x3D, 0x54,
+    0x68, 0x69, 0x6A, 0x6B, 0x2D, 0x08, 0x63, 0x67, 0x6E, 0x6C, 0x62, 0x13, 0x0A, 0x0B, 0x17, 0x18,
+    0x3E, 0x55, 0x47, 0x57, 0x46, 0x56, 0x0D, 0x25, 0x23, 0x24, 0x4F, 0x58, 0x6F, 0x72, 0x26, 0x77,
+    0x79, 0x44, 0x33, 0x5A, 0x3F, 0x40, 0x59, 0x43, 0x34, 0x42, 0x41, 0x45, 0x4D, 0x3A, 0x49, 0x3B,
+    0x48, 0x3C, 0x4C, 0x39, 0x4B, 0x4A, 0x4E, 0x5F, 0x5C, 0x5B, 0x5D, 0x5E, 0x30, 0x31, 0x32, 0x7E,
+    0xA0, 0x83, 0x00, 0x00, 0xB5, 0xD0, 0x80, 0x87, 0x00, 0x00, 0x00, 0x00, 0xB6, 0xD1, 0x00, 0x00,
+    0x00, 0x00, 0xED, 0x89, 0x00, 0x00, 0xB8, 0xD3, 0xB7, 0xD2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x95, 0x85, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xA1, 0x8C, 0x00, 0x00, 0xBD, 0xD4,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE8, 0xE9, 0x00, 0x00, 0x00, 0xEA, 0xEB, 0x00, 0x00, 0x00,
+    0x00, 0xAD, 0x88, 0xE3, 0xE7, 0xEE, 0xEC, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE2, 0x93, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8A, 0x8B, 0x00, 0x00, 0x97, 0x98, 0x00, 0x00, 0x00, 0x00,
+    0xBE, 0xD5, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC7, 0xD7, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xC6, 0xD6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8D, 0xA5, 0xA3, 0xA4, 0xCF, 0xD8, 0x00,
+    0x00, 0x01
+};
+#endif
+#if FF_CODE_PAGE == 850 || FF_CODE_PAGE == 0
+static const BYTE ri850[] = {  /*  CP850(Latin 1) Unicode to OEM conversion index (U+0080 - U+00FF direct) */
+    0x7F, 0x2D, 0x3D, 0x1C, 0x4F, 0x3E, 0x5D, 0x75, 0x79, 0x38, 0x26, 0x2E, 0x2A, 0x70, 0x29, 0x6E,
+    0x78, 0x71, 0x7D, 0x7C, 0x6F, 0x66, 0x74, 0x7A, 0x77, 0x7B, 0x27, 0x2F, 0x2C, 0x2B, 0x73, 0x28,
+    0x37, 0x35, 0x36, 0x47, 0x0E, 0x0F, 0x12, 0x00, 0x54, 0x10, 0x52, 0x53, 0x5E, 0x56, 0x57, 0x58,
+    0x51, 0x25, 0x63, 0x60, 0x62, 0x65, 0x19, 0x1E, 0x1D, 0x6B, 0x69, 0x6A, 0x1A, 0x6D, 0x68, 0x61,
+    0x05, 0x20, 0x03, 0x46, 0x04, 0x06, 0x11, 0x07, 0x0A, 0x02, 0x08, 0x09, 0x0D, 0x21, 0x0C, 0x0B,
+    0x50, 0x24, 0x15, 0x22, 0x13, 0x64, 0x14, 0x76, 0x1B, 0x17, 0x23, 0x16, 0x01, 0x6C, 0x67, 0x18,
+    0x55, 0x1F, 0x72, 0x44, 0x33, 0x5A, 0x3F, 0x40, 0x59, 0x43, 0x34, 0x42, 0x41, 0x45, 0x4D, 0x3A,
+    0x49, 0x3B, 0x48, 0x3C, 0x4C, 0x39, 0x4B, 0x4A, 0x4E, 0x5F, 0x5C, 0x5B, 0x30, 0x31, 0x32, 0x7E,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xFF, 0xAD, 0xBD, 0x9C, 0xCF, 0xBE, 0xDD, 0xF5, 0xF9, 0xB8, 0xA6, 0xAE, 0xAA, 0xF0, 0xA9, 0xEE,
+    0xF8, 0xF1, 0xFD, 0xFC, 0xEF, 0xE6, 0xF4, 0xFA, 0xF7, 0xFB, 0xA7, 0xAF, 0xAC, 0xAB, 0xF3, 0xA8,
+    0xB7, 0xB5, 0xB6, 0xC7, 0x8E, 0x8F, 0x92, 0x80, 0xD4, 0x90, 0xD2, 0xD3, 0xDE, 0xD6, 0xD7, 0xD8,
+    0xD1, 0xA5, 0xE3, 0xE0, 0xE2, 0xE5, 0x99, 0x9E, 0x9D, 0xEB, 0xE9, 0xEA, 0x9A, 0xED, 0xE8, 0xE1,
+    0x85, 0xA0, 0x83, 0xC6, 0x84, 0x86, 0x91, 0x87, 0x8A, 0x82, 0x88, 0x89, 0x8D, 0xA1, 0x8C, 0x8B,
+    0xD0, 0xA4, 0x95, 0xA2, 0x93, 0xE4, 0x94, 0xF6, 0x9B, 0x97, 0xA3, 0x96, 0x81, 0xEC, 0xE7, 0x98,
+    0x80, 0x00
+};
+#endif
+#if FF_CODE_PAGE == 852 || FF_CODE_PAGE == 0
+static const BYTE ri852[] = {  /*  CP852(Latin 2) Unicode to OEM conversion index (U+0100 - U+017F direct) */
+    0x7F, 0x4F, 0x75, 0x79, 0x2E, 0x2A, 0x70, 0x78, 0x6F, 0x77, 0x2F, 0x35, 0x36, 0x0E, 0x00, 0x10,
+    0x53, 0x56, 0x57, 0x60, 0x62, 0x19, 0x1E, 0x69, 0x1A, 0x6D, 0x61, 0x20, 0x03, 0x04, 0x07, 0x02,
+    0x09, 0x21, 0x0C, 0x22, 0x13, 0x14, 0x76, 0x23, 0x01, 0x6C, 0x46, 0x47, 0x24, 0x25, 0x0F, 0x06,
+    0x2C, 0x1F, 0x52, 0x54, 0x51, 0x50, 0x28, 0x29, 0x37, 0x58, 0x11, 0x12, 0x15, 0x16, 0x1D, 0x08,
+    0x63, 0x64, 0x55, 0x65, 0x0A, 0x0B, 0x68, 0x6A, 0x7C, 0x7D, 0x17, 0x18, 0x38, 0x2D, 0x66, 0x67,
+    0x5D, 0x6E, 0x1B, 0x1C, 0x5E, 0x05, 0x6B, 0x7B, 0x0D, 0x2B, 0x3D, 0x3E, 0x26, 0x27, 0x73, 0x74,
+    0x7A, 0x72, 0x71, 0x44, 0x33, 0x5A, 0x3F, 0x40, 0x59, 0x43, 0x34, 0x42, 0x41, 0x45, 0x4D, 0x3A,
+    0x49, 0x3B, 0x48, 0x3C, 0x4C, 0x39, 0x4B, 0x4A, 0x4E, 0x5F, 0x5C, 0x5B, 0x30, 0x31, 0x32, 0x7E,
+    0x00, 0x00, 0xC6, 0xC7, 0xA4, 0xA5, 0x8F, 0x86, 0x00, 0x00, 0x00, 0x00, 0xAC, 0x9F, 0xD2, 0xD4,
+    0xD1, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xA8, 0xA9, 0xB7, 0xD8, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x91, 0x92, 0x00, 0x00, 0x95, 0x96, 0x00,
+    0x00, 0x9D, 0x88, 0xE3, 0xE4, 0x00, 0x00, 0xD5, 0xE5, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x8A, 0x8B, 0x00, 0x00, 0xE8, 0xEA, 0x00, 0x00, 0xFC, 0xFD, 0x97, 0x98, 0x00, 0x00, 0xB8, 0xAD,
+    0xE6, 0xE7, 0xDD, 0xEE, 0x9B, 0x9C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xDE, 0x85,
+    0xEB, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8D, 0xAB, 0xBD, 0xBE, 0xA6, 0xA7, 0x00,
+    0x00, 0x01
+};
+#endif
+#if FF_CODE_PAGE == 855 || FF_CODE_PAGE == 0
+static const BYTE ri855[] = {  /*  CP855(Cyrillic) Unicode to OEM conversion index (U+0400 - U+047F direct) */
+    0x7F, 0x4F, 0x7D, 0x2E, 0x70, 0x2F, 0x05, 0x01, 0x03, 0x07, 0x09, 0x0B, 0x0D, 0x0F, 0x11, 0x13,
+    0x15, 0x17, 0x19, 0x1B, 0x21, 0x23, 0x6C, 0x2D, 0x27, 0x29, 0x6A, 0x74, 0x38, 0x3E, 0x47, 0x51,
+    0x53, 0x55, 0x57, 0x5D, 0x62, 0x64, 0x66, 0x68, 0x2B, 0x36, 0x25, 0x7C, 0x76, 0x7A, 0x1F, 0x72,
+    0x6E, 0x78, 0x1D, 0x60, 0x20, 0x22, 0x6B, 0x2C, 0x26, 0x28, 0x69, 0x73, 0x37, 0x3D, 0x46, 0x50,
+    0x52, 0x54, 0x56, 0x58, 0x61, 0x63, 0x65, 0x67, 0x2A, 0x35, 0x24, 0x7B, 0x75, 0x79, 0x1E, 0x71,
+    0x6D, 0x77, 0x1C, 0x5E, 0x04, 0x00, 0x02, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x10, 0x12, 0x14, 0x16,
+    0x18, 0x1A, 0x6F, 0x44, 0x33, 0x5A, 0x3F, 0x40, 0x59, 0x43, 0x34, 0x42, 0x41, 0x45, 0x4D, 0x3A,
+    0x49, 0x3B, 0x48, 0x3C, 0x4C, 0x39, 0x4B, 0x4A, 0x4E, 0x5F, 0x5C, 0x5B, 0x30, 0x31, 0x32, 0x7E,
+    0x00, 0x85, 0x81, 0x83, 0x87, 0x89, 0x8B, 0x8D, 0x8F, 0x91, 0x93, 0x95, 0x97, 0x00, 0x99, 0x9B,
+    0xA1, 0xA3, 0xEC, 0xAD, 0xA7, 0xA9, 0xEA, 0xF4, 0xB8, 0xBE, 0xC7, 0xD1, 0xD3, 0xD5, 0xD7, 0xDD,
+    0xE2, 0xE4, 0xE6, 0xE8, 0xAB, 0xB6, 0xA5, 0xFC, 0xF6, 0xFA, 0x9F, 0xF2, 0xEE, 0xF8, 0x9D, 0xE0,
+    0xA0, 0xA2, 0xEB, 0xAC, 0xA6, 0xA8, 0xE9, 0xF3, 0xB7, 0xBD, 0xC6, 0xD0, 0xD2, 0xD4, 0xD6, 0xD8,
+    0xE1, 0xE3, 0xE5, 0xE7, 0xAA, 0xB5, 0xA4, 0xFB, 0xF5, 0xF9, 0x9E, 0xF1, 0xED, 0xF7, 0x9C, 0xDE,
+    0x00, 0x84, 0x80, 0x82, 0x86, 0x88, 0x8A, 0x8C, 0x8E, 0x90, 0x92, 0x94, 0x96, 0x00, 0x98, 0x9A,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x04
+};
+#endif
+#if FF_CODE_PAGE == 857 || FF_CODE_PAGE == 0
+static const BYTE ri857[] = {  /*  CP857(Turkish) Unicode to OEM conversion index (U+0080 - U+00FF direct) */
+    0x55, 0x67, 0x72, 0x7F, 0x2D, 0x3D, 0x1C, 0x4F, 0x3E, 0x5D, 0x75, 0x79, 0x38, 0x51, 0x2E, 0x2A,
+    0x70, 0x29, 0x6E, 0x78, 0x71, 0x7D, 0x7C, 0x6F, 0x66, 0x74, 0x7A, 0x77, 0x7B, 0x50, 0x2F, 0x2C,
+    0x2B, 0x73, 0x28, 0x37, 0x35, 0x36, 0x47, 0x0E, 0x0F, 0x12, 0x00, 0x54, 0x10, 0x52, 0x53, 0x5E,
+    0x56, 0x57, 0x58, 0x25, 0x63, 0x60, 0x62, 0x65, 0x19, 0x68, 0x1D, 0x6B, 0x69, 0x6A, 0x1A, 0x61,
+    0x05, 0x20, 0x03, 0x46, 0x04, 0x06, 0x11, 0x07, 0x0A, 0x02, 0x08, 0x09, 0x6C, 0x21, 0x0C, 0x0B,
+    0x24, 0x15, 0x22, 0x13, 0x64, 0x14, 0x76, 0x1B, 0x17, 0x23, 0x16, 0x01, 0x6D, 0x26, 0x27, 0x18,
+    0x0D, 0x1E, 0x1F, 0x44, 0x33, 0x5A, 0x3F, 0x40, 0x59, 0x43, 0x34, 0x42, 0x41, 0x45, 0x4D, 0x3A,
+    0x49, 0x3B, 0x48, 0x3C, 0x4C, 0x39, 0x4B, 0x4A, 0x4E, 0x5F, 0x5C, 0x5B, 0x30, 0x31, 0x32, 0x7E,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xFF, 0xAD, 0xBD, 0x9C, 0xCF, 0xBE, 0xDD, 0xF5, 0xF9, 0xB8, 0xD1, 0xAE, 0xAA, 0xF0, 0xA9, 0xEE,
+    0xF8, 0xF1, 0xFD, 0xFC, 0xEF, 0xE6, 0xF4, 0xFA, 0xF7, 0xFB, 0xD0, 0xAF, 0xAC, 0xAB, 0xF3, 0xA8,
+    0xB7, 0xB5, 0xB6, 0xC7, 0x8E, 0x8F, 0x92, 0x80, 0xD4, 0x90, 0xD2, 0xD3, 0xDE, 0xD6, 0xD7, 0xD8,
+    0x00, 0xA5, 0xE3, 0xE0, 0xE2, 0xE5, 0x99, 0xE8, 0x9D, 0xEB, 0xE9, 0xEA, 0x9A, 0x00, 0x00, 0xE1,
+    0x85, 0xA0, 0x83, 0xC6, 0x84, 0x86, 0x91, 0x87, 0x8A, 0x82, 0x88, 0x89, 0xEC, 0xA1, 0x8C, 0x8B,
+    0x00, 0xA4, 0x95, 0xA2, 0x93, 0xE4, 0x94, 0xF6, 0x9B, 0x97, 0xA3, 0x96, 0x81, 0x00, 0x00, 0xED,
+    0x80, 0x00
+};
+#endif
+#if FF_CODE_PAGE == 860 || FF_CODE_PAGE == 0
+static const BYTE ri860[] = {  /*  CP860(Portuguese) Unicode to OEM conversion index (U+0080 - U+00FF direct) */
+    0x7F, 0x2D, 0x1B, 0x1C, 0x26, 0x2E, 0x2A, 0x78, 0x71, 0x7D, 0x66, 0x7A, 0x27, 0x2F, 0x2C, 0x2B,
+    0x28, 0x11, 0x06, 0x0F, 0x0E, 0x00, 0x12, 0x10, 0x09, 0x18, 0x0B, 0x25, 0x29, 0x1F, 0x0C, 0x19,
+    0x1D, 0x16, 0x1A, 0x61, 0x05, 0x20, 0x03, 0x04, 0x07, 0x0A, 0x02, 0x08, 0x0D, 0x21, 0x24, 0x15,
+    0x22, 0x13, 0x14, 0x76, 0x17, 0x23, 0x01, 0x62, 0x69, 0x64, 0x68, 0x6A, 0x60, 0x6B, 0x6E, 0x63,
+    0x65, 0x67, 0x6D, 0x7C, 0x1E, 0x79, 0x7B, 0x6C, 0x6F, 0x77, 0x70, 0x73, 0x72, 0x74, 0x75, 0x44,
+    0x33, 0x5A, 0x3F, 0x40, 0x59, 0x43, 0x34, 0x42, 0x41, 0x45, 0x4D, 0x3A, 0x55, 0x56, 0x49, 0x38,
+    0x37, 0x3B, 0x3E, 0x54, 0x53, 0x48, 0x3D, 0x3C, 0x46, 0x47, 0x4C, 0x35, 0x36, 0x39, 0x51, 0x52,
+    0x4B, 0x4F, 0x50, 0x4A, 0x58, 0x57, 0x4E, 0x5F, 0x5C, 0x5B, 0x5D, 0x5E, 0x30, 0x31, 0x32, 0x7E,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xFF, 0xAD, 0x9B, 0x9C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xA6, 0xAE, 0xAA, 0x00, 0x00, 0x00,
+    0xF8, 0xF1, 0xFD, 0x00, 0x00, 0xE6, 0x00, 0xFA, 0x00, 0x00, 0xA7, 0xAF, 0xAC, 0xAB, 0x00, 0xA8,
+    0x91, 0x86, 0x8F, 0x8E, 0x00, 0x00, 0x00, 0x80, 0x92, 0x90, 0x89, 0x00, 0x98, 0x8B, 0x00, 0x00,
+    0x00, 0xA5, 0xA9, 0x9F, 0x8C, 0x99, 0x00, 0x00, 0x00, 0x9D, 0x96, 0x00, 0x9A, 0x00, 0x00, 0xE1,
+    0x85, 0xA0, 0x83, 0x84, 0x00, 0x00, 0x00, 0x87, 0x8A, 0x82, 0x88, 0x00, 0x8D, 0xA1, 0x00, 0x00,
+    0x00, 0xA4, 0x95, 0xA2, 0x93, 0x94, 0x00, 0xF6, 0x00, 0x97, 0xA3, 0x00, 0x81, 0x00, 0x00, 0x00,
+    0x80, 0x00
+};
+#endif
+#if FF_CODE_PAGE == 861 || FF_CODE_PAGE == 0
+static const BYTE ri861[] = {  /*  CP861(Icelandic) Unicode to OEM conversion index (U+0080 - U+00FF direct) */
+    0x7F, 0x2D, 0x1C, 0x2E, 0x2A, 0x78, 0x71, 0x7D, 0x66, 0x7A, 0x2F, 0x2C, 0x2B, 0x28, 0x24, 0x0E,
+    0x0F, 0x12, 0x00, 0x10, 0x25, 0x0B, 0x26, 0x19, 0x1D, 0x27, 0x1A, 0x17, 0x0D, 0x61, 0x05, 0x20,
+    0x03, 0x04, 0x06, 0x11, 0x07, 0x0A, 0x02, 0x08, 0x09, 0x21, 0x0C, 0x22, 0x13, 0x14, 0x76, 0x1B,
+    0x23, 0x16, 0x01, 0x18, 0x15, 0x1F, 0x62, 0x69, 0x64, 0x68, 0x6A, 0x60, 0x6B, 0x6E, 0x63, 0x65,
+    0x67, 0x6D, 0x7C, 0x1E, 0x79, 0x7B, 0x6C, 0x6F, 0x77, 0x70, 0x73, 0x72, 0x29, 0x74, 0x75, 0x44,
+    0x33, 0x5A, 0x3F, 0x40, 0x59, 0x43, 0x34, 0x42, 0x41, 0x45, 0x4D, 0x3A, 0x55, 0x56, 0x49, 0x38,
+    0x37, 0x3B, 0x54, 0x53, 0x48, 0x3E, 0x3D, 0x3C, 0x46, 0x47, 0x4C, 0x35, 0x36, 0x39, 0x51, 0x52,
+    0x4B, 0x4F, 0x50, 0x4A, 0x58, 0x57, 0x4E, 0x5F, 0x5C, 0x5B, 0x5D, 0x5E, 0x30, 0x31, 0x32, 0x7E,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xFF, 0xAD, 0x00, 0x9C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xAE, 0xAA, 0x00, 0x00, 0x00,
+    0xF8, 0xF1, 0xFD, 0x00, 0x00, 0xE6, 0x00, 0xFA, 0x00, 0x00, 0x00, 0xAF, 0xAC, 0xAB, 0x00, 0xA8,
+    0x00, 0xA4, 0x00, 0x00, 0x8E, 0x8F, 0x92, 0x80, 0x00, 0x90, 0x00, 0x00, 0x00, 0xA5, 0x00, 0x00,
+    0x8B, 0x00, 0x00, 0xA6, 0x00, 0x00, 0x99, 0x00, 0x9D, 0x00, 0xA7, 0x00, 0x9A, 0x97, 0x8D, 0xE1,
+    0x85, 0xA0, 0x83, 0x00, 0x84, 0x00, 0x86, 0x87, 0x8A, 0x82, 0x88, 0x89, 0x00, 0xA1, 0x00, 0x00,
+    0x8C, 0x00, 0x00, 0xA2, 0x93, 0x00, 0x94, 0xF6, 0x9B, 0x00, 0xA3, 0x96, 0x81, 0x98, 0x95, 0x00,
+    0x80, 0x00
+};
+#endif
+#if FF_CODE_PAGE == 862 || FF_CODE_PAGE == 0
+static const BYTE ri862[] = {  /*  CP862(Hebrew) Unicode to OEM conversion index (U+0580 - U+05FF direct) */
+    0x7F, 0x2D, 0x1B, 0x1C, 0x1D, 0x26, 0x2E, 0x2A, 0x78, 0x71, 0x7D, 0x66, 0x7A, 0x27, 0x2F, 0x2C,
+    0x2B, 0x28, 0x25, 0x61, 0x20, 0x21, 0x24, 0x22, 0x76, 0x23, 0x1F, 0x62, 0x69, 0x64, 0x68, 0x6A,
+    0x60, 0x6B, 0x6E, 0x63, 0x65, 0x67, 0x6D, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+    0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+    0x19, 0x1A, 0x7C, 0x1E, 0x79, 0x7B, 0x6C, 0x6F, 0x77, 0x70, 0x73, 0x72, 0x29, 0x74, 0x75, 0x44,
+    0x33, 0x5A, 0x3F, 0x40, 0x59, 0x43, 0x34, 0x42, 0x41, 0x45, 0x4D, 0x3A, 0x55, 0x56, 0x49, 0x38,
+    0x37, 0x3B, 0x54, 0x53, 0x48, 0x3E, 0x3D, 0x3C, 0x46, 0x47, 0x4C, 0x35, 0x36, 0x39, 0x51, 0x52,
+    0x4B, 0x4F, 0x50, 0x4A, 0x58, 0x57, 0x4E, 0x5F, 0x5C, 0x5B, 0x5D, 0x5E, 0x30, 0x31, 0x32, 0x7E,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F,
+    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0x05
+};
+#endif
+#if FF_CODE_PAGE == 863 || FF_CODE_PAGE == 0
+static const BYTE ri863[] = {  /*  CP863(Canadian French) Unicode to OEM conversion index (U+0080 - U+00FF direct) */
+    0x7F, 0x1B, 0x1C, 0x18, 0x20, 0x24, 0x2E, 0x2A, 0x27, 0x78, 0x71, 0x7D, 0x26, 0x21, 0x66, 0x06,
+    0x7A, 0x25, 0x2F, 0x2C, 0x2B, 0x2D, 0x0F, 0x04, 0x00, 0x11, 0x10, 0x12, 0x14, 0x28, 0x15, 0x19,
+    0x1D, 0x1E, 0x1A, 0x61, 0x05, 0x03, 0x07, 0x0A, 0x02, 0x08, 0x09, 0x0D, 0x0C, 0x0B, 0x22, 0x13,
+    0x76, 0x17, 0x23, 0x16, 0x01, 0x1F, 0x62, 0x69, 0x64, 0x68, 0x6A, 0x60, 0x6B, 0x6E, 0x63, 0x65,
+    0x67, 0x6D, 0x0E, 0x7C, 0x6F, 0x79, 0x7B, 0x6C, 0x77, 0x70, 0x73, 0x72, 0x74, 0x75, 0x44, 0x33,
+    0x5A, 0x3F, 0x40, 0x59, 0x43, 0x34, 0x42, 0x41, 0x45, 0x4D, 0x3A, 0x55, 0x56, 0x49, 0x38, 0x37,
+    0x3B, 0x54, 0x53, 0x48, 0x3E, 0x3D, 0x3C, 0x46, 0x47, 0x4C, 0x35, 0x36, 0x39, 0x51, 0x52, 0x4B,
+    0x4F, 0x50, 0x4A, 0x58, 0x57, 0x4E, 0x5F, 0x5C, 0x5B, 0x5D, 0x5E, 0x30, 0x31, 0x32, 0x7E, 0x29,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xFF, 0x00, 0x9B, 0x9C, 0x98, 0x00, 0xA0, 0x00, 0xA4, 0x00, 0x00, 0xAE, 0xAA, 0x00, 0x00, 0xA7,
+    0xF8, 0xF1, 0xFD, 0xA6, 0xA1, 0xE6, 0x86, 0xFA, 0x00, 0x00, 0x00, 0xA5, 0xAC, 0xAB, 0xAD, 0x00,
+    0x8F, 0x00, 0x84, 0x00, 0x00, 0x00, 0x00, 0x80, 0x91, 0x90, 0x92, 0x94, 0x00, 0x00, 0xA8, 0x95,
+    0x00, 0x00, 0x00, 0x00, 0x99, 0x00, 0x00, 0x00, 0x00, 0x9D, 0x00, 0x9E, 0x9A, 0x00, 0x00, 0xE1,
+    0x85, 0x00, 0x83, 0x00, 0x00, 0x00, 0x00, 0x87, 0x8A, 0x82, 0x88, 0x89, 0x8D, 0x00, 0x8C, 0x8B,
+    0x00, 0x00, 0x00, 0xA2, 0x93, 0x00, 0x00, 0xF6, 0x00, 0x97, 0xA3, 0x96, 0x81, 0x00, 0x00, 0x00,
+    0x80, 0x00
+};
+#endif
+#if FF_CODE_PAGE == 864 || FF_CODE_PAGE == 0
+static const BYTE ri864[] = {  /*  CP864(Arabic) Unicode to OEM conversion index (U+FE80 - U+FEFF direct) */
+    0x1B, 0x1C, 0x1F, 0x26, 0x7F, 0x20, 0x40, 0x23, 0x24, 0x5B, 0x17, 0x5C, 0x21, 0x00, 0x13, 0x01,
+    0x18, 0x15, 0x14, 0x5E, 0x5D, 0x10, 0x12, 0x2C, 0x3B, 0x3F, 0x60, 0x71, 0x30, 0x31, 0x32, 0x33,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x27, 0x02, 0x03, 0x11, 0x16, 0x05, 0x06, 0x0D, 0x0C, 0x0E,
+    0x0F, 0x0A, 0x08, 0x09, 0x0B, 0x07, 0x04, 0x7E, 0x70, 0x41, 0x42, 0x22, 0x43, 0x25, 0x44, 0x46,
+    0x47, 0x28, 0x29, 0x48, 0x49, 0x2A, 0x4A, 0x2B, 0x4B, 0x2D, 0x4C, 0x2E, 0x4D, 0x2F, 0x4E, 0x4F,
+    0x50, 0x51, 0x52, 0x3C, 0x53, 0x3D, 0x54, 0x3E, 0x55, 0x6B, 0x56, 0x57, 0x58, 0x5F, 0x45, 0x59,
+    0x6C, 0x6E, 0x6D, 0x5A, 0x77, 0x3A, 0x61, 0x78, 0x62, 0x7C, 0x63, 0x7B, 0x64, 0x6F, 0x65, 0x72,
+    0x66, 0x73, 0x67, 0x74, 0x68, 0x69, 0x75, 0x7D, 0x76, 0x6A, 0x79, 0x7A, 0x19, 0x1A, 0x1D, 0x1E,
+    0xC1, 0xC2, 0xA2, 0xC3, 0xA5, 0xC4, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC6, 0x00, 0xC7, 0xA8, 0xA9,
+    0x00, 0xC8, 0x00, 0xC9, 0x00, 0xAA, 0x00, 0xCA, 0x00, 0xAB, 0x00, 0xCB, 0x00, 0xAD, 0x00, 0xCC,
+    0x00, 0xAE, 0x00, 0xCD, 0x00, 0xAF, 0x00, 0xCE, 0x00, 0xCF, 0x00, 0xD0, 0x00, 0xD1, 0x00, 0xD2,
+    0x00, 0xBC, 0x00, 0xD3, 0x00, 0xBD, 0x00, 0xD4, 0x00, 0xBE, 0x00, 0xD5, 0x00, 0xEB, 0x00, 0xD6,
+    0x00, 0xD7, 0x00, 0x00, 0x00, 0xD8, 0x00, 0x00, 0x00, 0xDF, 0xC5, 0xD9, 0xEC, 0xEE, 0xED, 0xDA,
+    0xF7, 0xBA, 0x00, 0xE1, 0x00, 0xF8, 0x00, 0xE2, 0x00, 0xFC, 0x00, 0xE3, 0x00, 0xFB, 0x00, 0xE4,
+    0x00, 0xEF, 0x00, 0xE5, 0x00, 0xF2, 0x00, 0xE6, 0x00, 0xF3, 0x00, 0xE7, 0xF4, 0xE8, 0x00, 0xE9,
+    0xF5, 0xFD, 0xF6, 0xEA, 0x00, 0xF9, 0xFA, 0x99, 0x9A, 0x00, 0x00, 0x9D, 0x9E, 0x00, 0x00, 0x00,
+    0x80, 0xFE
+};
+#endif
+#if FF_CODE_PAGE == 865 || FF_CODE_PAGE == 0
+static const BYTE ri865[] = {  /*  CP865(Nordic) Unicode to OEM conversion index (U+0080 - U+00FF direct) */
+    0x7F, 0x2D, 0x1C, 0x2F, 0x26, 0x2E, 0x2A, 0x78, 0x71, 0x7D, 0x66, 0x7A, 0x27, 0x2C, 0x2B, 0x28,
+    0x0E, 0x0F, 0x10, 0x12, 0x00, 0x25, 0x19, 0x1D, 0x1A, 0x61, 0x05, 0x20, 0x03, 0x04, 0x06, 0x11,
+    0x07, 0x0A, 0x02, 0x08, 0x09, 0x0D, 0x21, 0x0C, 0x0B, 0x24, 0x15, 0x22, 0x13, 0x14, 0x76, 0x1B,
+    0x17, 0x23, 0x16, 0x01, 0x18, 0x1F, 0x62, 0x69, 0x64, 0x68, 0x6A, 0x60, 0x6B, 0x6E, 0x63, 0x65,
+    0x67, 0x6D, 0x7C, 0x1E, 0x79, 0x7B, 0x6C, 0x6F, 0x77, 0x70, 0x73, 0x72, 0x29, 0x74, 0x75, 0x44,
+    0x33, 0x5A, 0x3F, 0x40, 0x59, 0x43, 0x34, 0x42, 0x41, 0x45, 0x4D, 0x3A, 0x55, 0x56, 0x49, 0x38,
+    0x37, 0x3B, 0x3E, 0x54, 0x53, 0x48, 0x3D, 0x3C, 0x46, 0x47, 0x4C, 0x35, 0x36, 0x39, 0x51, 0x52,
+    0x4B, 0x4F, 0x50, 0x4A, 0x58, 0x57, 0x4E, 0x5F, 0x5C, 0x5B, 0x5D, 0x5E, 0x30, 0x31, 0x32, 0x7E,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xFF, 0xAD, 0x00, 0x9C, 0xAF, 0x00, 0x00, 0x00, 0x00, 0x00, 0xA6, 0xAE, 0xAA, 0x00, 0x00, 0x00,
+    0xF8, 0xF1, 0xFD, 0x00, 0x00, 0xE6, 0x00, 0xFA, 0x00, 0x00, 0xA7, 0x00, 0xAC, 0xAB, 0x00, 0xA8,
+    0x00, 0x00, 0x00, 0x00, 0x8E, 0x8F, 0x92, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xA5, 0x00, 0x00, 0x00, 0x00, 0x99, 0x00, 0x9D, 0x00, 0x00, 0x00, 0x9A, 0x00, 0x00, 0xE1,
+    0x85, 0xA0, 0x83, 0x00, 0x84, 0x86, 0x91, 0x87, 0x8A, 0x82, 0x88, 0x89, 0x8D, 0xA1, 0x8C, 0x8B,
+    0x00, 0xA4, 0x95, 0xA2, 0x93, 0x00, 0x94, 0xF6, 0x9B, 0x97, 0xA3, 0x96, 0x81, 0x00, 0x00, 0x98,
+    0x80, 0x00
+};
+#endif
+#if FF_CODE_PAGE == 866 || FF_CODE_PAGE == 0
+static const BYTE ri866[] = {  /*  CP866(Russian) Unicode to OEM conversion index (U+0400 - U+047F direct) */
+    0x7F, 0x7D, 0x78, 0x7A, 0x70, 0x72, 0x74, 0x76, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27,
+    0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67,
+    0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F, 0x71, 0x73, 0x75, 0x77, 0x7C, 0x79, 0x7B, 0x44,
+    0x33, 0x5A, 0x3F, 0x40, 0x59, 0x43, 0x34, 0x42, 0x41, 0x45, 0x4D, 0x3A, 0x55, 0x56, 0x49, 0x38,
+    0x37, 0x3B, 0x54, 0x53, 0x48, 0x3E, 0x3D, 0x3C, 0x46, 0x47, 0x4C, 0x35, 0x36, 0x39, 0x51, 0x52,
+    0x4B, 0x4F, 0x50, 0x4A, 0x58, 0x57, 0x4E, 0x5F, 0x5C, 0x5B, 0x5D, 0x5E, 0x30, 0x31, 0x32, 0x7E,
+    0x00, 0xF0, 0x00, 0x00, 0xF2, 0x00, 0x00, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF6, 0x00,
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F,
+    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0x9B, 0x9C, 0x9D, 0x9E, 0x9F,
+    0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xAB, 0xAC, 0xAD, 0xAE, 0xAF,
+    0xE0, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xEB, 0xEC, 0xED, 0xEE, 0xEF,
+    0x00, 0xF1, 0x00, 0x00, 0xF3, 0x00, 0x00, 0xF5, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF7, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x04
+};
+#endif
+#if FF_CODE_PAGE == 869 || FF_CODE_PAGE == 0
+static const BYTE ri869[] = {  /*  CP869(Greek 2) Unicode to OEM conversion index (U+0380 - U+03FF direct) */
+    0x7F, 0x1C, 0x0A, 0x75, 0x79, 0x17, 0x2E, 0x09, 0x70, 0x78, 0x71, 0x19, 0x1A, 0x00, 0x01, 0x02,
+    0x03, 0x04, 0x05, 0x07, 0x08, 0x13, 0x14, 0x2F, 0x2B, 0x6F, 0x77, 0x06, 0x0D, 0x0F, 0x10, 0x12,
+    0x15, 0x18, 0x21, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2C, 0x2D, 0x35, 0x36, 0x37, 0x38,
+    0x3D, 0x3E, 0x47, 0x4F, 0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x11, 0x16, 0x1B, 0x1D, 0x1E, 0x1F,
+    0x7C, 0x56, 0x57, 0x58, 0x5D, 0x5E, 0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x6B, 0x6D, 0x6C, 0x6E, 0x72, 0x73, 0x74, 0x76, 0x7A, 0x20, 0x7B, 0x22, 0x23, 0x7D, 0x46,
+    0x0E, 0x0B, 0x0C, 0x44, 0x33, 0x5A, 0x3F, 0x40, 0x59, 0x43, 0x34, 0x42, 0x41, 0x45, 0x4D, 0x3A,
+    0x49, 0x3B, 0x48, 0x3C, 0x4C, 0x39, 0x4B, 0x4A, 0x4E, 0x5F, 0x5C, 0x5B, 0x30, 0x31, 0x32, 0x7E,
+    0x00, 0x00, 0x00, 0x00, 0xEF, 0xF7, 0x86, 0x00, 0x8D, 0x8F, 0x90, 0x00, 0x92, 0x00, 0x95, 0x98,
+    0xA1, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xAC, 0xAD, 0xB5, 0xB6, 0xB7, 0xB8, 0xBD, 0xBE,
+    0x00, 0xC7, 0x00, 0xCF, 0xD0, 0xD1, 0xD2, 0xD3, 0xD4, 0xD5, 0x91, 0x96, 0x9B, 0x9D, 0x9E, 0x9F,
+    0xFC, 0xD6, 0xD7, 0xD8, 0xDD, 0xDE, 0xE0, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9,
+    0xEA, 0xEB, 0xED, 0xEC, 0xEE, 0xF2, 0xF3, 0xF4, 0xF6, 0xFA, 0xA0, 0xFB, 0xA2, 0xA3, 0xFD, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0x03
+};
+#endif
+#endif
+
+#if FF_LFN_CVTIDX && (FF_CODE_PAGE >= 900 || FF_CODE_PAGE == 0)
+#if FF_CODE_PAGE == 932 || FF_CODE_PAGE == 0    /* Japanese */
+static const WORD ui932[] = {  /* Index to uni2oem932[] for each upper byte of Unicode */
+    0, 8, 8, 8, 56, 122, 122, 122, 122, 122, 122, 122, 122, 122, 122, 122,
+    122, 122, 122, 122, 122, 122, 122, 122, 122, 122, 122, 122, 122, 122, 122, 122,
+    122, 136, 166, 202, 203, 223, 267, 274, 274, 274, 274, 274, 274, 274, 274, 274,
+    274, 474, 474, 482, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510,
+    510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 510, 628,
+    730, 817, 938, 1048, 1167, 1262, 1328, 1391, 1462, 1547, 1643, 1688, 1796, 1888, 1961, 2063,
+    2178, 2285, 2386, 2499, 2581, 2650, 2745, 2854, 2971, 3065, 3163, 3238, 3324, 3412, 3499, 3587,
+    3663, 3719, 3785, 3861, 3925, 3988, 4100, 4189, 4254, 4314, 4390, 4488, 4573, 4659, 4769, 4834,
+    4904, 4993, 5078, 5170, 5249, 5323, 5402, 5465, 5528, 5613, 5684, 5796, 5854, 5938, 5990, 6058,
+    6137, 6243, 6324, 6400, 6467, 6503, 6545, 6643, 6730, 6797, 6862, 6919, 6990, 7035, 7101, 7159,
+    7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192,
+    7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192,
+    7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192,
+    7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192,
+    7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192,
+    7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7192, 7194, 7226, 7226, 7226, 7226, 7226,
+    7389
+};
+static const WORD oi932[] = {  /* Index to oem2uni932[] for each upper byte of OEM code */
+    0, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63,
+    63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63,
+    63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63,
+    63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63,
+    63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63,
+    63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63,
+    63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63,
+    63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63, 63,
+    63, 63, 210, 355, 489, 587, 587, 587, 661, 755, 943, 1131, 1319, 1507, 1695, 1883,
+    2071, 2259, 2447, 2635, 2823, 3011, 3199, 3387, 3575, 3720, 3908, 4096, 4284, 4472, 4660, 4848,
+    5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036,
+    5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036,
+    5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036,
+    5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036, 5036,
+    5036, 5224, 5412, 5600, 5788, 5976, 6164, 6352, 6540, 6728, 6916, 7016, 7016, 7016, 7016, 7016,
+    7016, 7016, 7016, 7016, 7016, 7016, 7016, 7016, 7016, 7016, 7016, 7189, 7377, 7389, 7389, 7389,
+    7389
+};
+#endif
+#if FF_CODE_PAGE == 936 || FF_CODE_PAGE == 0    /* Simplified Chinese */
+static const WORD ui936[] = {  /* Index to uni2oem936[] for each upper byte of Unicode */
+    0, 20, 36, 43, 91, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+    157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157, 157,
+    157, 174, 209, 246, 247, 297, 442, 447, 447, 447, 447, 447, 447, 447, 447, 447,
+    447, 657, 694, 706, 717, 717, 717, 717, 717, 717, 717, 717, 717, 717, 717, 717,
+    717, 717, 717, 717, 717, 717, 717, 717, 717, 717, 717, 717, 717, 717, 717, 973,
+    1229, 1485, 1741, 1997, 2253, 2509, 2765, 3021, 3277, 3533, 3789, 4045, 4301, 4557, 4813, 5069,
+    5325, 5581, 5837, 6093, 6349, 6605, 6861, 7117, 7373, 7629, 7885, 8141, 8397, 8653, 8909, 9165,
+    9421, 9677, 9933, 10189, 10445, 10701, 10957, 11213, 11469, 11725, 11981, 12237, 12493, 12749, 13005, 13261,
+    13517, 13773, 14029, 14285, 14541, 14797, 15053, 15309, 15565, 15821, 16077, 16333, 16589, 16845, 17101, 17357,
+    17613, 17869, 18125, 18381, 18637, 18893, 19149, 19405, 19661, 19917, 20173, 20429, 20685, 20941, 21197, 21453,
+    21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619,
+    21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619,
+    21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619,
+    21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619,
+    21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619,
+    21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21619, 21624, 21640, 21640, 21640, 21640, 21692,
+    21792
+};
+static const WORD oi936[] = {  /* Index to oem2uni936[] for each upper byte of OEM code */
+    0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 191, 381, 571, 761, 951, 1141, 1331, 1521, 1711, 1901, 2091, 2281, 2471, 2661,
+    2851, 3041, 3231, 3421, 3611, 3801, 3991, 4181, 4371, 4561, 4751, 4941, 5131, 5321, 5511, 5701,
+    5891, 6081, 6175, 6257, 6351, 6434, 6520, 6587, 6653, 6805, 6949, 7045, 7141, 7237, 7333, 7429,
+    7525, 7715, 7905, 8095, 8285, 8475, 8665, 8855, 9045, 9235, 9425, 9615, 9805, 9995, 10185, 10375,
+    10565, 10755, 10945, 11135, 11325, 11515, 11705, 11895, 12085, 12275, 12465, 12655, 12845, 13035, 13225, 13415,
+    13605, 13795, 13985, 14175, 14365, 14555, 14745, 14935, 15120, 15310, 15500, 15690, 15880, 16070, 16260, 16450,
+    16640, 16830, 17020, 17210, 17400, 17590, 17780, 17970, 18160, 18350, 18540, 18730, 18920, 19110, 19300, 19490,
+    19680, 19870, 20060, 20250, 20440, 20630, 20820, 21010, 21200, 21296, 21392, 21488, 21584, 21680, 21776, 21792,
+    21792
+};
+#endif
+#if FF_CODE_PAGE == 949 || FF_CODE_PAGE == 0    /* Korean */
+static const WORD ui949[] = {  /* Index to uni2oem949[] for each upper byte of Unicode */
+    0, 32, 50, 57, 105, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171,
+    171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171, 171,
+    171, 191, 237, 274, 275, 357, 451, 470, 470, 470, 470, 470, 470, 470, 470, 470,
+    470, 656, 750, 808, 888, 888, 888, 888, 888, 888, 888, 888, 888, 888, 888, 888,
+    888, 888, 888, 888, 888, 888, 888, 888, 888, 888, 888, 888, 888, 888, 888, 977,
+    1056, 1121, 1196, 1277, 1357, 1417, 1462, 1490, 1540, 1607, 1682, 1712, 1802, 1866, 1912, 1986,
+    2064, 2132, 2209, 2288, 2341, 2394, 2476, 2571, 2656, 2718, 2767, 2810, 2871, 2948, 3021, 3089,
+    3157, 3216, 3277, 3329, 3395, 3478, 3555, 3611, 3655, 3694, 3751, 3820, 3869, 3909, 3992, 4032,
+    4078, 4143, 4207, 4278, 4332, 4377, 4432, 4466, 4496, 4550, 4587, 4673, 4713, 4776, 4810, 4846,
+    4901, 4993, 5045, 5083, 5123, 5135, 5162, 5239, 5282, 5331, 5373, 5402, 5425, 5441, 5461, 5488,
+    5508, 5508, 5508, 5508, 5508, 5508, 5508, 5508, 5508, 5508, 5508, 5508, 5508, 5764, 6020, 6276,
+    6532, 6788, 7044, 7300, 7556, 7812, 8068, 8324, 8580, 8836, 9092, 9348, 9604, 9860, 10116, 10372,
+    10628, 10884, 11140, 11396, 11652, 11908, 12164, 12420, 12676, 12932, 13188, 13444, 13700, 13956, 14212, 14468,
+    14724, 14980, 15236, 15492, 15748, 16004, 16260, 16516, 16680, 16680, 16680, 16680, 16680, 16680, 16680, 16680,
+    16680, 16680, 16680, 16680, 16680, 16680, 16680, 16680, 16680, 16680, 16680, 16680, 16680, 16680, 16680, 16680,
+    16680, 16680, 16680, 16680, 16680, 16680, 16680, 16680, 16680, 16680, 16936, 16948, 16948, 16948, 16948, 16948,
+    17048
+};
+static const WORD oi949[] = {  /* Index to oem2uni949[] for each upper byte of OEM code */
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 178, 356, 534, 712, 890, 1068, 1246, 1424, 1602, 1780, 1958, 2136, 2314, 2492,
+    2670, 2848, 3026, 3204, 3382, 3560, 3738, 3916, 4094, 4272, 4450, 4628, 4806, 4984, 5162, 5340,
+    5518, 5696, 5874, 6029, 6207, 6385, 6537, 6689, 6852, 7027, 7205, 7372, 7542, 7692, 7776, 7860,
+    7944, 8122, 8300, 8478, 8656, 8834, 9012, 9190, 9368, 9546, 9724, 9902, 10080, 10258, 10436, 10614,
+    10792, 10970, 11148, 11326, 11504, 11682, 11860, 11972, 12066, 12160, 12160, 12254, 12348, 12442, 12536, 12630,
+    12724, 12818, 12912, 13006, 13100, 13194, 13288, 13382, 13476, 13570, 13664, 13758, 13852, 13946, 14040, 14134,
+    14228, 14322, 14416, 14510, 14604, 14698, 14792, 14886, 14980, 15074, 15168, 15262, 15356, 15450, 15544, 15638,
+    15732, 15826, 15920, 16014, 16108, 16202, 16296, 16390, 16484, 16578, 16672, 16766, 16860, 16954, 17048, 17048,
+    17048
+};
+#endif
+#if FF_CODE_PAGE == 950 || FF_CODE_PAGE == 0    /* Traditional Chinese */
+static const WORD ui950[] = {  /* Index to uni2oem950[] for each upper byte of Unicode */
+    0, 7, 7, 13, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61,
+    61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61,
+    61, 74, 95, 117, 117, 117, 206, 210, 210, 210, 210, 210, 210, 210, 210, 210,
+    210, 238, 275, 276, 287, 287, 287, 287, 287, 287, 287, 287, 287, 287, 287, 287,
+    287, 287, 287, 287, 287, 287, 287, 287, 287, 287, 287, 287, 287, 287, 287, 414,
+    580, 756, 898, 1043, 1176, 1343, 1509, 1664, 1806, 1971, 2135, 2301, 2465, 2618, 2776, 2946,
+    3105, 3277, 3450, 3625, 3800, 3976, 4147, 4312, 4490, 4650, 4815, 4976, 5146, 5328, 5513, 5682,
+    5872, 6035, 6198, 6365, 6537, 6702, 6865, 7029, 7201, 7359, 7524, 7672, 7830, 7985, 8173, 8295,
+    8446, 8602, 8768, 8944, 9118, 9288, 9485, 9662, 9859, 10037, 10204, 10381, 10502, 10655, 10786, 10965,
+    11100, 11277, 11471, 11650, 11826, 11913, 11990, 12143, 12304, 12429, 12572, 12709, 12860, 12951, 13139, 13252,
+    13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357,
+    13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357,
+    13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357,
+    13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357,
+    13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357,
+    13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13357, 13359, 13359, 13359, 13359, 13411,
+    13503
+};
+static const WORD oi950[] = {  /* Index to oem2uni950[] for each upper byte of OEM code */
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 157, 314, 409, 566, 723, 880, 1037, 1194, 1351, 1508, 1665, 1822, 1979, 2136,
+    2293, 2450, 2607, 2764, 2921, 3078, 3235, 3392, 3549, 3706, 3863, 4020, 4177, 4334, 4491, 4648,
+    4805, 4962, 5119, 5276, 5433, 5590, 5747, 5810, 5810, 5810, 5967, 6124, 6281, 6438, 6595, 6752,
+    6909, 7066, 7223, 7380, 7537, 7694, 7851, 8008, 8165, 8322, 8479, 8636, 8793, 8950, 9107, 9264,
+    9421, 9578, 9735, 9892, 10049, 10206, 10363, 10520, 10677, 10834, 10991, 11148, 11305, 11462, 11619, 11776,
+    11933, 12090, 12247, 12404, 12561, 12718, 12875, 13032, 13189, 13346, 13503, 13503, 13503, 13503, 13503, 13503,
+    13503
+};
+#endif
+#endif
+
 
 
 
@@ -15222,6 +15745,30 @@ static const WCHAR uc869[] = {  /*  CP869(Greek 2) to Unicode conversion table *
 /* SBCS fixed code page                                                   */
 /*------------------------------------------------------------------------*/
 
+#if FF_LFN_CVTIDX && FF_CODE_PAGE < 900
+static WCHAR uni2sbcs ( /* Returns OEM code character, zero on error */
+    WCHAR uc,           /* Non-ASCII character to be converted */
+    const WCHAR* p,     /* SBCS to Unicode conversion table */
+    const BYTE* ri      /* Conversion index (0..127: index to p[] in ascending order of Unicode, 128..255: direct conversion block, 256..257: base of the block) */
+)
+{
+    UINT i, li = 0, hi = 0x80;
+
+
+    i = (UINT)uc - (ri[256] | ri[257] << 8);
+    if (i < 0x80) return ri[0x80 + i];  /* In the direct conversion block (main letters of the code page) */
+    while (li < hi) {   /* Find the first item not less than uc (7 steps) */
+        i = (li + hi) / 2;
+        if (p[ri[i]] < uc) {
+            li = i + 1;
+        } else {
+            hi = i;
+        }
+    }
+    return (li < 0x80 && p[ri[li]] == uc) ? (WCHAR)(ri[li] + 0x80) : 0;
+}
+#endif
+
 #if FF_CODE_PAGE != 0 && FF_CODE_PAGE < 900
 WCHAR ff_uni2oem (  /* Returns OEM code character, zero on error */
     DWORD   uni,    /* UTF-16 encoded character to be converted */
@@ -15237,8 +15784,12 @@ WCHAR ff_uni2oem (  /* Returns OEM code character, zero on error */
 
     } else {            /* Non-ASCII */
         if (uni < 0x10000 && cp == FF_CODE_PAGE) {  /* Is it in BMP and valid code page? */
+#if FF_LFN_CVTIDX
+            c = uni2sbcs((WCHAR)uni, p, CVTBL(ri, FF_CODE_PAGE));
+#else
             for (c = 0; c < 0x80 && uni != p[c]; c++) ;
             c = (c + 0x80) & 0xFF;
+#endif
         }
     }
 
@@ -15275,6 +15826,49 @@ WCHAR ff_oem2uni (  /* Returns Unicode character, zero on error */
 /* DBCS fixed code page                                                   */
 /*------------------------------------------------------------------------*/
 
+#if FF_LFN_CVTIDX && (FF_CODE_PAGE >= 900 || FF_CODE_PAGE == 0)
+static WCHAR dbc_find ( /* Returns the paired code, zero if not found */
+    WCHAR key,          /* Code to be found */
+    const WCHAR* p,     /* Code pair table in ascending order of the key */
+    const WORD* ix      /* Index to p[] for each upper byte of the key (257 items) */
+)
+{
+    UINT i, li, hi, top, end, n;
+
+
+    top = li = ix[key >> 8]; end = hi = ix[(key >> 8) + 1]; /* Range of the pairs with the same upper byte */
+    if (li < hi && key >= p[li * 2]) {
+        i = li + key - p[li * 2];   /* Try the position assuming the keys are dense in the range */
+        if (i >= hi || p[i * 2] != key) {
+            while (li < hi) {       /* Find the key in the range (8 steps at most) */
+                i = (li + hi) / 2;
+                if (p[i * 2] < key) {
+                    li = i + 1;
+                } else {
+                    hi = i;
+                }
+            }
+            if (li >= end || p[li * 2] != key) return 0;
+            i = li;
+        }
+        if ((i + 1 < end && p[i * 2 + 2] == key) || (i > top && p[i * 2 - 2] == key)) {  /* Is the key duplicated in the table? */
+            li = 0; hi = ix[256];   /* Take the pair found by the binary search over the whole table (ix[256] is the terminator) */
+            for (n = 16; n; n--) {
+                i = li + (hi - li) / 2;
+                if (key == p[i * 2]) break;
+                if (key > p[i * 2]) {
+                    li = i;
+                } else {
+                    hi = i;
+                }
+            }
+        }
+        return p[i * 2 + 1];
+    }
+    return 0;
+}
+#endif
+
 #if FF_CODE_PAGE >= 900
 WCHAR ff_uni2oem (  /* Returns OEM code character, zero on error */
     DWORD   uni,    /* UTF-16 encoded character to be converted */
@@ -15283,7 +15877,9 @@ WCHAR ff_uni2oem (  /* Returns OEM code character, zero on error */
 {
     const WCHAR *p;
     WCHAR c = 0, uc;
+#if !FF_LFN_CVTIDX
     UINT i = 0, n, li, hi;
+#endif
 
 
     if (uni < 0x80) {   /* ASCII? */
@@ -15293,6 +15889,9 @@ WCHAR ff_uni2oem (  /* Returns OEM code character, zero on error */
         if (uni < 0x10000 && cp == FF_CODE_PAGE) {  /* Is it in BMP and valid code page? */
             uc = (WCHAR)uni;
             p = CVTBL(uni2oem, FF_CODE_PAGE);
+#if FF_LFN_CVTIDX
+            c = dbc_find(uc, p, CVTBL(ui, FF_CODE_PAGE));
+#else
             hi = sizeof CVTBL(uni2oem, FF_CODE_PAGE) / 4 - 1;
             li = 0;
             for (n = 16; n; n--) {
@@ -15305,6 +15904,7 @@ WCHAR ff_uni2oem (  /* Returns OEM code character, zero on error */
                 }
             }
             if (n != 0) c = p[i * 2 + 1];
+#endif
         }
     }
 
@@ -15319,7 +15919,9 @@ WCHAR ff_oem2uni (  /* Returns Unicode character, zero on error */
 {
     const WCHAR *p;
     WCHAR c = 0;
+#if !FF_LFN_CVTIDX
     UINT i = 0, n, li, hi;
+#endif
 
 
     if (oem < 0x80) {   /* ASCII? */
@@ -15328,6 +15930,9 @@ WCHAR ff_oem2uni (  /* Returns Unicode character, zero on error */
     } else {            /* Extended char */
         if (cp == FF_CODE_PAGE) {   /* Is it valid code page? */
             p = CVTBL(oem2uni, FF_CODE_PAGE);
+#if FF_LFN_CVTIDX
+            c = dbc_find(oem, p, CVTBL(oi, FF_CODE_PAGE));
+#else
             hi = sizeof CVTBL(oem2uni, FF_CODE_PAGE) / 4 - 1;
             li = 0;
             for (n = 16; n; n--) {
@@ -15340,6 +15945,7 @@ WCHAR ff_oem2uni (  /* Returns Unicode character, zero on error */
                 }
             }
             if (n != 0) c = p[i * 2 + 1];
+#endif
         }
     }
 
@@ -15357,6 +15963,9 @@ WCHAR ff_oem2uni (  /* Returns Unicode character, zero on error */
 
 static const WORD cp_code[]          = {  437,   720,   737,   771,   775,   850,   852,   855,   857,   860,   861,   862,   863,   864,   865,   866,   869, 0};
 static const WCHAR* const cp_table[] = {uc437, uc720, uc737, uc771, uc775, uc850, uc852, uc855, uc857, uc860, uc861, uc862, uc863, uc864, uc865, uc866, uc869, 0};
+#if FF_LFN_CVTIDX
+static const BYTE* const cp_ridx[]   = {ri437, ri720, ri737, ri771, ri775, ri850, ri852, ri855, ri857, ri860, ri861, ri862, ri863, ri864, ri865, ri866, ri869, 0};
+#endif
 
 
 WCHAR ff_uni2oem (  /* Returns OEM code character, zero on error */
@@ -15366,7 +15975,12 @@ WCHAR ff_uni2oem (  /* Returns OEM code character, zero on error */
 {
     const WCHAR *p;
     WCHAR c = 0, uc;
+#if FF_LFN_CVTIDX
+    UINT i;
+    const WORD *ix = 0;
+#else
     UINT i, n, li, hi;
+#endif
 
 
     if (uni < 0x80) {   /* ASCII? */
@@ -15380,11 +15994,25 @@ WCHAR ff_uni2oem (  /* Returns OEM code character, zero on error */
                 for (i = 0; cp_code[i] != 0 && cp_code[i] != cp; i++) ;     /* Get conversion table */
                 p = cp_table[i];
                 if (p) {    /* Is it valid code page ? */
+#if FF_LFN_CVTIDX
+                    c = uni2sbcs(uc, p, cp_ridx[i]);    /* Find OEM code with the index */
+#else
                     for (c = 0; c < 0x80 && uc != p[c]; c++) ;  /* Find OEM code in the table */
                     c = (c + 0x80) & 0xFF;
+#endif
                 }
             } else {    /* DBCS */
                 switch (cp) {   /* Get conversion table */
+#if FF_LFN_CVTIDX
+                case 932 : p = uni2oem932; ix = ui932; break;
+                case 936 : p = uni2oem936; ix = ui936; break;
+                case 949 : p = uni2oem949; ix = ui949; break;
+                case 950 : p = uni2oem950; ix = ui950; break;
+                }
+                if (p) {    /* Is it valid code page? */
+                    c = dbc_find(uc, p, ix);    /* Find OEM code with the index */
+                }
+#else
                 case 932 : p = uni2oem932; hi = sizeof uni2oem932 / 4 - 1; break;
                 case 936 : p = uni2oem936; hi = sizeof uni2oem936 / 4 - 1; break;
                 case 949 : p = uni2oem949; hi = sizeof uni2oem949 / 4 - 1; break;
@@ -15403,6 +16031,7 @@ WCHAR ff_uni2oem (  /* Returns OEM code character, zero on error */
                     }
                     if (n != 0) c = p[i * 2 + 1];
                 }
+#endif
             }
         }
     }
@@ -15418,7 +16047,12 @@ WCHAR ff_oem2uni (  /* Returns Unicode character, zero on error */
 {
     const WCHAR *p;
     WCHAR c = 0;
+#if FF_LFN_CVTIDX
+    UINT i;
+    const WORD *ix = 0;
+#else
     UINT i, n, li, hi;
+#endif
 
 
     if (oem < 0x80) {   /* ASCII? */
@@ -15434,6 +16068,16 @@ WCHAR ff_oem2uni (  /* Returns Unicode character, zero on error */
             }
         } else {    /* DBCS */
             switch (cp) {
+#if FF_LFN_CVTIDX
+            case 932 : p = oem2uni932; ix = oi932; break;
+            case 936 : p = oem2uni936; ix = oi936; break;
+            case 949 : p = oem2uni949; ix = oi949; break;
+            case 950 : p = oem2uni950; ix = oi950; break;
+            }
+            if (p) {
+                c = dbc_find(oem, p, ix);
+            }
+#else
             case 932 : p = oem2uni932; hi = sizeof oem2uni932 / 4 - 1; break;
             case 936 : p = oem2uni936; hi = sizeof oem2uni936 / 4 - 1; break;
             case 949 : p = oem2uni949; hi = sizeof oem2uni949 / 4 - 1; break;
@@ -15452,6 +16096,7 @@ WCHAR ff_oem2uni (  /* Returns Unicode character, zero on error */
                 }
                 if (n != 0) c = p[i * 2 + 1];
             }
+#endif
         }
     }
 
@@ -15465,6 +16110,293 @@ WCHAR ff_oem2uni (  /* Returns Unicode character, zero on error */
 /* Unicode up-case conversion                                             */
 /*------------------------------------------------------------------------*/
 
+#if FF_LFN_UPTBL
+/* Two-level up-case conversion table of BMP (expanded from the compressed table) */
+static const BYTE uptbl_idx[] = {   /* Page number in uptbl_pg[] + 1 for each upper byte of BMP code point (0:No conversion) */
+    1, 2, 3, 4, 5, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 8, 9,
+    0, 10, 0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 12, 13, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 14
+};
+static const WCHAR uptbl_pg[][256] = {  /* Up-case conversion table pages */
+    {   /* U+0000 - U+00FF */
+        0x0000, 0x0001, 0x0002, 0x0003, 0x0004, 0x0005, 0x0006, 0x0007, 0x0008, 0x0009, 0x000A, 0x000B, 0x000C, 0x000D, 0x000E, 0x000F,
+        0x0010, 0x0011, 0x0012, 0x0013, 0x0014, 0x0015, 0x0016, 0x0017, 0x0018, 0x0019, 0x001A, 0x001B, 0x001C, 0x001D, 0x001E, 0x001F,
+        0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027, 0x0028, 0x0029, 0x002A, 0x002B, 0x002C, 0x002D, 0x002E, 0x002F,
+        0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037, 0x0038, 0x0039, 0x003A, 0x003B, 0x003C, 0x003D, 0x003E, 0x003F,
+        0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047, 0x0048, 0x0049, 0x004A, 0x004B, 0x004C, 0x004D, 0x004E, 0x004F,
+        0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057, 0x0058, 0x0059, 0x005A, 0x005B, 0x005C, 0x005D, 0x005E, 0x005F,
+        0x0060, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047, 0x0048, 0x0049, 0x004A, 0x004B, 0x004C, 0x004D, 0x004E, 0x004F,
+        0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057, 0x0058, 0x0059, 0x005A, 0x007B, 0x007C, 0x007D, 0x007E, 0x007F,
+        0x0080, 0x0081, 0x0082, 0x0083, 0x0084, 0x0085, 0x0086, 0x0087, 0x0088, 0x0089, 0x008A, 0x008B, 0x008C, 0x008D, 0x008E, 0x008F,
+        0x0090, 0x0091, 0x0092, 0x0093, 0x0094, 0x0095, 0x0096, 0x0097, 0x0098, 0x0099, 0x009A, 0x009B, 0x009C, 0x009D, 0x009E, 0x009F,
+        0x00A0, 0x00A1, 0x00A2, 0x00A3, 0x00A4, 0x00A5, 0x00A6, 0x00A7, 0x00A8, 0x00A9, 0x00AA, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x00AF,
+        0x00B0, 0x00B1, 0x00B2, 0x00B3, 0x00B4, 0x00B5, 0x00B6, 0x00B7, 0x00B8, 0x00B9, 0x00BA, 0x00BB, 0x00BC, 0x00BD, 0x00BE, 0x00BF,
+        0x00C0, 0x00C1, 0x00C2, 0x00C3, 0x00C4, 0x00C5, 0x00C6, 0x00C7, 0x00C8, 0x00C9, 0x00CA, 0x00CB, 0x00CC, 0x00CD, 0x00CE, 0x00CF,
+        0x00D0, 0x00D1, 0x00D2, 0x00D3, 0x00D4, 0x00D5, 0x00D6, 0x00D7, 0x00D8, 0x00D9, 0x00DA, 0x00DB, 0x00DC, 0x00DD, 0x00DE, 0x00DF,
+        0x00C0, 0x00C1, 0x00C2, 0x00C3, 0x00C4, 0x00C5, 0x00C6, 0x00C7, 0x00C8, 0x00C9, 0x00CA, 0x00CB, 0x00CC, 0x00CD, 0x00CE, 0x00CF,
+        0x00D0, 0x00D1, 0x00D2, 0x00D3, 0x00D4, 0x00D5, 0x00D6, 0x00F7, 0x00D8, 0x00D9, 0x00DA, 0x00DB, 0x00DC, 0x00DD, 0x00DE, 0x0178
+    },
+    {   /* U+0100 - U+01FF */
+        0x0100, 0x0100, 0x0102, 0x0102, 0x0104, 0x0104, 0x0106, 0x0106, 0x0108, 0x0108, 0x010A, 0x010A, 0x010C, 0x010C, 0x010E, 0x010E,
+        0x0110, 0x0110, 0x0112, 0x0112, 0x0114, 0x0114, 0x0116, 0x0116, 0x0118, 0x0118, 0x011A, 0x011A, 0x011C, 0x011C, 0x011E, 0x011E,
+        0x0120, 0x0120, 0x0122, 0x0122, 0x0124, 0x0124, 0x0126, 0x0126, 0x0128, 0x0128, 0x012A, 0x012A, 0x012C, 0x012C, 0x012E, 0x012E,
+        0x0130, 0x0131, 0x0132, 0x0132, 0x0134, 0x0134, 0x0136, 0x0136, 0x0138, 0x0139, 0x0139, 0x013B, 0x013B, 0x013D, 0x013D, 0x013F,
+        0x013F, 0x0141, 0x0141, 0x0143, 0x0143, 0x0145, 0x0145, 0x0147, 0x0147, 0x0149, 0x014A, 0x014A, 0x014C, 0x014C, 0x014E, 0x014E,
+        0x0150, 0x0150, 0x0152, 0x0152, 0x0154, 0x0154, 0x0156, 0x0156, 0x0158, 0x0158, 0x015A, 0x015A, 0x015C, 0x015C, 0x015E, 0x015E,
+        0x0160, 0x0160, 0x0162, 0x0162, 0x0164, 0x0164, 0x0166, 0x0166, 0x0168, 0x0168, 0x016A, 0x016A, 0x016C, 0x016C, 0x016E, 0x016E,
+        0x0170, 0x0170, 0x0172, 0x0172, 0x0174, 0x0174, 0x0176, 0x0176, 0x0178, 0x0179, 0x0179, 0x017B, 0x017B, 0x017D, 0x017D, 0x017F,
+        0x0243, 0x0181, 0x0182, 0x0182, 0x0184, 0x0184, 0x0186, 0x0187, 0x0187, 0x0189, 0x018A, 0x018B, 0x018B, 0x018D, 0x018E, 0x018F,
+        0x0190, 0x0191, 0x0191, 0x0193, 0x0194, 0x01F6, 0x0196, 0x0197, 0x0198, 0x0198, 0x023D, 0x019B, 0x019C, 0x019D, 0x0220, 0x019F,
+        0x01A0, 0x01A0, 0x01A2, 0x01A2, 0x01A4, 0x01A4, 0x01A6, 0x01A7, 0x01A7, 0x01A9, 0x01AA, 0x01AB, 0x01AC, 0x01AC, 0x01AE, 0x01AF,
+        0x01AF, 0x01B1, 0x01B2, 0x01B3, 0x01B3, 0x01B5, 0x01B5, 0x01B7, 0x01B8, 0x01B8, 0x01BA, 0x01BB, 0x01BC, 0x01BC, 0x01BE, 0x01F7,
+        0x01C0, 0x01C1, 0x01C2, 0x01C3, 0x01C4, 0x01C5, 0x01C4, 0x01C7, 0x01C8, 0x01C7, 0x01CA, 0x01CB, 0x01CA, 0x01CD, 0x01CD, 0x01CF,
+        0x01CF, 0x01D1, 0x01D1, 0x01D3, 0x01D3, 0x01D5, 0x01D5, 0x01D7, 0x01D7, 0x01D9, 0x01D9, 0x01DB, 0x01DB, 0x018E, 0x01DE, 0x01DE,
+        0x01E0, 0x01E0, 0x01E2, 0x01E2, 0x01E4, 0x01E4, 0x01E6, 0x01E6, 0x01E8, 0x01E8, 0x01EA, 0x01EA, 0x01EC, 0x01EC, 0x01EE, 0x01EE,
+        0x01F0, 0x01F1, 0x01F2, 0x01F1, 0x01F4, 0x01F4, 0x01F6, 0x01F7, 0x01F8, 0x01F8, 0x01FA, 0x01FA, 0x01FC, 0x01FC, 0x01FE, 0x01FE
+    },
+    {   /* U+0200 - U+02FF */
+        0x0200, 0x0200, 0x0202, 0x0202, 0x0204, 0x0204, 0x0206, 0x0206, 0x0208, 0x0208, 0x020A, 0x020A, 0x020C, 0x020C, 0x020E, 0x020E,
+        0x0210, 0x0210, 0x0212, 0x0212, 0x0214, 0x0214, 0x0216, 0x0216, 0x0218, 0x0218, 0x021A, 0x021A, 0x021C, 0x021C, 0x021E, 0x021E,
+        0x0220, 0x0221, 0x0222, 0x0222, 0x0224, 0x0224, 0x0226, 0x0226, 0x0228, 0x0228, 0x022A, 0x022A, 0x022C, 0x022C, 0x022E, 0x022E,
+        0x0230, 0x0230, 0x0232, 0x0232, 0x0234, 0x0235, 0x0236, 0x0237, 0x0238, 0x0239, 0x2C65, 0x023B, 0x023B, 0x023D, 0x2C66, 0x023F,
+        0x0240, 0x0241, 0x0241, 0x0243, 0x0244, 0x0245, 0x0246, 0x0246, 0x0248, 0x0248, 0x024A, 0x024A, 0x024C, 0x024C, 0x024E, 0x024E,
+        0x0250, 0x0251, 0x0252, 0x0181, 0x0186, 0x0255, 0x0189, 0x018A, 0x0258, 0x018F, 0x025A, 0x0190, 0x025C, 0x025D, 0x025E, 0x025F,
+        0x0193, 0x0261, 0x0262, 0x0194, 0x0264, 0x0265, 0x0266, 0x0267, 0x0197, 0x0196, 0x026A, 0x2C62, 0x026C, 0x026D, 0x026E, 0x019C,
+        0x0270, 0x0271, 0x019D, 0x0273, 0x0274, 0x019F, 0x0276, 0x0277, 0x0278, 0x0279, 0x027A, 0x027B, 0x027C, 0x2C64, 0x027E, 0x027F,
+        0x01A6, 0x0281, 0x0282, 0x01A9, 0x0284, 0x0285, 0x0286, 0x0287, 0x01AE, 0x0244, 0x01B1, 0x01B2, 0x0245, 0x028D, 0x028E, 0x028F,
+        0x0290, 0x0291, 0x01B7, 0x0293, 0x0294, 0x0295, 0x0296, 0x0297, 0x0298, 0x0299, 0x029A, 0x029B, 0x029C, 0x029D, 0x029E, 0x029F,
+        0x02A0, 0x02A1, 0x02A2, 0x02A3, 0x02A4, 0x02A5, 0x02A6, 0x02A7, 0x02A8, 0x02A9, 0x02AA, 0x02AB, 0x02AC, 0x02AD, 0x02AE, 0x02AF,
+        0x02B0, 0x02B1, 0x02B2, 0x02B3, 0x02B4, 0x02B5, 0x02B6, 0x02B7, 0x02B8, 0x02B9, 0x02BA, 0x02BB, 0x02BC, 0x02BD, 0x02BE, 0x02BF,
+        0x02C0, 0x02C1, 0x02C2, 0x02C3, 0x02C4, 0x02C5, 0x02C6, 0x02C7, 0x02C8, 0x02C9, 0x02CA, 0x02CB, 0x02CC, 0x02CD, 0x02CE, 0x02CF,
+        0x02D0, 0x02D1, 0x02D2, 0x02D3, 0x02D4, 0x02D5, 0x02D6, 0x02D7, 0x02D8, 0x02D9, 0x02DA, 0x02DB, 0x02DC, 0x02DD, 0x02DE, 0x02DF,
+        0x02E0, 0x02E1, 0x02E2, 0x02E3, 0x02E4, 0x02E5, 0x02E6, 0x02E7, 0x02E8, 0x02E9, 0x02EA, 0x02EB, 0x02EC, 0x02ED, 0x02EE, 0x02EF,
+        0x02F0, 0x02F1, 0x02F2, 0x02F3, 0x02F4, 0x02F5, 0x02F6, 0x02F7, 0x02F8, 0x02F9, 0x02FA, 0x02FB, 0x02FC, 0x02FD, 0x02FE, 0x02FF
+    },
+    {   /* U+0300 - U+03FF */
+        0x0300, 0x0301, 0x0302, 0x0303, 0x0304, 0x0305, 0x0306, 0x0307, 0x0308, 0x0309, 0x030A, 0x030B, 0x030C, 0x030D, 0x030E, 0x030F,
+        0x0310, 0x0311, 0x0312, 0x0313, 0x0314, 0x0315, 0x0316, 0x0317, 0x0318, 0x0319, 0x031A, 0x031B, 0x031C, 0x031D, 0x031E, 0x031F,
+        0x0320, 0x0321, 0x0322, 0x0323, 0x0324, 0x0325, 0x0326, 0x0327, 0x0328, 0x0329, 0x032A, 0x032B, 0x032C, 0x032D, 0x032E, 0x032F,
+        0x0330, 0x0331, 0x0332, 0x0333, 0x0334, 0x0335, 0x0336, 0x0337, 0x0338, 0x0339, 0x033A, 0x033B, 0x033C, 0x033D, 0x033E, 0x033F,
+        0x0340, 0x0341, 0x0342, 0x0343, 0x0344, 0x0345, 0x0346, 0x0347, 0x0348, 0x0349, 0x034A, 0x034B, 0x034C, 0x034D, 0x034E, 0x034F,
+        0x0350, 0x0351, 0x0352, 0x0353, 0x0354, 0x0355, 0x0356, 0x0357, 0x0358, 0x0359, 0x035A, 0x035B, 0x035C, 0x035D, 0x035E, 0x035F,
+        0x0360, 0x0361, 0x0362, 0x0363, 0x0364, 0x0365, 0x0366, 0x0367, 0x0368, 0x0369, 0x036A, 0x036B, 0x036C, 0x036D, 0x036E, 0x036F,
+        0x0370, 0x0371, 0x0372, 0x0373, 0x0374, 0x0375, 0x0376, 0x0377, 0x0378, 0x0379, 0x037A, 0x03FD, 0x03FE, 0x03FF, 0x037E, 0x037F,
+        0x0380, 0x0381, 0x0382, 0x0383, 0x0384, 0x0385, 0x0386, 0x0387, 0x0388, 0x0389, 0x038A, 0x038B, 0x038C, 0x038D, 0x038E, 0x038F,
+        0x0390, 0x0391, 0x0392, 0x0393, 0x0394, 0x0395, 0x0396, 0x0397, 0x0398, 0x0399, 0x039A, 0x039B, 0x039C, 0x039D, 0x039E, 0x039F,
+        0x03A0, 0x03A1, 0x03A2, 0x03A3, 0x03A4, 0x03A5, 0x03A6, 0x03A7, 0x03A8, 0x03A9, 0x03AA, 0x03AB, 0x0386, 0x0388, 0x0389, 0x038A,
+        0x03B0, 0x0391, 0x0392, 0x0393, 0x0394, 0x0395, 0x0396, 0x0397, 0x0398, 0x0399, 0x039A, 0x039B, 0x039C, 0x039D, 0x039E, 0x039F,
+        0x03A0, 0x03A1, 0x03A3, 0x03A3, 0x03A4, 0x03A5, 0x03A6, 0x03A7, 0x03A8, 0x03A9, 0x03AA, 0x03AB, 0x038C, 0x038E, 0x038F, 0x03CF,
+        0x03D0, 0x03D1, 0x03D2, 0x03D3, 0x03D4, 0x03D5, 0x03D6, 0x03D7, 0x03D8, 0x03D8, 0x03DA, 0x03DA, 0x03DC, 0x03DC, 0x03DE, 0x03DE,
+        0x03E0, 0x03E0, 0x03E2, 0x03E2, 0x03E4, 0x03E4, 0x03E6, 0x03E6, 0x03E8, 0x03E8, 0x03EA, 0x03EA, 0x03EC, 0x03EC, 0x03EE, 0x03EE,
+        0x03F0, 0x03F1, 0x03F9, 0x03F3, 0x03F4, 0x03F5, 0x03F6, 0x03F7, 0x03F7, 0x03F9, 0x03FA, 0x03FA, 0x03FC, 0x03FD, 0x03FE, 0x03FF
+    },
+    {   /* U+0400 - U+04FF */
+        0x0400, 0x0401, 0x0402, 0x0403, 0x0404, 0x0405, 0x0406, 0x0407, 0x0408, 0x0409, 0x040A, 0x040B, 0x040C, 0x040D, 0x040E, 0x040F,
+        0x0410, 0x0411, 0x0412, 0x0413, 0x0414, 0x0415, 0x0416, 0x0417, 0x0418, 0x0419, 0x041A, 0x041B, 0x041C, 0x041D, 0x041E, 0x041F,
+        0x0420, 0x0421, 0x0422, 0x0423, 0x0424, 0x0425, 0x0426, 0x0427, 0x0428, 0x0429, 0x042A, 0x042B, 0x042C, 0x042D, 0x042E, 0x042F,
+        0x0410, 0x0411, 0x0412, 0x0413, 0x0414, 0x0415, 0x0416, 0x0417, 0x0418, 0x0419, 0x041A, 0x041B, 0x041C, 0x041D, 0x041E, 0x041F,
+        0x0420, 0x0421, 0x0422, 0x0423, 0x0424, 0x0425, 0x0426, 0x0427, 0x0428, 0x0429, 0x042A, 0x042B, 0x042C, 0x042D, 0x042E, 0x042F,
+        0x0400, 0x0401, 0x0402, 0x0403, 0x0404, 0x0405, 0x0406, 0x0407, 0x0408, 0x0409, 0x040A, 0x040B, 0x040C, 0x040D, 0x040E, 0x040F,
+        0x0460, 0x0460, 0x0462, 0x0462, 0x0464, 0x0464, 0x0466, 0x0466, 0x0468, 0x0468, 0x046A, 0x046A, 0x046C, 0x046C, 0x046E, 0x046E,
+        0x0470, 0x0470, 0x0472, 0x0472, 0x0474, 0x0474, 0x0476, 0x0476, 0x0478, 0x0478, 0x047A, 0x047A, 0x047C, 0x047C, 0x047E, 0x047E,
+        0x0480, 0x0480, 0x0482, 0x0483, 0x0484, 0x0485, 0x0486, 0x0487, 0x0488, 0x0489, 0x048A, 0x048A, 0x048C, 0x048C, 0x048E, 0x048E,
+        0x0490, 0x0490, 0x0492, 0x0492, 0x0494, 0x0494, 0x0496, 0x0496, 0x0498, 0x0498, 0x049A, 0x049A, 0x049C, 0x049C, 0x049E, 0x049E,
+        0x04A0, 0x04A0, 0x04A2, 0x04A2, 0x04A4, 0x04A4, 0x04A6, 0x04A6, 0x04A8, 0x04A8, 0x04AA, 0x04AA, 0x04AC, 0x04AC, 0x04AE, 0x04AE,
+        0x04B0, 0x04B0, 0x04B2, 0x04B2, 0x04B4, 0x04B4, 0x04B6, 0x04B6, 0x04B8, 0x04B8, 0x04BA, 0x04BA, 0x04BC, 0x04BC, 0x04BE, 0x04BE,
+        0x04C0, 0x04C1, 0x04C1, 0x04C3, 0x04C3, 0x04C5, 0x04C5, 0x04C7, 0x04C7, 0x04C9, 0x04C9, 0x04CB, 0x04CB, 0x04CD, 0x04CD, 0x04C0,
+        0x04D0, 0x04D0, 0x04D2, 0x04D2, 0x04D4, 0x04D4, 0x04D6, 0x04D6, 0x04D8, 0x04D8, 0x04DA, 0x04DA, 0x04DC, 0x04DC, 0x04DE, 0x04DE,
+        0x04E0, 0x04E0, 0x04E2, 0x04E2, 0x04E4, 0x04E4, 0x04E6, 0x04E6, 0x04E8, 0x04E8, 0x04EA, 0x04EA, 0x04EC, 0x04EC, 0x04EE, 0x04EE,
+        0x04F0, 0x04F0, 0x04F2, 0x04F2, 0x04F4, 0x04F4, 0x04F6, 0x04F6, 0x04F8, 0x04F8, 0x04FA, 0x04FA, 0x04FC, 0x04FC, 0x04FE, 0x04FE
+    },
+    {   /* U+0500 - U+05FF */
+        0x0500, 0x0500, 0x0502, 0x0502, 0x0504, 0x0504, 0x0506, 0x0506, 0x0508, 0x0508, 0x050A, 0x050A, 0x050C, 0x050C, 0x050E, 0x050E,
+        0x0510, 0x0510, 0x0512, 0x0512, 0x0514, 0x0515, 0x0516, 0x0517, 0x0518, 0x0519, 0x051A, 0x051B, 0x051C, 0x051D, 0x051E, 0x051F,
+        0x0520, 0x0521, 0x0522, 0x0523, 0x0524, 0x0525, 0x0526, 0x0527, 0x0528, 0x0529, 0x052A, 0x052B, 0x052C, 0x052D, 0x052E, 0x052F,
+        0x0530, 0x0531, 0x0532, 0x0533, 0x0534, 0x0535, 0x0536, 0x0537, 0x0538, 0x0539, 0x053A, 0x053B, 0x053C, 0x053D, 0x053E, 0x053F,
+        0x0540, 0x0541, 0x0542, 0x0543, 0x0544, 0x0545, 0x0546, 0x0547, 0x0548, 0x0549, 0x054A, 0x054B, 0x054C, 0x054D, 0x054E, 0x054F,
+        0x0550, 0x0551, 0x0552, 0x0553, 0x0554, 0x0555, 0x0556, 0x0557, 0x0558, 0x0559, 0x055A, 0x055B, 0x055C, 0x055D, 0x055E, 0x055F,
+        0x0560, 0x0531, 0x0532, 0x0533, 0x0534, 0x0535, 0x0536, 0x0537, 0x0538, 0x0539, 0x053A, 0x053B, 0x053C, 0x053D, 0x053E, 0x053F,
+        0x0540, 0x0541, 0x0542, 0x0543, 0x0544, 0x0545, 0x0546, 0x0547, 0x0548, 0x0549, 0x054A, 0x054B, 0x054C, 0x054D, 0x054E, 0x054F,
+        0x0550, 0x0551, 0x0552, 0x0553, 0x0554, 0x0555, 0x0556, 0x0587, 0x0588, 0x0589, 0x058A, 0x058B, 0x058C, 0x058D, 0x058E, 0x058F,
+        0x0590, 0x0591, 0x0592, 0x0593, 0x0594, 0x0595, 0x0596, 0x0597, 0x0598, 0x0599, 0x059A, 0x059B, 0x059C, 0x059D, 0x059E, 0x059F,
+        0x05A0, 0x05A1, 0x05A2, 0x05A3, 0x05A4, 0x05A5, 0x05A6, 0x05A7, 0x05A8, 0x05A9, 0x05AA, 0x05AB, 0x05AC, 0x05AD, 0x05AE, 0x05AF,
+        0x05B0, 0x05B1, 0x05B2, 0x05B3, 0x05B4, 0x05B5, 0x05B6, 0x05B7, 0x05B8, 0x05B9, 0x05BA, 0x05BB, 0x05BC, 0x05BD, 0x05BE, 0x05BF,
+        0x05C0, 0x05C1, 0x05C2, 0x05C3, 0x05C4, 0x05C5, 0x05C6, 0x05C7, 0x05C8, 0x05C9, 0x05CA, 0x05CB, 0x05CC, 0x05CD, 0x05CE, 0x05CF,
+        0x05D0, 0x05D1, 0x05D2, 0x05D3, 0x05D4, 0x05D5, 0x05D6, 0x05D7, 0x05D8, 0x05D9, 0x05DA, 0x05DB, 0x05DC, 0x05DD, 0x05DE, 0x05DF,
+        0x05E0, 0x05E1, 0x05E2, 0x05E3, 0x05E4, 0x05E5, 0x05E6, 0x05E7, 0x05E8, 0x05E9, 0x05EA, 0x05EB, 0x05EC, 0x05ED, 0x05EE, 0x05EF,
+        0x05F0, 0x05F1, 0x05F2, 0x05F3, 0x05F4, 0x05F5, 0x05F6, 0x05F7, 0x05F8, 0x05F9, 0x05FA, 0x05FB, 0x05FC, 0x05FD, 0x05FE, 0x05FF
+    },
+    {   /* U+1D00 - U+1DFF */
+        0x1D00, 0x1D01, 0x1D02, 0x1D03, 0x1D04, 0x1D05, 0x1D06, 0x1D07, 0x1D08, 0x1D09, 0x1D0A, 0x1D0B, 0x1D0C, 0x1D0D, 0x1D0E, 0x1D0F,
+        0x1D10, 0x1D11, 0x1D12, 0x1D13, 0x1D14, 0x1D15, 0x1D16, 0x1D17, 0x1D18, 0x1D19, 0x1D1A, 0x1D1B, 0x1D1C, 0x1D1D, 0x1D1E, 0x1D1F,
+        0x1D20, 0x1D21, 0x1D22, 0x1D23, 0x1D24, 0x1D25, 0x1D26, 0x1D27, 0x1D28, 0x1D29, 0x1D2A, 0x1D2B, 0x1D2C, 0x1D2D, 0x1D2E, 0x1D2F,
+        0x1D30, 0x1D31, 0x1D32, 0x1D33, 0x1D34, 0x1D35, 0x1D36, 0x1D37, 0x1D38, 0x1D39, 0x1D3A, 0x1D3B, 0x1D3C, 0x1D3D, 0x1D3E, 0x1D3F,
+        0x1D40, 0x1D41, 0x1D42, 0x1D43, 0x1D44, 0x1D45, 0x1D46, 0x1D47, 0x1D48, 0x1D49, 0x1D4A, 0x1D4B, 0x1D4C, 0x1D4D, 0x1D4E, 0x1D4F,
+        0x1D50, 0x1D51, 0x1D52, 0x1D53, 0x1D54, 0x1D55, 0x1D56, 0x1D57, 0x1D58, 0x1D59, 0x1D5A, 0x1D5B, 0x1D5C, 0x1D5D, 0x1D5E, 0x1D5F,
+        0x1D60, 0x1D61, 0x1D62, 0x1D63, 0x1D64, 0x1D65, 0x1D66, 0x1D67, 0x1D68, 0x1D69, 0x1D6A, 0x1D6B, 0x1D6C, 0x1D6D, 0x1D6E, 0x1D6F,
+        0x1D70, 0x1D71, 0x1D72, 0x1D73, 0x1D74, 0x1D75, 0x1D76, 0x1D77, 0x1D78, 0x1D79, 0x1D7A, 0x1D7B, 0x1D7C, 0x2C63, 0x1D7E, 0x1D7F,
+        0x1D80, 0x1D81, 0x1D82, 0x1D83, 0x1D84, 0x1D85, 0x1D86, 0x1D87, 0x1D88, 0x1D89, 0x1D8A, 0x1D8B, 0x1D8C, 0x1D8D, 0x1D8E, 0x1D8F,
+        0x1D90, 0x1D91, 0x1D92, 0x1D93, 0x1D94, 0x1D95, 0x1D96, 0x1D97, 0x1D98, 0x1D99, 0x1D9A, 0x1D9B, 0x1D9C, 0x1D9D, 0x1D9E, 0x1D9F,
+        0x1DA0, 0x1DA1, 0x1DA2, 0x1DA3, 0x1DA4, 0x1DA5, 0x1DA6, 0x1DA7, 0x1DA8, 0x1DA9, 0x1DAA, 0x1DAB, 0x1DAC, 0x1DAD, 0x1DAE, 0x1DAF,
+        0x1DB0, 0x1DB1, 0x1DB2, 0x1DB3, 0x1DB4, 0x1DB5, 0x1DB6, 0x1DB7, 0x1DB8, 0x1DB9, 0x1DBA, 0x1DBB, 0x1DBC, 0x1DBD, 0x1DBE, 0x1DBF,
+        0x1DC0, 0x1DC1, 0x1DC2, 0x1DC3, 0x1DC4, 0x1DC5, 0x1DC6, 0x1DC7, 0x1DC8, 0x1DC9, 0x1DCA, 0x1DCB, 0x1DCC, 0x1DCD, 0x1DCE, 0x1DCF,
+        0x1DD0, 0x1DD1, 0x1DD2, 0x1DD3, 0x1DD4, 0x1DD5, 0x1DD6, 0x1DD7, 0x1DD8, 0x1DD9, 0x1DDA, 0x1DDB, 0x1DDC, 0x1DDD, 0x1DDE, 0x1DDF,
+        0x1DE0, 0x1DE1, 0x1DE2, 0x1DE3, 0x1DE4, 0x1DE5, 0x1DE6, 0x1DE7, 0x1DE8, 0x1DE9, 0x1DEA, 0x1DEB, 0x1DEC, 0x1DED, 0x1DEE, 0x1DEF,
+        0x1DF0, 0x1DF1, 0x1DF2, 0x1DF3, 0x1DF4, 0x1DF5, 0x1DF6, 0x1DF7, 0x1DF8, 0x1DF9, 0x1DFA, 0x1DFB, 0x1DFC, 0x1DFD, 0x1DFE, 0x1DFF
+    },
+    {   /* U+1E00 - U+1EFF */
+        0x1E00, 0x1E00, 0x1E02, 0x1E02, 0x1E04, 0x1E04, 0x1E06, 0x1E06, 0x1E08, 0x1E08, 0x1E0A, 0x1E0A, 0x1E0C, 0x1E0C, 0x1E0E, 0x1E0E,
+        0x1E10, 0x1E10, 0x1E12, 0x1E12, 0x1E14, 0x1E14, 0x1E16, 0x1E16, 0x1E18, 0x1E18, 0x1E1A, 0x1E1A, 0x1E1C, 0x1E1C, 0x1E1E, 0x1E1E,
+        0x1E20, 0x1E20, 0x1E22, 0x1E22, 0x1E24, 0x1E24, 0x1E26, 0x1E26, 0x1E28, 0x1E28, 0x1E2A, 0x1E2A, 0x1E2C, 0x1E2C, 0x1E2E, 0x1E2E,
+        0x1E30, 0x1E30, 0x1E32, 0x1E32, 0x1E34, 0x1E34, 0x1E36, 0x1E36, 0x1E38, 0x1E38, 0x1E3A, 0x1E3A, 0x1E3C, 0x1E3C, 0x1E3E, 0x1E3E,
+        0x1E40, 0x1E40, 0x1E42, 0x1E42, 0x1E44, 0x1E44, 0x1E46, 0x1E46, 0x1E48, 0x1E48, 0x1E4A, 0x1E4A, 0x1E4C, 0x1E4C, 0x1E4E, 0x1E4E,
+        0x1E50, 0x1E50, 0x1E52, 0x1E52, 0x1E54, 0x1E54, 0x1E56, 0x1E56, 0x1E58, 0x1E58, 0x1E5A, 0x1E5A, 0x1E5C, 0x1E5C, 0x1E5E, 0x1E5E,
+        0x1E60, 0x1E60, 0x1E62, 0x1E62, 0x1E64, 0x1E64, 0x1E66, 0x1E66, 0x1E68, 0x1E68, 0x1E6A, 0x1E6A, 0x1E6C, 0x1E6C, 0x1E6E, 0x1E6E,
+        0x1E70, 0x1E70, 0x1E72, 0x1E72, 0x1E74, 0x1E74, 0x1E76, 0x1E76, 0x1E78, 0x1E78, 0x1E7A, 0x1E7A, 0x1E7C, 0x1E7C, 0x1E7E, 0x1E7E,
+        0x1E80, 0x1E80, 0x1E82, 0x1E82, 0x1E84, 0x1E84, 0x1E86, 0x1E86, 0x1E88, 0x1E88, 0x1E8A, 0x1E8A, 0x1E8C, 0x1E8C, 0x1E8E, 0x1E8E,
+        0x1E90, 0x1E90, 0x1E92, 0x1E92, 0x1E94, 0x1E94, 0x1E96, 0x1E97, 0x1E98, 0x1E99, 0x1E9A, 0x1E9B, 0x1E9C, 0x1E9D, 0x1E9E, 0x1E9F,
+        0x1EA0, 0x1EA0, 0x1EA2, 0x1EA2, 0x1EA4, 0x1EA4, 0x1EA6, 0x1EA6, 0x1EA8, 0x1EA8, 0x1EAA, 0x1EAA, 0x1EAC, 0x1EAC, 0x1EAE, 0x1EAE,
+        0x1EB0, 0x1EB0, 0x1EB2, 0x1EB2, 0x1EB4, 0x1EB4, 0x1EB6, 0x1EB6, 0x1EB8, 0x1EB8, 0x1EBA, 0x1EBA, 0x1EBC, 0x1EBC, 0x1EBE, 0x1EBE,
+        0x1EC0, 0x1EC0, 0x1EC2, 0x1EC2, 0x1EC4, 0x1EC4, 0x1EC6, 0x1EC6, 0x1EC8, 0x1EC8, 0x1ECA, 0x1ECA, 0x1ECC, 0x1ECC, 0x1ECE, 0x1ECE,
+        0x1ED0, 0x1ED0, 0x1ED2, 0x1ED2, 0x1ED4, 0x1ED4, 0x1ED6, 0x1ED6, 0x1ED8, 0x1ED8, 0x1EDA, 0x1EDA, 0x1EDC, 0x1EDC, 0x1EDE, 0x1EDE,
+        0x1EE0, 0x1EE0, 0x1EE2, 0x1EE2, 0x1EE4, 0x1EE4, 0x1EE6, 0x1EE6, 0x1EE8, 0x1EE8, 0x1EEA, 0x1EEA, 0x1EEC, 0x1EEC, 0x1EEE, 0x1EEE,
+        0x1EF0, 0x1EF0, 0x1EF2, 0x1EF2, 0x1EF4, 0x1EF4, 0x1EF6, 0x1EF6, 0x1EF8, 0x1EF8, 0x1EFA, 0x1EFB, 0x1EFC, 0x1EFD, 0x1EFE, 0x1EFF
+    },
+    {   /* U+1F00 - U+1FFF */
+        0x1F08, 0x1F09, 0x1F0A, 0x1F0B, 0x1F0C, 0x1F0D, 0x1F0E, 0x1F0F, 0x1F08, 0x1F09, 0x1F0A, 0x1F0B, 0x1F0C, 0x1F0D, 0x1F0E, 0x1F0F,
+        0x1F18, 0x1F19, 0x1F1A, 0x1F1B, 0x1F1C, 0x1F1D, 0x1F16, 0x1F17, 0x1F18, 0x1F19, 0x1F1A, 0x1F1B, 0x1F1C, 0x1F1D, 0x1F1E, 0x1F1F,
+        0x1F28, 0x1F29, 0x1F2A, 0x1F2B, 0x1F2C, 0x1F2D, 0x1F2E, 0x1F2F, 0x1F28, 0x1F29, 0x1F2A, 0x1F2B, 0x1F2C, 0x1F2D, 0x1F2E, 0x1F2F,
+        0x1F38, 0x1F39, 0x1F3A, 0x1F3B, 0x1F3C, 0x1F3D, 0x1F3E, 0x1F3F, 0x1F38, 0x1F39, 0x1F3A, 0x1F3B, 0x1F3C, 0x1F3D, 0x1F3E, 0x1F3F,
+        0x1F48, 0x1F49, 0x1F4A, 0x1F4B, 0x1F4C, 0x1F4D, 0x1F46, 0x1F47, 0x1F48, 0x1F49, 0x1F4A, 0x1F4B, 0x1F4C, 0x1F4D, 0x1F4E, 0x1F4F,
+        0x1F50, 0x1F59, 0x1F52, 0x1F5B, 0x1F54, 0x1F5D, 0x1F56, 0x1F5F, 0x1F58, 0x1F59, 0x1F5A, 0x1F5B, 0x1F5C, 0x1F5D, 0x1F5E, 0x1F5F,
+        0x1F68, 0x1F69, 0x1F6A, 0x1F6B, 0x1F6C, 0x1F6D, 0x1F6E, 0x1F6F, 0x1F68, 0x1F69, 0x1F6A, 0x1F6B, 0x1F6C, 0x1F6D, 0x1F6E, 0x1F6F,
+        0x1FBA, 0x1FBB, 0x1FC8, 0x1FC9, 0x1FCA, 0x1FCB, 0x1FDA, 0x1FDB, 0x1FF8, 0x1FF9, 0x1FEA, 0x1FEB, 0x1FFA, 0x1FFB, 0x1F7E, 0x1F7F,
+        0x1F88, 0x1F89, 0x1F8A, 0x1F8B, 0x1F8C, 0x1F8D, 0x1F8E, 0x1F8F, 0x1F88, 0x1F89, 0x1F8A, 0x1F8B, 0x1F8C, 0x1F8D, 0x1F8E, 0x1F8F,
+        0x1F98, 0x1F99, 0x1F9A, 0x1F9B, 0x1F9C, 0x1F9D, 0x1F9E, 0x1F9F, 0x1F98, 0x1F99, 0x1F9A, 0x1F9B, 0x1F9C, 0x1F9D, 0x1F9E, 0x1F9F,
+        0x1FA8, 0x1FA9, 0x1FAA, 0x1FAB, 0x1FAC, 0x1FAD, 0x1FAE, 0x1FAF, 0x1FA8, 0x1FA9, 0x1FAA, 0x1FAB, 0x1FAC, 0x1FAD, 0x1FAE, 0x1FAF,
+        0x1FB8, 0x1FB9, 0x1FB2, 0x1FBC, 0x1FB4, 0x1FB5, 0x1FB6, 0x1FB7, 0x1FB8, 0x1FB9, 0x1FBA, 0x1FBB, 0x1FBC, 0x1FBD, 0x1FBE, 0x1FBF,
+        0x1FC0, 0x1FC1, 0x1FC2, 0x1FC3, 0x1FC4, 0x1FC5, 0x1FC6, 0x1FC7, 0x1FC8, 0x1FC9, 0x1FCA, 0x1FCB, 0x1FC3, 0x1FCD, 0x1FCE, 0x1FCF,
+        0x1FD8, 0x1FD9, 0x1FD2, 0x1FD3, 0x1FD4, 0x1FD5, 0x1FD6, 0x1FD7, 0x1FD8, 0x1FD9, 0x1FDA, 0x1FDB, 0x1FDC, 0x1FDD, 0x1FDE, 0x1FDF,
+        0x1FE8, 0x1FE9, 0x1FE2, 0x1FE3, 0x1FE4, 0x1FEC, 0x1FE6, 0x1FE7, 0x1FE8, 0x1FE9, 0x1FEA, 0x1FEB, 0x1FEC, 0x1FED, 0x1FEE, 0x1FEF,
+        0x1FF0, 0x1FF1, 0x1FF2, 0x1FFC, 0x1FF4, 0x1FF5, 0x1FF6, 0x1FF7, 0x1FF8, 0x1FF9, 0x1FFA, 0x1FFB, 0x1FFC, 0x1FFD, 0x1FFE, 0x1FFF
+    },
+    {   /* U+2100 - U+21FF */
+        0x2100, 0x2101, 0x2102, 0x2103, 0x2104, 0x2105, 0x2106, 0x2107, 0x2108, 0x2109, 0x210A, 0x210B, 0x210C, 0x210D, 0x210E, 0x210F,
+        0x2110, 0x2111, 0x2112, 0x2113, 0x2114, 0x2115, 0x2116, 0x2117, 0x2118, 0x2119, 0x211A, 0x211B, 0x211C, 0x211D, 0x211E, 0x211F,
+        0x2120, 0x2121, 0x2122, 0x2123, 0x2124, 0x2125, 0x2126, 0x2127, 0x2128, 0x2129, 0x212A, 0x212B, 0x212C, 0x212D, 0x212E, 0x212F,
+        0x2130, 0x2131, 0x2132, 0x2133, 0x2134, 0x2135, 0x2136, 0x2137, 0x2138, 0x2139, 0x213A, 0x213B, 0x213C, 0x213D, 0x213E, 0x213F,
+        0x2140, 0x2141, 0x2142, 0x2143, 0x2144, 0x2145, 0x2146, 0x2147, 0x2148, 0x2149, 0x214A, 0x214B, 0x214C, 0x214D, 0x2132, 0x214F,
+        0x2150, 0x2151, 0x2152, 0x2153, 0x2154, 0x2155, 0x2156, 0x2157, 0x2158, 0x2159, 0x215A, 0x215B, 0x215C, 0x215D, 0x215E, 0x215F,
+        0x2160, 0x2161, 0x2162, 0x2163, 0x2164, 0x2165, 0x2166, 0x2167, 0x2168, 0x2169, 0x216A, 0x216B, 0x216C, 0x216D, 0x216E, 0x216F,
+        0x2160, 0x2161, 0x2162, 0x2163, 0x2164, 0x2165, 0x2166, 0x2167, 0x2168, 0x2169, 0x216A, 0x216B, 0x216C, 0x216D, 0x216E, 0x216F,
+        0x2180, 0x2181, 0x2182, 0x2183, 0x2183, 0x2185, 0x2186, 0x2187, 0x2188, 0x2189, 0x218A, 0x218B, 0x218C, 0x218D, 0x218E, 0x218F,
+        0x2190, 0x2191, 0x2192, 0x2193, 0x2194, 0x2195, 0x2196, 0x2197, 0x2198, 0x2199, 0x219A, 0x219B, 0x219C, 0x219D, 0x219E, 0x219F,
+        0x21A0, 0x21A1, 0x21A2, 0x21A3, 0x21A4, 0x21A5, 0x21A6, 0x21A7, 0x21A8, 0x21A9, 0x21AA, 0x21AB, 0x21AC, 0x21AD, 0x21AE, 0x21AF,
+        0x21B0, 0x21B1, 0x21B2, 0x21B3, 0x21B4, 0x21B5, 0x21B6, 0x21B7, 0x21B8, 0x21B9, 0x21BA, 0x21BB, 0x21BC, 0x21BD, 0x21BE, 0x21BF,
+        0x21C0, 0x21C1, 0x21C2, 0x21C3, 0x21C4, 0x21C5, 0x21C6, 0x21C7, 0x21C8, 0x21C9, 0x21CA, 0x21CB, 0x21CC, 0x21CD, 0x21CE, 0x21CF,
+        0x21D0, 0x21D1, 0x21D2, 0x21D3, 0x21D4, 0x21D5, 0x21D6, 0x21D7, 0x21D8, 0x21D9, 0x21DA, 0x21DB, 0x21DC, 0x21DD, 0x21DE, 0x21DF,
+        0x21E0, 0x21E1, 0x21E2, 0x21E3, 0x21E4, 0x21E5, 0x21E6, 0x21E7, 0x21E8, 0x21E9, 0x21EA, 0x21EB, 0x21EC, 0x21ED, 0x21EE, 0x21EF,
+        0x21F0, 0x21F1, 0x21F2, 0x21F3, 0x21F4, 0x21F5, 0x21F6, 0x21F7, 0x21F8, 0x21F9, 0x21FA, 0x21FB, 0x21FC, 0x21FD, 0x21FE, 0x21FF
+    },
+    {   /* U+2400 - U+24FF */
+        0x2400, 0x2401, 0x2402, 0x2403, 0x2404, 0x2405, 0x2406, 0x2407, 0x2408, 0x2409, 0x240A, 0x240B, 0x240C, 0x240D, 0x240E, 0x240F,
+        0x2410, 0x2411, 0x2412, 0x2413, 0x2414, 0x2415, 0x2416, 0x2417, 0x2418, 0x2419, 0x241A, 0x241B, 0x241C, 0x241D, 0x241E, 0x241F,
+        0x2420, 0x2421, 0x2422, 0x2423, 0x2424, 0x2425, 0x2426, 0x2427, 0x2428, 0x2429, 0x242A, 0x242B, 0x242C, 0x242D, 0x242E, 0x242F,
+        0x2430, 0x2431, 0x2432, 0x2433, 0x2434, 0x2435, 0x2436, 0x2437, 0x2438, 0x2439, 0x243A, 0x243B, 0x243C, 0x243D, 0x243E, 0x243F,
+        0x2440, 0x2441, 0x2442, 0x2443, 0x2444, 0x2445, 0x2446, 0x2447, 0x2448, 0x2449, 0x244A, 0x244B, 0x244C, 0x244D, 0x244E, 0x244F,
+        0x2450, 0x2451, 0x2452, 0x2453, 0x2454, 0x2455, 0x2456, 0x2457, 0x2458, 0x2459, 0x245A, 0x245B, 0x245C, 0x245D, 0x245E, 0x245F,
+        0x2460, 0x2461, 0x2462, 0x2463, 0x2464, 0x2465, 0x2466, 0x2467, 0x2468, 0x2469, 0x246A, 0x246B, 0x246C, 0x246D, 0x246E, 0x246F,
+        0x2470, 0x2471, 0x2472, 0x2473, 0x2474, 0x2475, 0x2476, 0x2477, 0x2478, 0x2479, 0x247A, 0x247B, 0x247C, 0x247D, 0x247E, 0x247F,
+        0x2480, 0x2481, 0x2482, 0x2483, 0x2484, 0x2485, 0x2486, 0x2487, 0x2488, 0x2489, 0x248A, 0x248B, 0x248C, 0x248D, 0x248E, 0x248F,
+        0x2490, 0x2491, 0x2492, 0x2493, 0x2494, 0x2495, 0x2496, 0x2497, 0x2498, 0x2499, 0x249A, 0x249B, 0x249C, 0x249D, 0x249E, 0x249F,
+        0x24A0, 0x24A1, 0x24A2, 0x24A3, 0x24A4, 0x24A5, 0x24A6, 0x24A7, 0x24A8, 0x24A9, 0x24AA, 0x24AB, 0x24AC, 0x24AD, 0x24AE, 0x24AF,
+        0x24B0, 0x24B1, 0x24B2, 0x24B3, 0x24B4, 0x24B5, 0x24B6, 0x24B7, 0x24B8, 0x24B9, 0x24BA, 0x24BB, 0x24BC, 0x24BD, 0x24BE, 0x24BF,
+        0x24C0, 0x24C1, 0x24C2, 0x24C3, 0x24C4, 0x24C5, 0x24C6, 0x24C7, 0x24C8, 0x24C9, 0x24CA, 0x24CB, 0x24CC, 0x24CD, 0x24CE, 0x24CF,
+        0x24B6, 0x24B7, 0x24B8, 0x24B9, 0x24BA, 0x24BB, 0x24BC, 0x24BD, 0x24BE, 0x24BF, 0x24C0, 0x24C1, 0x24C2, 0x24C3, 0x24C4, 0x24C5,
+        0x24C6, 0x24C7, 0x24C8, 0x24C9, 0x24CA, 0x24CB, 0x24CC, 0x24CD, 0x24CE, 0x24CF, 0x24EA, 0x24EB, 0x24EC, 0x24ED, 0x24EE, 0x24EF,
+        0x24F0, 0x24F1, 0x24F2, 0x24F3, 0x24F4, 0x24F5, 0x24F6, 0x24F7, 0x24F8, 0x24F9, 0x24FA, 0x24FB, 0x24FC, 0x24FD, 0x24FE, 0x24FF
+    },
+    {   /* U+2C00 - U+2CFF */
+        0x2C00, 0x2C01, 0x2C02, 0x2C03, 0x2C04, 0x2C05, 0x2C06, 0x2C07, 0x2C08, 0x2C09, 0x2C0A, 0x2C0B, 0x2C0C, 0x2C0D, 0x2C0E, 0x2C0F,
+        0x2C10, 0x2C11, 0x2C12, 0x2C13, 0x2C14, 0x2C15, 0x2C16, 0x2C17, 0x2C18, 0x2C19, 0x2C1A, 0x2C1B, 0x2C1C, 0x2C1D, 0x2C1E, 0x2C1F,
+        0x2C20, 0x2C21, 0x2C22, 0x2C23, 0x2C24, 0x2C25, 0x2C26, 0x2C27, 0x2C28, 0x2C29, 0x2C2A, 0x2C2B, 0x2C2C, 0x2C2D, 0x2C2E, 0x2C2F,
+        0x2C00, 0x2C01, 0x2C02, 0x2C03, 0x2C04, 0x2C05, 0x2C06, 0x2C07, 0x2C08, 0x2C09, 0x2C0A, 0x2C0B, 0x2C0C, 0x2C0D, 0x2C0E, 0x2C0F,
+        0x2C10, 0x2C11, 0x2C12, 0x2C13, 0x2C14, 0x2C15, 0x2C16, 0x2C17, 0x2C18, 0x2C19, 0x2C1A, 0x2C1B, 0x2C1C, 0x2C1D, 0x2C1E, 0x2C1F,
+        0x2C20, 0x2C21, 0x2C22, 0x2C23, 0x2C24, 0x2C25, 0x2C26, 0x2C27, 0x2C28, 0x2C29, 0x2C2A, 0x2C2B, 0x2C2C, 0x2C2D, 0x2C2E, 0x2C5F,
+        0x2C60, 0x2C60, 0x2C62, 0x2C63, 0x2C64, 0x2C65, 0x2C66, 0x2C67, 0x2C67, 0x2C69, 0x2C69, 0x2C6B, 0x2C6B, 0x2C6D, 0x2C6E, 0x2C6F,
+        0x2C70, 0x2C71, 0x2C72, 0x2C73, 0x2C74, 0x2C75, 0x2C75, 0x2C77, 0x2C78, 0x2C79, 0x2C7A, 0x2C7B, 0x2C7C, 0x2C7D, 0x2C7E, 0x2C7F,
+        0x2C80, 0x2C80, 0x2C82, 0x2C82, 0x2C84, 0x2C84, 0x2C86, 0x2C86, 0x2C88, 0x2C88, 0x2C8A, 0x2C8A, 0x2C8C, 0x2C8C, 0x2C8E, 0x2C8E,
+        0x2C90, 0x2C90, 0x2C92, 0x2C92, 0x2C94, 0x2C94, 0x2C96, 0x2C96, 0x2C98, 0x2C98, 0x2C9A, 0x2C9A, 0x2C9C, 0x2C9C, 0x2C9E, 0x2C9E,
+        0x2CA0, 0x2CA0, 0x2CA2, 0x2CA2, 0x2CA4, 0x2CA4, 0x2CA6, 0x2CA6, 0x2CA8, 0x2CA8, 0x2CAA, 0x2CAA, 0x2CAC, 0x2CAC, 0x2CAE, 0x2CAE,
+        0x2CB0, 0x2CB0, 0x2CB2, 0x2CB2, 0x2CB4, 0x2CB4, 0x2CB6, 0x2CB6, 0x2CB8, 0x2CB8, 0x2CBA, 0x2CBA, 0x2CBC, 0x2CBC, 0x2CBE, 0x2CBE,
+        0x2CC0, 0x2CC0, 0x2CC2, 0x2CC2, 0x2CC4, 0x2CC4, 0x2CC6, 0x2CC6, 0x2CC8, 0x2CC8, 0x2CCA, 0x2CCA, 0x2CCC, 0x2CCC, 0x2CCE, 0x2CCE,
+        0x2CD0, 0x2CD0, 0x2CD2, 0x2CD2, 0x2CD4, 0x2CD4, 0x2CD6, 0x2CD6, 0x2CD8, 0x2CD8, 0x2CDA, 0x2CDA, 0x2CDC, 0x2CDC, 0x2CDE, 0x2CDE,
+        0x2CE0, 0x2CE0, 0x2CE2, 0x2CE2, 0x2CE4, 0x2CE5, 0x2CE6, 0x2CE7, 0x2CE8, 0x2CE9, 0x2CEA, 0x2CEB, 0x2CEC, 0x2CED, 0x2CEE, 0x2CEF,
+        0x2CF0, 0x2CF1, 0x2CF2, 0x2CF3, 0x2CF4, 0x2CF5, 0x2CF6, 0x2CF7, 0x2CF8, 0x2CF9, 0x2CFA, 0x2CFB, 0x2CFC, 0x2CFD, 0x2CFE, 0x2CFF
+    },
+    {   /* U+2D00 - U+2DFF */
+        0x10A0, 0x10A1, 0x10A2, 0x10A3, 0x10A4, 0x10A5, 0x10A6, 0x10A7, 0x10A8, 0x10A9, 0x10AA, 0x10AB, 0x10AC, 0x10AD, 0x10AE, 0x10AF,
+        0x10B0, 0x10B1, 0x10B2, 0x10B3, 0x10B4, 0x10B5, 0x10B6, 0x10B7, 0x10B8, 0x10B9, 0x10BA, 0x10BB, 0x10BC, 0x10BD, 0x10BE, 0x10BF,
+        0x10C0, 0x10C1, 0x10C2, 0x10C3, 0x10C4, 0x10C5, 0x2D26, 0x2D27, 0x2D28, 0x2D29, 0x2D2A, 0x2D2B, 0x2D2C, 0x2D2D, 0x2D2E, 0x2D2F,
+        0x2D30, 0x2D31, 0x2D32, 0x2D33, 0x2D34, 0x2D35, 0x2D36, 0x2D37, 0x2D38, 0x2D39, 0x2D3A, 0x2D3B, 0x2D3C, 0x2D3D, 0x2D3E, 0x2D3F,
+        0x2D40, 0x2D41, 0x2D42, 0x2D43, 0x2D44, 0x2D45, 0x2D46, 0x2D47, 0x2D48, 0x2D49, 0x2D4A, 0x2D4B, 0x2D4C, 0x2D4D, 0x2D4E, 0x2D4F,
+        0x2D50, 0x2D51, 0x2D52, 0x2D53, 0x2D54, 0x2D55, 0x2D56, 0x2D57, 0x2D58, 0x2D59, 0x2D5A, 0x2D5B, 0x2D5C, 0x2D5D, 0x2D5E, 0x2D5F,
+        0x2D60, 0x2D61, 0x2D62, 0x2D63, 0x2D64, 0x2D65, 0x2D66, 0x2D67, 0x2D68, 0x2D69, 0x2D6A, 0x2D6B, 0x2D6C, 0x2D6D, 0x2D6E, 0x2D6F,
+        0x2D70, 0x2D71, 0x2D72, 0x2D73, 0x2D74, 0x2D75, 0x2D76, 0x2D77, 0x2D78, 0x2D79, 0x2D7A, 0x2D7B, 0x2D7C, 0x2D7D, 0x2D7E, 0x2D7F,
+        0x2D80, 0x2D81, 0x2D82, 0x2D83, 0x2D84, 0x2D85, 0x2D86, 0x2D87, 0x2D88, 0x2D89, 0x2D8A, 0x2D8B, 0x2D8C, 0x2D8D, 0x2D8E, 0x2D8F,
+        0x2D90, 0x2D91, 0x2D92, 0x2D93, 0x2D94, 0x2D95, 0x2D96, 0x2D97, 0x2D98, 0x2D99, 0x2D9A, 0x2D9B, 0x2D9C, 0x2D9D, 0x2D9E, 0x2D9F,
+        0x2DA0, 0x2DA1, 0x2DA2, 0x2DA3, 0x2DA4, 0x2DA5, 0x2DA6, 0x2DA7, 0x2DA8, 0x2DA9, 0x2DAA, 0x2DAB, 0x2DAC, 0x2DAD, 0x2DAE, 0x2DAF,
+        0x2DB0, 0x2DB1, 0x2DB2, 0x2DB3, 0x2DB4, 0x2DB5, 0x2DB6, 0x2DB7, 0x2DB8, 0x2DB9, 0x2DBA, 0x2DBB, 0x2DBC, 0x2DBD, 0x2DBE, 0x2DBF,
+        0x2DC0, 0x2DC1, 0x2DC2, 0x2DC3, 0x2DC4, 0x2DC5, 0x2DC6, 0x2DC7, 0x2DC8, 0x2DC9, 0x2DCA, 0x2DCB, 0x2DCC, 0x2DCD, 0x2DCE, 0x2DCF,
+        0x2DD0, 0x2DD1, 0x2DD2, 0x2DD3, 0x2DD4, 0x2DD5, 0x2DD6, 0x2DD7, 0x2DD8, 0x2DD9, 0x2DDA, 0x2DDB, 0x2DDC, 0x2DDD, 0x2DDE, 0x2DDF,
+        0x2DE0, 0x2DE1, 0x2DE2, 0x2DE3, 0x2DE4, 0x2DE5, 0x2DE6, 0x2DE7, 0x2DE8, 0x2DE9, 0x2DEA, 0x2DEB, 0x2DEC, 0x2DED, 0x2DEE, 0x2DEF,
+        0x2DF0, 0x2DF1, 0x2DF2, 0x2DF3, 0x2DF4, 0x2DF5, 0x2DF6, 0x2DF7, 0x2DF8, 0x2DF9, 0x2DFA, 0x2DFB, 0x2DFC, 0x2DFD, 0x2DFE, 0x2DFF
+    },
+    {   /* U+FF00 - U+FFFF */
+        0xFF00, 0xFF01, 0xFF02, 0xFF03, 0xFF04, 0xFF05, 0xFF06, 0xFF07, 0xFF08, 0xFF09, 0xFF0A, 0xFF0B, 0xFF0C, 0xFF0D, 0xFF0E, 0xFF0F,
+        0xFF10, 0xFF11, 0xFF12, 0xFF13, 0xFF14, 0xFF15, 0xFF16, 0xFF17, 0xFF18, 0xFF19, 0xFF1A, 0xFF1B, 0xFF1C, 0xFF1D, 0xFF1E, 0xFF1F,
+        0xFF20, 0xFF21, 0xFF22, 0xFF23, 0xFF24, 0xFF25, 0xFF26, 0xFF27, 0xFF28, 0xFF29, 0xFF2A, 0xFF2B, 0xFF2C, 0xFF2D, 0xFF2E, 0xFF2F,
+        0xFF30, 0xFF31, 0xFF32, 0xFF33, 0xFF34, 0xFF35, 0xFF36, 0xFF37, 0xFF38, 0xFF39, 0xFF3A, 0xFF3B, 0xFF3C, 0xFF3D, 0xFF3E, 0xFF3F,
+        0xFF40, 0xFF21, 0xFF22, 0xFF23, 0xFF24, 0xFF25, 0xFF26, 0xFF27, 0xFF28, 0xFF29, 0xFF2A, 0xFF2B, 0xFF2C, 0xFF2D, 0xFF2E, 0xFF2F,
+        0xFF30, 0xFF31, 0xFF32, 0xFF33, 0xFF34, 0xFF35, 0xFF36, 0xFF37, 0xFF38, 0xFF39, 0xFF3A, 0xFF5B, 0xFF5C, 0xFF5D, 0xFF5E, 0xFF5F,
+        0xFF60, 0xFF61, 0xFF62, 0xFF63, 0xFF64, 0xFF65, 0xFF66, 0xFF67, 0xFF68, 0xFF69, 0xFF6A, 0xFF6B, 0xFF6C, 0xFF6D, 0xFF6E, 0xFF6F,
+        0xFF70, 0xFF71, 0xFF72, 0xFF73, 0xFF74, 0xFF75, 0xFF76, 0xFF77, 0xFF78, 0xFF79, 0xFF7A, 0xFF7B, 0xFF7C, 0xFF7D, 0xFF7E, 0xFF7F,
+        0xFF80, 0xFF81, 0xFF82, 0xFF83, 0xFF84, 0xFF85, 0xFF86, 0xFF87, 0xFF88, 0xFF89, 0xFF8A, 0xFF8B, 0xFF8C, 0xFF8D, 0xFF8E, 0xFF8F,
+        0xFF90, 0xFF91, 0xFF92, 0xFF93, 0xFF94, 0xFF95, 0xFF96, 0xFF97, 0xFF98, 0xFF99, 0xFF9A, 0xFF9B, 0xFF9C, 0xFF9D, 0xFF9E, 0xFF9F,
+        0xFFA0, 0xFFA1, 0xFFA2, 0xFFA3, 0xFFA4, 0xFFA5, 0xFFA6, 0xFFA7, 0xFFA8, 0xFFA9, 0xFFAA, 0xFFAB, 0xFFAC, 0xFFAD, 0xFFAE, 0xFFAF,
+        0xFFB0, 0xFFB1, 0xFFB2, 0xFFB3, 0xFFB4, 0xFFB5, 0xFFB6, 0xFFB7, 0xFFB8, 0xFFB9, 0xFFBA, 0xFFBB, 0xFFBC, 0xFFBD, 0xFFBE, 0xFFBF,
+        0xFFC0, 0xFFC1, 0xFFC2, 0xFFC3, 0xFFC4, 0xFFC5, 0xFFC6, 0xFFC7, 0xFFC8, 0xFFC9, 0xFFCA, 0xFFCB, 0xFFCC, 0xFFCD, 0xFFCE, 0xFFCF,
+        0xFFD0, 0xFFD1, 0xFFD2, 0xFFD3, 0xFFD4, 0xFFD5, 0xFFD6, 0xFFD7, 0xFFD8, 0xFFD9, 0xFFDA, 0xFFDB, 0xFFDC, 0xFFDD, 0xFFDE, 0xFFDF,
+        0xFFE0, 0xFFE1, 0xFFE2, 0xFFE3, 0xFFE4, 0xFFE5, 0xFFE6, 0xFFE7, 0xFFE8, 0xFFE9, 0xFFEA, 0xFFEB, 0xFFEC, 0xFFED, 0xFFEE, 0xFFEF,
+        0xFFF0, 0xFFF1, 0xFFF2, 0xFFF3, 0xFFF4, 0xFFF5, 0xFFF6, 0xFFF7, 0xFFF8, 0xFFF9, 0xFFFA, 0xFFFB, 0xFFFC, 0xFFFD, 0xFFFE, 0xFFFF
+    }
+};
+
+
+DWORD ff_wtoupper ( /* Returns up-converted code point */
+    DWORD uni       /* Unicode code point to be up-converted */
+)
+{
+    UINT pg;
+
+
+    if (uni < 0x80) {   /* ASCII needs no table */
+        if (uni >= 'a' && uni <= 'z') uni -= 0x20;
+        return uni;
+    }
+    if (uni < 0x10000) {    /* Is it in BMP? */
+        pg = uptbl_idx[uni >> 8];   /* Get the page */
+        if (pg) uni = uptbl_pg[pg - 1][uni & 0xFF];
+    }
+    return uni;
+}
+
+#else
 DWORD ff_wtoupper ( /* Returns up-converted code point */
     DWORD uni       /* Unicode code point to be up-converted */
 )
@@ -15564,6 +16496,10 @@ DWORD ff_wtoupper ( /* Returns up-converted code point */
     };
 
 
+    if (uni < 0x80) {   /* ASCII needs no table walk */
+        if (uni >= 'a' && uni <= 'z') uni -= 0x20;
+        return uni;
+    }
     if (uni < 0x10000) {    /* Is it in BMP? */
         uc = (WORD)uni;
         p = uc < 0x1000 ? cvt1 : cvt2;
@@ -15592,6 +16528,7 @@ DWORD ff_wtoupper ( /* Returns up-converted code point */
 
     return uni;
 }
+#endif
 
 
 #endif /* #if FF_USE_LFN */